@@ -120,6 +120,10 @@ protected:
     Node    *_target;
     /** The action tag. An identifier of the action */
     int     _tag;
+    /** Index of the record advancing the action in the TweenSystem of its ActionManager, -1 when it is stepped */
+    ssize_t _tweenSlot;
+
+    friend class TweenSystem;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(Action);
@@ -74,6 +74,8 @@ CC_CONSTRUCTOR_ACCESS:
 protected:
     /** The inner action */
     ActionInterval *_inner;
+
+    friend class TweenSystem;
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(ActionEase);
 };
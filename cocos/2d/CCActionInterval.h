@@ -96,6 +96,8 @@ CC_CONSTRUCTOR_ACCESS:
 protected:
     float _elapsed;
     bool   _firstTick;
+
+    friend class TweenSystem;
 };
 
 /** @brief Runs actions sequentially, one after another
@@ -372,6 +374,8 @@ protected:
     Vec3 _startAngle;
     Vec3 _diffAngle;
 
+    friend class TweenSystem;
+
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(RotateTo);
 };
@@ -446,6 +450,8 @@ protected:
     Vec2 _startPosition;
     Vec2 _previousPosition;
 
+    friend class TweenSystem;
+
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(MoveBy);
 };
@@ -734,6 +740,8 @@ protected:
     float _deltaY;
     float _deltaZ;
 
+    friend class TweenSystem;
+
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(ScaleTo);
 };
@@ -830,6 +838,7 @@ protected:
     GLubyte _fromOpacity;
     friend class FadeOut;
     friend class FadeIn;
+    friend class TweenSystem;
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(FadeTo);
 };
@@ -28,6 +28,8 @@ THE SOFTWARE.
 
 #include "2d/CCActionManager.h"
 #include "2d/CCNode.h"
+#include "2d/CCActionInterval.h"
+#include "2d/CCTweenSystem.h"
 #include "base/CCScheduler.h"
 #include "base/ccMacros.h"
 #include "base/ccCArray.h"
@@ -42,6 +44,7 @@ typedef struct _hashElement
     struct _ccArray     *actions;
     Node                *target;
     int                 actionIndex;
+    int                 tweenCount;
     Action              *currentAction;
     bool                currentActionSalvaged;
     bool                paused;
@@ -51,7 +54,9 @@ typedef struct _hashElement
 ActionManager::ActionManager()
 : _targets(nullptr),
   _currentTarget(nullptr),
-  _currentTargetSalvaged(false)
+  _currentTargetSalvaged(false),
+  _tweenSystem(new TweenSystem()),
+  _tweenBatchingEnabled(true)
 {
 
 }
@@ -61,6 +66,7 @@ ActionManager::~ActionManager()
     CCLOGINFO("deallocing ActionManager: %p", this);
 
     removeAllActions();
+    CC_SAFE_DELETE(_tweenSystem);
 }
 
 // private
@@ -87,10 +93,29 @@ void ActionManager::actionAllocWithHashElement(tHashElement *element)
 
 }
 
+void ActionManager::removeBatchedActions(tHashElement *element)
+{
+    for (int i = 0; element->tweenCount > 0 && i < element->actions->num; ++i)
+    {
+        Action *action = (Action*)element->actions->arr[i];
+        if (TweenSystem::isBatched(action))
+        {
+            _tweenSystem->remove(action);
+            element->tweenCount--;
+        }
+    }
+}
+
 void ActionManager::removeActionAtIndex(ssize_t index, tHashElement *element)
 {
     Action *action = (Action*)element->actions->arr[index];
 
+    if (TweenSystem::isBatched(action))
+    {
+        _tweenSystem->remove(action);
+        element->tweenCount--;
+    }
+
     if (action == element->currentAction && (! element->currentActionSalvaged))
     {
         element->currentAction->retain();
@@ -189,6 +214,12 @@ void ActionManager::addAction(Action *action, Node *target, bool paused)
      ccArrayAppendObject(element->actions, action);
  
      action->startWithTarget(target);
+
+    if (_tweenBatchingEnabled && TweenSystem::canBatch(action))
+    {
+        _tweenSystem->add(static_cast<ActionInterval*>(action), &element->paused);
+        element->tweenCount++;
+    }
 }
 
 // remove
@@ -221,6 +252,7 @@ void ActionManager::removeAllActionsFromTarget(Node *target)
             element->currentActionSalvaged = true;
         }
 
+        removeBatchedActions(element);
         ccArrayRemoveAllObjects(element->actions);
         if (_currentTarget == element)
         {
@@ -336,22 +368,58 @@ ssize_t ActionManager::getNumberOfRunningActionsInTarget(const Node *target) con
     return 0;
 }
 
+bool ActionManager::hasRunningActions() const
+{
+    for (tHashElement *element = _targets; element != nullptr; element = (tHashElement*)(element->hh.next))
+    {
+        if (!element->paused && ((element->actions && element->actions->num > 0) || element->tweenCount > 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // main loop
+ssize_t ActionManager::getNumberOfBatchedActions() const
+{
+    return _tweenSystem->getTweenCount();
+}
+
 void ActionManager::update(float dt)
 {
+    if (_tweenSystem->getTweenCount() > 0)
+    {
+        _tweenSystem->update(dt, _finishedTweens);
+
+        for (auto action : _finishedTweens)
+        {
+            // skip the actions removed by a callback after the end of their tween
+            if (TweenSystem::isBatched(action))
+            {
+                action->stop();
+                removeAction(action);
+            }
+            action->release();
+        }
+        _finishedTweens.clear();
+    }
+
     for (tHashElement *elt = _targets; elt != nullptr; )
     {
         _currentTarget = elt;
         _currentTargetSalvaged = false;
 
-        if (! _currentTarget->paused)
+        // the batched actions were advanced by the TweenSystem
+        if (! _currentTarget->paused && _currentTarget->tweenCount < _currentTarget->actions->num)
         {
             // The 'actions' MutableArray may change while inside this loop.
             for (_currentTarget->actionIndex = 0; _currentTarget->actionIndex < _currentTarget->actions->num;
                 _currentTarget->actionIndex++)
             {
                 _currentTarget->currentAction = (Action*)_currentTarget->actions->arr[_currentTarget->actionIndex];
-                if (_currentTarget->currentAction == nullptr)
+                if (_currentTarget->currentAction == nullptr || TweenSystem::isBatched(_currentTarget->currentAction))
                 {
                     continue;
                 }
@@ -36,6 +36,7 @@ THE SOFTWARE.
 NS_CC_BEGIN
 
 struct _hashElement;
+class TweenSystem;
 
 /**
  * @addtogroup actions
@@ -106,6 +107,9 @@ public:
     /** @deprecated use getNumberOfRunningActionsInTarget() instead */
     CC_DEPRECATED_ATTRIBUTE inline ssize_t numberOfRunningActionsInTarget(Node *target) const { return getNumberOfRunningActionsInTarget(target); }
 
+    /** Returns whether any target that is not paused has a running action */
+    bool hasRunningActions() const;
+
     /** Pauses the target: all running actions and newly added actions will be paused.
     */
     void pauseTarget(Node *target);
@@ -122,6 +126,16 @@ public:
      */
     void resumeTargets(const Vector<Node*>& targetsToResume);
 
+    /** Advances MoveTo, ScaleTo, FadeTo, RotateTo and their variants, eased or not, from a TweenSystem instead of
+     stepping them one by one. Only the actions added afterwards are affected. Enabled by default.
+     @see TweenSystem
+     */
+    void setTweenBatchingEnabled(bool enabled) { _tweenBatchingEnabled = enabled; }
+    bool isTweenBatchingEnabled() const { return _tweenBatchingEnabled; }
+
+    /** Returns the number of running actions advanced by the TweenSystem */
+    ssize_t getNumberOfBatchedActions() const;
+
     void update(float dt);
     
 protected:
@@ -130,11 +144,16 @@ protected:
     void removeActionAtIndex(ssize_t index, struct _hashElement *element);
     void deleteHashElement(struct _hashElement *element);
     void actionAllocWithHashElement(struct _hashElement *element);
+    void removeBatchedActions(struct _hashElement *element);
 
 protected:
     struct _hashElement    *_targets;
     struct _hashElement    *_currentTarget;
     bool            _currentTargetSalvaged;
+
+    TweenSystem     *_tweenSystem;
+    bool            _tweenBatchingEnabled;
+    std::vector<Action*> _finishedTweens;
 };
 
 // end of actions group
@@ -96,6 +96,7 @@ public:
      */
     virtual void onExit() override;
     virtual void visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags) override;
+    virtual bool isVisitThreadSafe() const override { return false; }
     
 CC_CONSTRUCTOR_ACCESS:
     ClippingNode();
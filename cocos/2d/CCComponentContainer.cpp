@@ -30,25 +30,17 @@ THE SOFTWARE.
 NS_CC_BEGIN
 
 ComponentContainer::ComponentContainer(Node *node)
-: _components(nullptr)
-, _owner(node)
+: _owner(node)
 {
 }
 
 ComponentContainer::~ComponentContainer(void)
 {
-    CC_SAFE_DELETE(_components);
 }
 
 Component* ComponentContainer::get(const std::string& name) const
 {
-    Component* ret = nullptr;
-    do {
-        CC_BREAK_IF(nullptr == _components);
-        ret = _components->at(name);
-        
-    } while (0);
-    return ret;
+    return _components.at(name);
 }
 
 bool ComponentContainer::add(Component *com)
@@ -58,16 +50,12 @@ bool ComponentContainer::add(Component *com)
     CCASSERT(com->getOwner() == nullptr, "Component already added. It can't be added again");
     do
     {
-        if (_components == nullptr)
-        {
-            _components = new Map<std::string, Component*>();
-        }
-        Component *component = _components->at(com->getName());
+        Component *component = _components.at(com->getName());
         
         CCASSERT(component == nullptr, "Component already added. It can't be added again");
         CC_BREAK_IF(component);
         com->setOwner(_owner);
-        _components->insert(com->getName(), com);
+        _components.insert(com->getName(), com);
         com->onEnter();
         ret = true;
     } while(0);
@@ -79,16 +67,14 @@ bool ComponentContainer::remove(const std::string& name)
     bool ret = false;
     do 
     {        
-        CC_BREAK_IF(!_components);
-        
-        auto iter = _components->find(name);
-        CC_BREAK_IF(iter == _components->end());
+        auto iter = _components.find(name);
+        CC_BREAK_IF(iter == _components.end());
         
         auto com = iter->second;
         com->onExit();
         com->setOwner(nullptr);
         
-        _components->erase(iter);
+        _components.erase(iter);
         ret = true;
     } while(0);
     return ret;
@@ -99,15 +85,13 @@ bool ComponentContainer::remove(Component *com)
     bool ret = false;
     do
     {
-        CC_BREAK_IF(!_components);
-        
-        for (auto iter = _components->begin(); iter != _components->end(); ++iter)
+        for (auto iter = _components.begin(); iter != _components.end(); ++iter)
         {
             if (iter->second == com)
             {
                 com->onExit();
                 com->setOwner(nullptr);
-                _components->erase(iter);
+                _components.erase(iter);
                 break;
             }
         }
@@ -118,32 +102,26 @@ bool ComponentContainer::remove(Component *com)
 
 void ComponentContainer::removeAll()
 {
-    if (_components != nullptr)
+    if (!_components.empty())
     {
-        for (auto iter = _components->begin(); iter != _components->end(); ++iter)
+        for (auto iter = _components.begin(); iter != _components.end(); ++iter)
         {
             iter->second->onExit();
             iter->second->setOwner(nullptr);
         }
         
-        _components->clear();
-        CC_SAFE_DELETE(_components);
+        _components.clear();
         
         _owner->unscheduleUpdate();
     }
 }
 
-void ComponentContainer::alloc(void)
-{
-    _components = new Map<std::string, Component*>();
-}
-
 void ComponentContainer::visit(float delta)
 {
-    if (_components != nullptr)
+    if (!_components.empty())
     {
         CC_SAFE_RETAIN(_owner);
-        for (auto iter = _components->begin(); iter != _components->end(); ++iter)
+        for (auto iter = _components.begin(); iter != _components.end(); ++iter)
         {
             iter->second->update(delta);
         }
@@ -153,7 +131,7 @@ void ComponentContainer::visit(float delta)
 
 bool ComponentContainer::isEmpty() const
 {
-    return (_components == nullptr || _components->empty());
+    return _components.empty();
 }
 
 NS_CC_END
@@ -25,7 +25,7 @@ THE SOFTWARE.
 #ifndef __CC_FRAMEWORK_COMCONTAINER_H__
 #define __CC_FRAMEWORK_COMCONTAINER_H__
 
-#include "base/CCMap.h"
+#include "base/CCFlatMap.h"
 #include <string>
 
 NS_CC_BEGIN
@@ -57,10 +57,8 @@ public:
     bool isEmpty() const;
     
 private:
-    void alloc(void);
-    
-private:
-    Map<std::string, Component*>* _components;
+    // components are few and looked up by name, a sorted vector avoids the hash table allocations
+    FlatMap<std::string, Component*> _components;
     Node *_owner;
     
     friend class Node;
@@ -1067,19 +1067,19 @@ void Label::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t pare
         updateContent();
     }
 
+    if (isCulledBySpatialIndex(parentTransform, parentFlags))
+    {
+        return;
+    }
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
     if (_shadowEnabled && _shadowBlurRadius <= 0 && (_shadowDirty || (flags & FLAGS_DIRTY_MASK)))
     {
-        _position.x += _shadowOffset.width;
-        _position.y += _shadowOffset.height;
-        _transformDirty = _inverseDirty = true;
-
-        _shadowTransform = transform(parentTransform);
-
-        _position.x -= _shadowOffset.width;
-        _position.y -= _shadowOffset.height;
-        _transformDirty = _inverseDirty = true;
+        // the position is the last translation of the transform, offsetting it offsets the node in its parent
+        Mat4 shadowOffset;
+        Mat4::createTranslation(_shadowOffset.width, _shadowOffset.height, 0, &shadowOffset);
+        _shadowTransform = parentTransform * shadowOffset * getNodeToParentTransform();
 
         _shadowDirty = false;
     }
@@ -1090,8 +1090,12 @@ void Label::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t pare
     Director* director = Director::getInstance();
     CCASSERT(nullptr != director, "Director is null when seting matrix stack");
     
-    director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    bool useMatrixStack = isUsingMatrixStack();
+    if (useMatrixStack)
+    {
+        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
     
 
     if (_textSprite)
@@ -1103,7 +1107,10 @@ void Label::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t pare
         draw(renderer, _modelViewTransform, flags);
     }
 
-    director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (useMatrixStack)
+    {
+        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    }
     
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -30,7 +30,6 @@ THE SOFTWARE.
 
 #include <algorithm>
 #include <string>
-#include <regex>
 
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
@@ -46,8 +45,13 @@ THE SOFTWARE.
 #include "2d/CCScene.h"
 #include "2d/CCComponent.h"
 #include "2d/CCComponentContainer.h"
+#include "2d/CCNodePath.h"
+#include "2d/CCParallelVisitor.h"
+#include "2d/CCSpatialIndex.h"
+#include "2d/CCTransformSystem.h"
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCGLProgramState.h"
+#include "renderer/CCRenderer.h"
 #include "math/TransformUtils.h"
 
 #include "deprecated/CCString.h"
@@ -72,6 +76,68 @@ bool nodeComparisonLess(Node* n1, Node* n2)
            );
 }
 
+void sortNodes(Node** first, Node** last)
+{
+    if (last - first < 2)
+        return;
+
+    // insertion sort, as long as the array looks nearly sorted. Once the nodes moved too far,
+    // the rest is left to std::sort
+    ssize_t movesLeft = (last - first) * 4;
+
+    for (auto it = first + 1; it != last; ++it)
+    {
+        Node* node = *it;
+        auto hole = it;
+        while (hole != first && nodeComparisonLess(node, *(hole - 1)))
+        {
+            *hole = *(hole - 1);
+            --hole;
+
+            if (--movesLeft < 0)
+            {
+                *hole = node;
+                std::sort(first, last, nodeComparisonLess);
+                return;
+            }
+        }
+        *hole = node;
+    }
+}
+
+void sortNodes(Vector<Node*>& nodes)
+{
+    if (nodes.size() < 2)
+        return;
+
+    Node** first = &*std::begin(nodes);
+    sortNodes(first, first + nodes.size());
+}
+
+/// Simulated states of a node drawn with Director::getInterpolationAlpha()
+struct TransformInterpolation
+{
+    struct State
+    {
+        Vec2 position;
+        float rotationX;
+        float rotationY;
+        float scaleX;
+        float scaleY;
+
+        bool operator==(const State& other) const
+        {
+            return position.equals(other.position) && rotationX == other.rotationX && rotationY == other.rotationY
+                && scaleX == other.scaleX && scaleY == other.scaleY;
+        }
+    };
+
+    State previous;
+    /// current state while the interpolated one is applied
+    State simulated;
+    bool applied;
+};
+
 // XXX: Yes, nodes might have a sort problem once every 15 days if the game runs at 60 FPS and each frame sprites are reordered.
 int Node::s_globalOrderOfArrival = 1;
 
@@ -94,6 +160,12 @@ Node::Node(void)
 , _transformDirty(true)
 , _inverseDirty(true)
 , _transformUpdated(true)
+, _transformSystem(nullptr)
+, _transformSlot(-1)
+, _spatialIndex(nullptr)
+, _spatialSlot(-1)
+, _interpolation(nullptr)
+, _interpolationSlot(-1)
 // children (lazy allocs)
 // lazy alloc
 , _localZOrder(0)
@@ -108,6 +180,7 @@ Node::Node(void)
 , _orderOfArrival(0)
 , _running(false)
 , _visible(true)
+, _matrixStackNeeded(false)
 , _ignoreAnchorPointForPosition(false)
 , _reorderChildDirty(false)
 , _isTransitionFinished(false)
@@ -127,6 +200,7 @@ Node::Node(void)
 , _cascadeColorEnabled(false)
 , _cascadeOpacityEnabled(false)
 , _usingNormalizedPosition(false)
+, _normalizedPositionDirty(false)
 , _name("")
 , _hashOfName(0)
 , _cameraMask(1)
@@ -165,6 +239,20 @@ Node::~Node()
     // attributes
     CC_SAFE_RELEASE_NULL(_glProgramState);
 
+    if (_transformSystem)
+    {
+        _transformSystem->removeNode(this);
+    }
+    if (_spatialIndex)
+    {
+        _spatialIndex->removeNode(this);
+    }
+    if (_interpolationSlot >= 0)
+    {
+        Director::getInstance()->removeInterpolatedNode(this);
+    }
+    CC_SAFE_DELETE(_interpolation);
+
     for (auto& child : _children)
     {
         child->_parent = nullptr;
@@ -215,7 +303,7 @@ void Node::setSkewX(float skewX)
 #endif
     
     _skewX = skewX;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 }
 
 float Node::getSkewY() const
@@ -236,7 +324,7 @@ void Node::setSkewY(float skewY)
 #endif
     
     _skewY = skewY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 }
 
 
@@ -284,7 +372,7 @@ void Node::setRotation(float rotation)
         return;
     
     _rotationZ_X = _rotationZ_Y = rotation;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 
 #if CC_USE_PHYSICS
     if (!_physicsBody || !_physicsBody->_rotationResetTag)
@@ -306,7 +394,7 @@ void Node::setRotation3D(const Vec3& rotation)
         _rotationZ_X == rotation.z)
         return;
     
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -343,7 +431,7 @@ void Node::setRotationSkewX(float rotationX)
 #endif
     
     _rotationZ_X = rotationX;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 }
 
 float Node::getRotationSkewY() const
@@ -364,7 +452,7 @@ void Node::setRotationSkewY(float rotationY)
 #endif
     
     _rotationZ_Y = rotationY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 }
 
 /// scale getter
@@ -381,7 +469,7 @@ void Node::setScale(float scale)
         return;
     
     _scaleX = _scaleY = _scaleZ = scale;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
     
 #if CC_USE_PHYSICS
     updatePhysicsBodyTransform(getScene());
@@ -402,7 +490,7 @@ void Node::setScale(float scaleX,float scaleY)
     
     _scaleX = scaleX;
     _scaleY = scaleY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
     
 #if CC_USE_PHYSICS
     updatePhysicsBodyTransform(getScene());
@@ -416,7 +504,7 @@ void Node::setScaleX(float scaleX)
         return;
     
     _scaleX = scaleX;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
     
 #if CC_USE_PHYSICS
     updatePhysicsBodyTransform(getScene());
@@ -443,7 +531,7 @@ void Node::setScaleZ(float scaleZ)
 #endif
     
     _scaleZ = scaleZ;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 }
 
 /// scaleY getter
@@ -459,7 +547,7 @@ void Node::setScaleY(float scaleY)
         return;
     
     _scaleY = scaleY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
     
 #if CC_USE_PHYSICS
     updatePhysicsBodyTransform(getScene());
@@ -480,7 +568,7 @@ void Node::setPosition(const Vec2& position)
         return;
     
     _position = position;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
     _usingNormalizedPosition = false;
 
 #if CC_USE_PHYSICS
@@ -547,7 +635,7 @@ void Node::setPositionZ(float positionZ)
     if (_positionZ == positionZ)
         return;
     
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 
     _positionZ = positionZ;
 
@@ -570,7 +658,8 @@ void Node::setNormalizedPosition(const Vec2& position)
 
     _normalizedPosition = position;
     _usingNormalizedPosition = true;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    _normalizedPositionDirty = true;
+    markTransformDirty();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -590,7 +679,7 @@ void Node::setVisible(bool visible)
     if(visible != _visible)
     {
         _visible = visible;
-        if(_visible) _transformUpdated = _transformDirty = _inverseDirty = true;
+        if(_visible) markTransformDirty();
     }
 }
 
@@ -619,7 +708,7 @@ void Node::setAnchorPoint(const Vec2& point)
     {
         _anchorPoint = point;
         _anchorPointInPoints = Vec2(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y );
-        _transformUpdated = _transformDirty = _inverseDirty = true;
+        markTransformDirty();
     }
 }
 
@@ -636,7 +725,8 @@ void Node::setContentSize(const Size & size)
         _contentSize = size;
 
         _anchorPointInPoints = Vec2(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y );
-        _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        _contentSizeDirty = true;
+        markTransformDirty();
     }
 }
 
@@ -649,8 +739,26 @@ bool Node::isRunning() const
 /// parent setter
 void Node::setParent(Node * parent)
 {
+    if (_transformSystem)
+    {
+        _transformSystem->removeNode(this);
+    }
+    if (parent && parent->_transformSystem)
+    {
+        parent->_transformSystem->addNode(this);
+    }
+
     _parent = parent;
+    markTransformDirty();
+}
+
+void Node::markTransformDirty()
+{
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    if (_transformSystem)
+    {
+        _transformSystem->markDirty(_transformSlot);
+    }
 }
 
 /// isRelativeAnchorPoint getter
@@ -664,7 +772,7 @@ void Node::ignoreAnchorPointForPosition(bool newValue)
     if (newValue != _ignoreAnchorPointForPosition) 
     {
 		_ignoreAnchorPointForPosition = newValue;
-        _transformUpdated = _transformDirty = _inverseDirty = true;
+        markTransformDirty();
 	}
 }
 
@@ -839,114 +947,14 @@ void Node::enumerateChildren(const std::string &name, std::function<bool (Node *
     CCASSERT(name.length() != 0, "Invalid name");
     CCASSERT(callback != nullptr, "Invalid callback function");
     
-    size_t length = name.length();
-    
-    size_t subStrStartPos = 0;  // sub string start index
-    size_t subStrlength = length; // sub string length
-    
-    // Starts with '//'?
-    bool searchRecursively = false;
-    if (length > 2 && name[0] == '/' && name[1] == '/')
-    {
-        searchRecursively = true;
-        subStrStartPos = 2;
-        subStrlength -= 2;
-    }
-    
-    // End with '/..'?
-    bool searchFromParent = false;
-    if (length > 3 &&
-        name[length-3] == '/' &&
-        name[length-2] == '.' &&
-        name[length-1] == '.')
-    {
-        searchFromParent = true;
-        subStrlength -= 3;
-    }
-    
-    // Remove '//', '/..' if exist
-    std::string newName = name.substr(subStrStartPos, subStrlength);
-
-    if (searchFromParent)
-    {
-        newName.insert(0, "[[:alnum:]]+/");
-    }
-    
-    
-    if (searchRecursively)
-    {
-        // name is '//xxx'
-        doEnumerateRecursive(this, newName, callback);
-    }
-    else
-    {
-        // name is xxx
-        doEnumerate(newName, callback);
-    }
+    NodePath(name).enumerate(this, callback);
 }
 
-bool Node::doEnumerateRecursive(const Node* node, const std::string &name, std::function<bool (Node *)> callback) const
+void Node::enumerateChildren(const NodePath& path, std::function<bool (Node *)> callback) const
 {
-    bool ret =false;
-    
-    if (node->doEnumerate(name, callback))
-    {
-        // search itself
-        ret = true;
-    }
-    else
-    {
-        // search its children
-        for (const auto& child : node->getChildren())
-        {
-            if (doEnumerateRecursive(child, name, callback))
-            {
-                ret = true;
-                break;
-            }
-        }
-    }
-    
-    return ret;
-}
+    CCASSERT(callback != nullptr, "Invalid callback function");
 
-bool Node::doEnumerate(std::string name, std::function<bool (Node *)> callback) const
-{
-    // name may be xxx/yyy, should find its parent
-    size_t pos = name.find('/');
-    std::string searchName = name;
-    bool needRecursive = false;
-    if (pos != name.npos)
-    {
-        searchName = name.substr(0, pos);
-        name.erase(0, pos+1);
-        needRecursive = true;
-    }
-    
-    bool ret = false;
-    for (const auto& child : _children)
-    {
-        if (std::regex_match(child->_name, std::regex(searchName)))
-        {
-            if (!needRecursive)
-            {
-                // terminate enumeration if callback return true
-                if (callback(child))
-                {
-                    ret = true;
-                    break;
-                }
-            }
-            else
-            {
-                ret = child->doEnumerate(name, callback);
-                if (ret)
-                    break;
-            }
-        }
-    }
-    
-    return ret;
+    path.enumerate(this, callback);
 }
 
 /* "add" logic MUST only be on this method
@@ -1180,7 +1188,7 @@ void Node::reorderChild(Node *child, int zOrder)
 void Node::sortAllChildren()
 {
     if( _reorderChildDirty ) {
-        std::sort( std::begin(_children), std::end(_children), nodeComparisonLess );
+        sortNodes(_children);
         _reorderChildDirty = false;
     }
 }
@@ -1204,27 +1212,44 @@ void Node::visit()
 
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
 {
-    uint32_t flags = parentFlags;
-    flags |= (_transformUpdated ? FLAGS_TRANSFORM_DIRTY : 0);
-    flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
-
-    if(_usingNormalizedPosition && (flags & FLAGS_CONTENT_SIZE_DIRTY)) {
+    // FLAGS_CONTENT_SIZE_DIRTY comes from the parent only, it doesn't reach the grandchildren:
+    // only the nodes placed relatively to the size of their parent depend on it
+    if(_usingNormalizedPosition && (_normalizedPositionDirty || (parentFlags & FLAGS_CONTENT_SIZE_DIRTY))) {
         CCASSERT(_parent, "setNormalizedPosition() doesn't work with orphan nodes");
         auto s = _parent->getContentSize();
         _position.x = _normalizedPosition.x * s.width;
         _position.y = _normalizedPosition.y * s.height;
-        _transformUpdated = _transformDirty = _inverseDirty = true;
+        _normalizedPositionDirty = false;
+        markTransformDirty();
     }
 
-    if(flags & FLAGS_DIRTY_MASK)
+    uint32_t flags = parentFlags & ~FLAGS_CONTENT_SIZE_DIRTY;
+    flags |= (_transformUpdated ? FLAGS_TRANSFORM_DIRTY : 0);
+
+    // a new content size moves the anchor point, which already marked the transform dirty
+    if(flags & FLAGS_TRANSFORM_DIRTY)
         _modelViewTransform = this->transform(parentTransform);
 
+    flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
+
     _transformUpdated = false;
     _contentSizeDirty = false;
 
     return flags;
 }
 
+bool Node::isCulledBySpatialIndex(const Mat4& parentTransform, uint32_t& parentFlags)
+{
+    return _spatialIndex && _spatialIndex->cullNode(this, parentTransform, parentFlags);
+}
+
+bool Node::isUsingMatrixStack() const
+{
+    Director* director = Director::getInstance();
+    // worker threads can't share the stack, it is never updated during a parallel visit
+    return !director->isParallelVisitEnabled() && (_matrixStackNeeded || director->isMatrixStackEnabled());
+}
+
 bool Node::isVisitableByVisitingCamera() const
 {
     auto camera = Camera::getVisitingCamera();
@@ -1232,6 +1257,36 @@ bool Node::isVisitableByVisitingCamera() const
     return visibleByCamera;
 }
 
+void Node::visitChild(Node* child, Renderer* renderer, uint32_t flags)
+{
+    // the scene is being visited in parallel, see ParallelVisitor
+    if (renderer->isRecording())
+    {
+        if (!child->isVisitThreadSafe())
+        {
+            // visited on the main thread, with the Mat4 stack set like in a serial visit
+            Mat4 parentTransform = _modelViewTransform;
+            renderer->defer([=]() {
+                Director* director = Director::getInstance();
+                director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+                director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, parentTransform);
+                child->visit(renderer, parentTransform, flags);
+                director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+            });
+            return;
+        }
+
+        ParallelVisitor* visitor = Director::getInstance()->getParallelVisitor();
+        if (visitor && visitor->isSplitting())
+        {
+            visitor->splitChild(this, child, flags);
+            return;
+        }
+    }
+
+    child->visit(renderer, _modelViewTransform, flags);
+}
+
 void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t parentFlags)
 {
     // quick return if not visible. children won't be drawn.
@@ -1240,14 +1295,25 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
         return;
     }
 
+    // out of the view, the whole subtree is skipped
+    if (isCulledBySpatialIndex(parentTransform, parentFlags))
+    {
+        return;
+    }
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the Mat4 stack,
-    // but it is deprecated and your code should not rely on it
+    // but it is deprecated and your code should not rely on it.
+    // It is not updated when the scene is visited in parallel, see isUsingMatrixStack().
     Director* director = Director::getInstance();
-    director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    bool useMatrixStack = isUsingMatrixStack();
+    if (useMatrixStack)
+    {
+        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
     
     bool visibleByCamera = isVisitableByVisitingCamera();
 
@@ -1262,7 +1328,7 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
             auto node = _children.at(i);
 
             if ( node && node->_localZOrder < 0 )
-                node->visit(renderer, _modelViewTransform, flags);
+                visitChild(node, renderer, flags);
             else
                 break;
         }
@@ -1271,14 +1337,17 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
             this->draw(renderer, _modelViewTransform, flags);
 
         for(auto it=_children.cbegin()+i; it != _children.cend(); ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
+            visitChild(*it, renderer, flags);
     }
     else if (visibleByCamera)
     {
         this->draw(renderer, _modelViewTransform, flags);
     }
 
-    director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (useMatrixStack)
+    {
+        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    }
     
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -1314,6 +1383,12 @@ void Node::onEnter()
     this->resume();
     
     _running = true;
+
+    if (_interpolation)
+    {
+        resetTransformInterpolation();
+        Director::getInstance()->addInterpolatedNode(this);
+    }
     
 #if CC_ENABLE_SCRIPT_BINDING
     if (_scriptType == kScriptTypeLua)
@@ -1388,6 +1463,11 @@ void Node::onExit()
     this->pause();
     
     _running = false;
+
+    if (_interpolationSlot >= 0)
+    {
+        Director::getInstance()->removeInterpolatedNode(this);
+    }
     
     for( const auto &child: _children)
         child->onExit();
@@ -1596,6 +1676,11 @@ AffineTransform Node::getNodeToParentAffineTransform() const
 
 const Mat4& Node::getNodeToParentTransform() const
 {
+    if (_transformDirty && _transformSystem && _transformSystem->isLocalValid(_transformSlot))
+    {
+        return _transformSystem->getLocal(_transformSlot);
+    }
+
     if (_transformDirty)
     {
         // Translate values
@@ -1706,9 +1791,9 @@ const Mat4& Node::getNodeToParentTransform() const
 
 void Node::setNodeToParentTransform(const Mat4& transform)
 {
+    markTransformDirty();
     _transform = transform;
     _transformDirty = false;
-    _transformUpdated = true;
 }
 
 void Node::setAdditionalTransform(const AffineTransform& additionalTransform)
@@ -1718,6 +1803,88 @@ void Node::setAdditionalTransform(const AffineTransform& additionalTransform)
     setAdditionalTransform(&tmp);
 }
 
+void Node::setTransformInterpolationEnabled(bool enabled)
+{
+    if (enabled == (_interpolation != nullptr))
+        return;
+
+    if (enabled)
+    {
+        _interpolation = new (std::nothrow) TransformInterpolation();
+        _interpolation->applied = false;
+        resetTransformInterpolation();
+        if (_running)
+        {
+            Director::getInstance()->addInterpolatedNode(this);
+        }
+    }
+    else
+    {
+        if (_interpolationSlot >= 0)
+        {
+            Director::getInstance()->removeInterpolatedNode(this);
+        }
+        CC_SAFE_DELETE(_interpolation);
+    }
+}
+
+void Node::resetTransformInterpolation()
+{
+    if (_interpolation && !_interpolation->applied)
+    {
+        saveInterpolationState();
+    }
+}
+
+void Node::saveInterpolationState()
+{
+    auto& previous = _interpolation->previous;
+    previous.position = _position;
+    previous.rotationX = _rotationZ_X;
+    previous.rotationY = _rotationZ_Y;
+    previous.scaleX = _scaleX;
+    previous.scaleY = _scaleY;
+}
+
+void Node::applyInterpolatedTransform(float alpha)
+{
+    auto& previous = _interpolation->previous;
+    auto& simulated = _interpolation->simulated;
+    simulated.position = _position;
+    simulated.rotationX = _rotationZ_X;
+    simulated.rotationY = _rotationZ_Y;
+    simulated.scaleX = _scaleX;
+    simulated.scaleY = _scaleY;
+
+    // nodes at rest keep their matrices
+    if (simulated == previous)
+        return;
+
+    // the members are written directly: the setters would also move the physics body
+    _position = previous.position.lerp(simulated.position, alpha);
+    _rotationZ_X = previous.rotationX + (simulated.rotationX - previous.rotationX) * alpha;
+    _rotationZ_Y = previous.rotationY + (simulated.rotationY - previous.rotationY) * alpha;
+    _scaleX = previous.scaleX + (simulated.scaleX - previous.scaleX) * alpha;
+    _scaleY = previous.scaleY + (simulated.scaleY - previous.scaleY) * alpha;
+    markTransformDirty();
+    _interpolation->applied = true;
+}
+
+void Node::restoreSimulatedTransform()
+{
+    if (!_interpolation->applied)
+        return;
+
+    auto& simulated = _interpolation->simulated;
+    _position = simulated.position;
+    _rotationZ_X = simulated.rotationX;
+    _rotationZ_Y = simulated.rotationY;
+    _scaleX = simulated.scaleX;
+    _scaleY = simulated.scaleY;
+    markTransformDirty();
+    _interpolation->applied = false;
+}
+
 void Node::setAdditionalTransform(Mat4* additionalTransform)
 {
     if(additionalTransform == nullptr) {
@@ -1726,7 +1893,7 @@ void Node::setAdditionalTransform(Mat4* additionalTransform)
         _additionalTransform = *additionalTransform;
         _useAdditionalTransform = true;
     }
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 }
 
 
@@ -1742,7 +1909,7 @@ AffineTransform Node::getParentToNodeAffineTransform() const
 const Mat4& Node::getParentToNodeTransform() const
 {
     if ( _inverseDirty ) {
-        _inverse = _transform.getInversed();
+        _inverse = getNodeToParentTransform().getInversed();
         _inverseDirty = false;
     }
 
@@ -1762,6 +1929,11 @@ AffineTransform Node::getNodeToWorldAffineTransform() const
 
 Mat4 Node::getNodeToWorldTransform() const
 {
+    if (_transformSystem && _transformSystem->isWorldValid(_transformSlot))
+    {
+        return _transformSystem->getWorld(_transformSlot);
+    }
+
     Mat4 t = this->getNodeToParentTransform();
 
     for (Node *p = _parent; p != nullptr; p = p->getParent())
@@ -32,6 +32,7 @@
 #include "base/ccMacros.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCVector.h"
+#include "base/CCSmallVector.h"
 #include "base/CCScriptSupport.h"
 #include "base/CCProtocols.h"
 #include "math/CCAffineTransform.h"
@@ -51,6 +52,10 @@ class Component;
 class ComponentContainer;
 class EventDispatcher;
 class Scene;
+class NodePath;
+class SpatialIndex;
+class TransformSystem;
+struct TransformInterpolation;
 class Renderer;
 class GLProgram;
 class GLProgramState;
@@ -73,6 +78,14 @@ enum {
 
 bool CC_DLL nodeComparisonLess(Node* n1, Node* n2);
 
+/** Sorts nodes with nodeComparisonLess.
+ Arrays where only a few nodes changed their order since the last sort, like children y-sorted every frame, are sorted in linear time.
+ */
+void CC_DLL sortNodes(Node** first, Node** last);
+void CC_DLL sortNodes(Vector<Node*>& nodes);
+template<int N>
+inline void sortNodes(SmallVector<Node*, N>& nodes) { sortNodes(nodes.begin(), nodes.end()); }
+
 class EventListener;
 
 /** @brief Node is the base element of the Scene Graph. Elements of the Scene Graph must be Node objects or subclasses of it.
@@ -741,6 +754,9 @@ public:
      *
      * @warning Only support alpha or number for name, and not support unicode
      *
+     * @note The name is compiled to a NodePath on every call. Plain names and `.*` are matched without std::regex,
+     * other expressions are compiled to a std::regex each time: use a NodePath to look them up every frame.
+     *
      * @param callback A callback function to execute on nodes that match the `name` parameter. The function takes the following arguments:
      *  `node` 
      *      A node that matches the name
@@ -749,6 +765,8 @@ public:
      * @since v3.2
      */
     virtual void enumerateChildren(const std::string &name, std::function<bool(Node* node)> callback) const;
+    /** Same as enumerateChildren(const std::string&, ...), with a path compiled beforehand */
+    void enumerateChildren(const NodePath& path, std::function<bool(Node* node)> callback) const;
     /**
      * Returns the array of the node's children
      *
@@ -1063,6 +1081,27 @@ public:
     virtual void visit(Renderer *renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit() final;
 
+    /**
+     * Returns whether the node and its children can be visited from a worker thread when the Director visits the scene in parallel.
+     * Nodes that use OpenGL, the Mat4 stack or shared state from visit() or draw() must return false:
+     * they are visited on the main thread once the nodes visited in parallel are done, without changing the drawing order.
+     */
+    virtual bool isVisitThreadSafe() const { return true; }
+
+    /**
+     * Returns whether the TransformSystem of the scene can compute the transform of the node from its position, rotation,
+     * scale, skew and anchor point. Nodes overriding getNodeToParentTransform(), or changing their transform without
+     * markTransformDirty(), must return false: they and their children are left out of the TransformSystem.
+     */
+    virtual bool isTransformSystemSupported() const { return true; }
+
+    /**
+     * Declares that the draw code of the node reads the modelview Mat4 stack, with kmGL* functions or Director::getMatrix().
+     * The transform of such nodes is loaded in the stack even when Director::setMatrixStackEnabled(false) was called.
+     */
+    void setMatrixStackNeeded(bool needed) { _matrixStackNeeded = needed; }
+    bool isMatrixStackNeeded() const { return _matrixStackNeeded; }
+
 
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
@@ -1414,6 +1453,17 @@ public:
     void setAdditionalTransform(Mat4* additionalTransform);
     void setAdditionalTransform(const AffineTransform& additionalTransform);
 
+    /**
+     * Draws the node between its last two simulated states when the Director runs with a fixed time step.
+     * While the scene is visited, the position, rotation and scale of the node are blended with Director::getInterpolationAlpha(),
+     * they are back to their simulated values for the updates. Has no effect without Director::setFixedTimeStep(). Disabled by default.
+     */
+    void setTransformInterpolationEnabled(bool enabled);
+    bool isTransformInterpolationEnabled() const { return _interpolation != nullptr; }
+
+    /** Forgets the previous simulated state, so that a node placed somewhere else on purpose is not drawn sliding from its old place */
+    void resetTransformInterpolation();
+
     /// @} end of Coordinate Converters
 
       /// @{
@@ -1512,17 +1562,33 @@ protected:
     Mat4 transform(const Mat4 &parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
 
+    /// Flags the transform as changed, and tells the TransformSystem of the node, if any.
+    void markTransformDirty();
+
+    /// Keeps the current position, rotation and scale as the previous simulated state. Called by the Director before the last fixed step of a frame.
+    void saveInterpolationState();
+    /// Replaces the position, rotation and scale by a blend of the previous and current simulated states, until restoreSimulatedTransform().
+    void applyInterpolatedTransform(float alpha);
+    void restoreSimulatedTransform();
+
+    /// Whether the SpatialIndex the node is registered to, if any, culls the node and its children. May add held back flags to parentFlags.
+    bool isCulledBySpatialIndex(const Mat4& parentTransform, uint32_t& parentFlags);
+
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
     virtual void updateCascadeColor();
     virtual void disableCascadeColor();
     virtual void updateColor() {}
     
-    bool doEnumerate(std::string name, std::function<bool (Node *)> callback) const;
-    bool doEnumerateRecursive(const Node* node, const std::string &name, std::function<bool (Node *)> callback) const;
     
     //check whether this camera mask is visible by the current visiting camera
     bool isVisitableByVisitingCamera() const;
+
+    /// whether visit() must load the transform of the node in the modelview Mat4 stack
+    bool isUsingMatrixStack() const;
+
+    /// visits a child, or defers its visit to the main thread if it can't be visited in parallel
+    void visitChild(Node* child, Renderer* renderer, uint32_t flags);
     
 #if CC_USE_PHYSICS
     void updatePhysicsBodyTransform(Scene* layer);
@@ -1551,6 +1617,7 @@ protected:
     float _positionZ;               ///< OpenGL real Z position
     Vec2 _normalizedPosition;
     bool _usingNormalizedPosition;
+    bool _normalizedPositionDirty;  ///< whether _position must be computed again from _normalizedPosition
 
     float _skewX;                   ///< skew angle on x-axis
     float _skewY;                   ///< skew angle on y-axis
@@ -1571,6 +1638,12 @@ protected:
     mutable Mat4 _additionalTransform; ///< transform
     bool _useAdditionalTransform;   ///< The flag to check whether the additional transform is dirty
     bool _transformUpdated;         ///< Whether or not the Transform object was updated since the last frame
+    TransformSystem* _transformSystem; ///< weak reference to the TransformSystem of the scene, if it uses one
+    int _transformSlot;             ///< index of the node in the arrays of _transformSystem
+    SpatialIndex* _spatialIndex;    ///< weak reference to the SpatialIndex the node is registered to, if any
+    int _spatialSlot;               ///< index of the node in _spatialIndex
+    TransformInterpolation* _interpolation; ///< simulated states blended for rendering, nullptr when interpolation is disabled
+    int _interpolationSlot;         ///< index of the node in the interpolated nodes of the Director, -1 while not running
 
     int _localZOrder;               ///< Local order (relative to its siblings) used to sort the node
     float _globalZOrder;            ///< Global order used to sort the node
@@ -1600,6 +1673,8 @@ protected:
 
     bool _visible;                  ///< is this node visible
 
+    bool _matrixStackNeeded;        ///< whether the draw code reads the modelview Mat4 stack
+
     bool _ignoreAnchorPointForPosition; ///< true if the Anchor Vec2 will be (0,0) when you position the Node, false otherwise.
                                           ///< Used by Layer and Scene.
 
@@ -1644,6 +1719,11 @@ private:
 #if CC_USE_PHYSICS
     friend class Layer;
 #endif //CC_USTPS
+    friend class ParallelVisitor;
+    friend class TransformSystem;
+    friend class NodePath;
+    friend class SpatialIndex;
+    friend class Director;
 };
 
 // NodeRGBA
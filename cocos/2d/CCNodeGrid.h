@@ -55,6 +55,7 @@ public:
 
     // overrides
     virtual void visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags) override;
+    virtual bool isVisitThreadSafe() const override { return false; }
 
 protected:
     NodeGrid();
@@ -0,0 +1,217 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/CCNodePath.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "2d/CCNode.h"
+
+NS_CC_BEGIN
+
+static bool isPlainName(const std::string& name, size_t length)
+{
+    static const char* specials = ".[]{}()\\*+?^$|";
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (strchr(specials, name[i]))
+            return false;
+    }
+    return true;
+}
+
+bool NodePath::Segment::matches(const Node* node) const
+{
+    const std::string& nodeName = node->_name;
+
+    switch (type)
+    {
+        case Type::NAME:
+            // different strings may have the same hash, but different hashes can't be the same string
+            return node->_hashOfName == hash && nodeName == name;
+        case Type::PREFIX:
+            return nodeName.compare(0, name.length(), name) == 0;
+        case Type::ANY:
+            return true;
+        case Type::ANY_NON_EMPTY:
+            return !nodeName.empty();
+        case Type::ANY_ALNUM:
+            if (nodeName.empty())
+                return false;
+            for (char c : nodeName)
+            {
+                if (!isalnum((unsigned char)c))
+                    return false;
+            }
+            return true;
+        case Type::REGEX:
+            return std::regex_match(nodeName, regex);
+    }
+    return false;
+}
+
+NodePath::NodePath()
+: _recursive(false)
+{
+}
+
+NodePath::NodePath(const std::string& path)
+: _path(path)
+, _recursive(false)
+{
+    size_t length = path.length();
+    size_t start = 0;
+    size_t end = length;
+
+    // starts with '//'?
+    if (length > 2 && path[0] == '/' && path[1] == '/')
+    {
+        _recursive = true;
+        start = 2;
+    }
+
+    // ends with '/..'? the names are those of the parents of the nodes found
+    if (length > 3 && path.compare(length - 3, 3, "/..") == 0)
+    {
+        end -= 3;
+        compileSegment("[[:alnum:]]+");
+    }
+
+    while (true)
+    {
+        size_t slash = path.find('/', start);
+        if (slash == std::string::npos || slash >= end)
+        {
+            compileSegment(path.substr(start, end - start));
+            break;
+        }
+
+        compileSegment(path.substr(start, slash - start));
+        start = slash + 1;
+    }
+}
+
+void NodePath::compileSegment(const std::string& segment)
+{
+    Segment compiled;
+    compiled.hash = 0;
+
+    if (segment == ".*")
+    {
+        compiled.type = Segment::Type::ANY;
+    }
+    else if (segment == ".+")
+    {
+        compiled.type = Segment::Type::ANY_NON_EMPTY;
+    }
+    else if (segment == "[[:alnum:]]+")
+    {
+        compiled.type = Segment::Type::ANY_ALNUM;
+    }
+    else if (isPlainName(segment, segment.length()))
+    {
+        compiled.type = Segment::Type::NAME;
+        compiled.name = segment;
+        std::hash<std::string> h;
+        compiled.hash = h(segment);
+    }
+    else if (segment.length() > 2 && segment.compare(segment.length() - 2, 2, ".*") == 0
+             && isPlainName(segment, segment.length() - 2))
+    {
+        compiled.type = Segment::Type::PREFIX;
+        compiled.name = segment.substr(0, segment.length() - 2);
+    }
+    else
+    {
+        compiled.type = Segment::Type::REGEX;
+        compiled.regex = std::regex(segment);
+    }
+
+    _segments.push_back(compiled);
+}
+
+bool NodePath::enumerate(const Node* root, const std::function<bool(Node*)>& callback) const
+{
+    CCASSERT(callback != nullptr, "Invalid callback function");
+
+    if (_segments.empty())
+        return false;
+
+    if (_recursive)
+        return enumerateRecursive(root, callback);
+
+    return enumerateChildren(root, 0, callback);
+}
+
+Node* NodePath::findFirst(const Node* root) const
+{
+    Node* found = nullptr;
+    enumerate(root, [&found](Node* node) {
+        found = node;
+        return true;
+    });
+    return found;
+}
+
+bool NodePath::enumerateChildren(const Node* node, size_t segment, const std::function<bool(Node*)>& callback) const
+{
+    const Segment& current = _segments[segment];
+    bool last = (segment + 1 == _segments.size());
+
+    for (const auto& child : node->getChildren())
+    {
+        if (!current.matches(child))
+            continue;
+
+        if (last)
+        {
+            // terminate enumeration if callback return true
+            if (callback(child))
+                return true;
+        }
+        else if (enumerateChildren(child, segment + 1, callback))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool NodePath::enumerateRecursive(const Node* node, const std::function<bool(Node*)>& callback) const
+{
+    if (enumerateChildren(node, 0, callback))
+        return true;
+
+    for (const auto& child : node->getChildren())
+    {
+        if (enumerateRecursive(child, callback))
+            return true;
+    }
+
+    return false;
+}
+
+NS_CC_END
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CCNODEPATH_H__
+#define __CCNODEPATH_H__
+
+#include <functional>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+class Node;
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+/** @brief A name query for Node::enumerateChildren(), compiled once and reusable.
+
+ It uses the syntax of Node::enumerateChildren(): `//` at the start searches recursively, `/..` at the end
+ moves up to the parents, and `/` separates the names of the successive generations.
+
+ Each name is matched without std::regex when possible:
+ - plain names are compared with the name hash of the nodes first;
+ - `.*`, `.+` and `[[:alnum:]]+` match any name, `Prefix.*` matches the names that start with `Prefix`;
+ - anything else is compiled to a std::regex, once, when the path is created.
+
+ @code
+ // in the constructor
+ _buttonsPath = NodePath("//Panel/Button.*");
+ // every frame
+ _root->enumerateChildren(_buttonsPath, [](Node* button) { ...; return false; });
+ @endcode
+ */
+class CC_DLL NodePath
+{
+public:
+    NodePath();
+    NodePath(const std::string& path);
+
+    const std::string& getPath() const { return _path; }
+
+    /** Calls callback with the matching descendants of root, until callback returns true.
+     @return true if callback stopped the enumeration
+     */
+    bool enumerate(const Node* root, const std::function<bool(Node*)>& callback) const;
+
+    /** The first matching descendant of root, or nullptr */
+    Node* findFirst(const Node* root) const;
+
+protected:
+    struct Segment
+    {
+        enum class Type
+        {
+            NAME,
+            PREFIX,
+            ANY,
+            ANY_NON_EMPTY,
+            ANY_ALNUM,
+            REGEX,
+        };
+
+        Type type;
+        std::string name;
+        size_t hash;
+        std::regex regex;
+
+        bool matches(const Node* node) const;
+    };
+
+    void compileSegment(const std::string& segment);
+    bool enumerateChildren(const Node* node, size_t segment, const std::function<bool(Node*)>& callback) const;
+    bool enumerateRecursive(const Node* node, const std::function<bool(Node*)>& callback) const;
+
+    std::string _path;
+    bool _recursive;
+    std::vector<Segment> _segments;
+};
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCNODEPATH_H__
@@ -0,0 +1,216 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CCNODEPOOL_H__
+#define __CCNODEPOOL_H__
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "2d/CCNode.h"
+#include "base/CCEventDispatcher.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+/** @brief Recycles nodes of one type, for objects spawned and destroyed all the time like bullets or damage numbers.
+
+ release() removes the node from its parent, cleans it up and resets it, then keeps it. acquire() returns a
+ kept node, or creates one when there is none: a recycled node costs no heap allocation, no constructor
+ and no destructor.
+
+ The reset puts back the transform, visibility, color, opacity, tag, name, Z orders and user data of Node,
+ removes the children, event listeners and components. Type specific state (sprite frame, string of a
+ label...) is set by the code that acquires the node, or by the reset function of the pool.
+
+ @code
+ NodePool<Sprite> bullets([]() { return Sprite::create("bullet.png"); });
+ bullets.reserve(100);
+ auto bullet = bullets.acquire();
+ addChild(bullet);
+ ...
+ bullets.release(bullet);
+ @endcode
+ */
+template <class T>
+class NodePool
+{
+public:
+    /** Creates a pool. create returns an autoreleased node, T::create() by default. reset is called after the default reset of released nodes */
+    explicit NodePool(const std::function<T*()>& create = nullptr, const std::function<void(T*)>& reset = nullptr)
+    : _create(create)
+    , _reset(reset)
+    , _maxFreeNodes(-1)
+    , _usedCount(0)
+    , _highWaterMark(0)
+    , _createdCount(0)
+    {
+        static_assert(std::is_convertible<T*, Node*>::value, "Invalid Type for cocos2d::NodePool<T>!");
+    }
+
+    ~NodePool()
+    {
+        clear();
+    }
+
+    /** A node ready to be used, autoreleased like the nodes returned by create() */
+    T* acquire()
+    {
+        T* node = nullptr;
+        if (_freeNodes.empty())
+        {
+            node = _create ? _create() : T::create();
+            if (!node)
+                return nullptr;
+            ++_createdCount;
+        }
+        else
+        {
+            // the pool reference is handed to the autorelease pool, as create() does
+            node = _freeNodes.back();
+            _freeNodes.pop_back();
+            node->autorelease();
+        }
+
+        ++_usedCount;
+        if (_usedCount > _highWaterMark)
+            _highWaterMark = _usedCount;
+        return node;
+    }
+
+    /** Takes back a node acquired from this pool. It is removed from its parent */
+    void release(T* node)
+    {
+        CCASSERT(node != nullptr, "Invalid node");
+        CCASSERT(_usedCount > 0, "The node was not acquired from this pool");
+
+        --_usedCount;
+        node->retain();
+        // removeFromParentAndCleanup() does nothing for a parentless node,
+        // its actions and schedules must still be stopped
+        if (node->getParent())
+            node->removeFromParentAndCleanup(true);
+        else
+            node->cleanup();
+
+        if (_maxFreeNodes >= 0 && (ssize_t)_freeNodes.size() >= _maxFreeNodes)
+        {
+            node->release();
+            return;
+        }
+
+        resetNode(node);
+        if (_reset)
+            _reset(node);
+        _freeNodes.push_back(node);
+    }
+
+    /** Creates nodes until count of them are free */
+    void reserve(ssize_t count)
+    {
+        _freeNodes.reserve(count);
+        while ((ssize_t)_freeNodes.size() < count)
+        {
+            T* node = _create ? _create() : T::create();
+            if (!node)
+                break;
+            ++_createdCount;
+            node->retain();
+            _freeNodes.push_back(node);
+        }
+    }
+
+    /** Destroys the free nodes */
+    void clear()
+    {
+        for (auto node : _freeNodes)
+            node->release();
+        _freeNodes.clear();
+    }
+
+    /** Nodes released over this number are destroyed. -1, the default, keeps them all */
+    void setMaxFreeNodes(ssize_t count) { _maxFreeNodes = count; }
+    ssize_t getMaxFreeNodes() const { return _maxFreeNodes; }
+
+    /** Number of nodes waiting in the pool */
+    ssize_t getFreeCount() const { return _freeNodes.size(); }
+    /** Number of nodes acquired and not released */
+    ssize_t getUsedCount() const { return _usedCount; }
+    /** Highest number of nodes used at the same time, a good value for reserve() */
+    ssize_t getHighWaterMark() const { return _highWaterMark; }
+    /** Number of nodes the pool had to create */
+    ssize_t getCreatedCount() const { return _createdCount; }
+
+    /** Puts back the state of Node as after its construction, except its anchor point, content size and shader */
+    static void resetNode(Node* node)
+    {
+        node->removeAllChildrenWithCleanup(true);
+        node->getEventDispatcher()->removeEventListenersForTarget(node);
+        node->removeAllComponents();
+
+        node->setPosition3D(Vec3::ZERO);
+        node->setRotation3D(Vec3::ZERO);
+        node->setScale(1.0f);
+        node->setScaleZ(1.0f);
+        node->setSkewX(0.0f);
+        node->setSkewY(0.0f);
+        node->setAdditionalTransform(nullptr);
+        node->setLocalZOrder(0);
+        node->setGlobalZOrder(0);
+        node->setVisible(true);
+        node->setOpacity(255);
+        node->setColor(Color3B::WHITE);
+        node->setTag(Node::INVALID_TAG);
+        node->setName("");
+        node->setUserData(nullptr);
+        node->setUserObject(nullptr);
+        node->setCameraMask(1);
+        node->setOnEnterCallback(nullptr);
+        node->setOnExitCallback(nullptr);
+    }
+
+protected:
+    std::function<T*()> _create;
+    std::function<void(T*)> _reset;
+    std::vector<T*> _freeNodes;
+    ssize_t _maxFreeNodes;
+    ssize_t _usedCount;
+    ssize_t _highWaterMark;
+    ssize_t _createdCount;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(NodePool);
+};
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCNODEPOOL_H__
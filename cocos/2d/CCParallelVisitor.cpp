@@ -0,0 +1,171 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/CCParallelVisitor.h"
+
+#include <algorithm>
+
+#include "2d/CCNode.h"
+#include "renderer/CCRenderer.h"
+#include "renderer/CCRenderCommandBuffer.h"
+#include "base/CCJobSystem.h"
+
+NS_CC_BEGIN
+
+ParallelVisitor::ParallelVisitor(JobSystem* jobSystem)
+: _renderer(nullptr)
+, _jobSystem(jobSystem)
+, _usedBuffers(0)
+, _serialBuffer(nullptr)
+, _splitting(false)
+, _depth(0)
+, _maxSplitDepth(4)
+{
+    CCASSERT(jobSystem, "Invalid job system");
+}
+
+ParallelVisitor::~ParallelVisitor()
+{
+    for (auto buffer : _buffers)
+        delete buffer;
+}
+
+unsigned int ParallelVisitor::getThreadCount() const
+{
+    return (unsigned int)_jobSystem->getWorkerCount() + 1;
+}
+
+void ParallelVisitor::visit(Node* root, Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (!root->isVisitThreadSafe())
+    {
+        root->visit(renderer, parentTransform, parentFlags);
+        return;
+    }
+
+    _renderer = renderer;
+    _tasks.clear();
+    _taskNodes.clear();
+    _usedBuffers = 0;
+
+    // slot 0 is this thread, slot i + 1 is worker i. Fetched every frame, the workers may have been restarted
+    int workerCount = _jobSystem->getWorkerCount();
+    _threadIDs.resize(workerCount + 1);
+    _threadIDs[0] = std::this_thread::get_id();
+    for (int i = 0; i < workerCount; ++i)
+        _threadIDs[i + 1] = _jobSystem->getWorkerThreadID(i);
+    renderer->beginRecording(_threadIDs);
+
+    // 1st pass, on this thread: the big nodes are visited as usual while their children are grouped into tasks.
+    // What is recorded meanwhile goes to the serial buffers, in between the buffers of the tasks.
+    _serialBuffer = nextBuffer();
+    renderer->setRecordingBuffer(0, _serialBuffer);
+    _splitting = true;
+    _depth = 0;
+    root->visit(renderer, parentTransform, parentFlags);
+    _splitting = false;
+
+    // 2nd pass: the tasks, on this thread and the idle workers. Not with wait(), which would let this thread
+    // run a job of the queue, a texture decode, in the middle of the visit
+    if (_tasks.size() > 1 && workerCount > 0)
+    {
+        _jobSystem->parallelForAndWait(0, (ssize_t)_tasks.size(), 1, [this](ssize_t first, ssize_t last) {
+            for (ssize_t i = first; i < last; ++i)
+                runTask(_tasks[i]);
+        });
+    }
+    else
+    {
+        for (const auto& task : _tasks)
+            runTask(task);
+    }
+
+    renderer->endRecording();
+
+    // merge, in scene order
+    for (size_t i = 0; i < _usedBuffers; ++i)
+    {
+        renderer->replay(*_buffers[i]);
+        _buffers[i]->clear();
+    }
+}
+
+void ParallelVisitor::splitChild(Node* parent, Node* child, uint32_t flags)
+{
+    if (_depth < _maxSplitDepth && child->_children.size() >= MIN_CHILDREN_TO_SPLIT)
+    {
+        // visited right away so that its own children can be split
+        ++_depth;
+        child->visit(_renderer, parent->_modelViewTransform, flags);
+        --_depth;
+        return;
+    }
+
+    size_t siblings = parent->_children.size();
+    size_t taskSize = std::max<size_t>(1, siblings / (getThreadCount() * TASKS_PER_THREAD));
+
+    // consecutive siblings share a task, unless something was recorded in between
+    if (!_tasks.empty() && _serialBuffer->empty())
+    {
+        Task& task = _tasks.back();
+        if (task.parent == parent && task.flags == flags && task.count < taskSize)
+        {
+            _taskNodes.push_back(child);
+            ++task.count;
+            return;
+        }
+    }
+
+    Task task = { parent, flags, _taskNodes.size(), 1, nextBuffer() };
+    _tasks.push_back(task);
+    _taskNodes.push_back(child);
+
+    // what is recorded from now on goes after the task
+    _serialBuffer = nextBuffer();
+    _renderer->setRecordingBuffer(0, _serialBuffer);
+}
+
+RenderCommandBuffer* ParallelVisitor::nextBuffer()
+{
+    if (_usedBuffers == _buffers.size())
+    {
+        _buffers.push_back(new (std::nothrow) RenderCommandBuffer());
+    }
+
+    return _buffers[_usedBuffers++];
+}
+
+void ParallelVisitor::runTask(const Task& task)
+{
+    // a task runs on a single thread, its slot only records this task until the task ends
+    ssize_t slot = _jobSystem->getCurrentWorker() + 1;
+    _renderer->setRecordingBuffer(slot, task.buffer);
+
+    for (size_t i = task.first; i < task.first + task.count; ++i)
+    {
+        task.parent->visitChild(_taskNodes[i], _renderer, task.flags);
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_PARALLEL_VISITOR_H__
+#define __CC_PARALLEL_VISITOR_H__
+
+#include <vector>
+#include <thread>
+
+#include "base/ccMacros.h"
+#include "math/CCMath.h"
+
+NS_CC_BEGIN
+
+class Node;
+class Renderer;
+class RenderCommandBuffer;
+class JobSystem;
+
+/** Visits a scene graph with several threads.
+
+ The scene is first visited on the main thread as usual, except that the children of big nodes are not
+ visited right away: consecutive siblings are grouped into tasks, each one with its own RenderCommandBuffer.
+ The tasks are then visited by the workers of a JobSystem and by the main thread, which waits for them, and
+ finally every buffer is replayed into the Renderer in scene order. The render queues end up exactly as after a serial visit.
+
+ Nodes that return false from Node::isVisitThreadSafe() are visited on the main thread while replaying.
+ The Mat4 stack of the Director is not updated by the nodes visited in parallel.
+
+ It is owned by the Director, see Director::setParallelVisitEnabled().
+ */
+class CC_DLL ParallelVisitor
+{
+public:
+    /** Nodes with fewer children are visited by a single task */
+    static const int MIN_CHILDREN_TO_SPLIT = 16;
+    /** Siblings are split into about this many tasks per thread, to balance the load */
+    static const int TASKS_PER_THREAD = 4;
+
+    /** The tasks run on the workers of `jobSystem`, which must outlive the visitor */
+    explicit ParallelVisitor(JobSystem* jobSystem);
+    ~ParallelVisitor();
+
+    /** Visits `root` like root->visit(renderer, parentTransform, parentFlags). Must be called from the main thread */
+    void visit(Node* root, Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
+
+    /** The workers of the JobSystem plus the main thread */
+    unsigned int getThreadCount() const;
+
+    /** Only the children of nodes up to this depth are split into tasks. Defaults to 4 */
+    void setMaxSplitDepth(int depth) { _maxSplitDepth = depth; }
+    int getMaxSplitDepth() const { return _maxSplitDepth; }
+
+    /** Number of tasks visited in parallel in the last visit */
+    ssize_t getLastTaskCount() const { return _tasks.size(); }
+
+    /** true while the main thread looks for the tasks of the visit */
+    bool isSplitting() const { return _splitting; }
+
+    /** Called by Node::visitChild() while splitting: visits the child right away, or adds it to a task */
+    void splitChild(Node* parent, Node* child, uint32_t flags);
+
+protected:
+    struct Task
+    {
+        Node* parent;
+        uint32_t flags;
+        /** range of nodes in _taskNodes */
+        size_t first;
+        size_t count;
+        RenderCommandBuffer* buffer;
+    };
+
+    RenderCommandBuffer* nextBuffer();
+    void runTask(const Task& task);
+
+    Renderer* _renderer;
+    JobSystem* _jobSystem;
+
+    std::vector<Task> _tasks;
+    std::vector<Node*> _taskNodes;
+
+    /** reused from frame to frame, replayed in order */
+    std::vector<RenderCommandBuffer*> _buffers;
+    size_t _usedBuffers;
+    RenderCommandBuffer* _serialBuffer;
+
+    bool _splitting;
+    int _depth;
+    int _maxSplitDepth;
+
+    /** the main thread, then the workers of the JobSystem */
+    std::vector<std::thread::id> _threadIDs;
+};
+
+NS_CC_END
+
+#endif /* __CC_PARALLEL_VISITOR_H__ */
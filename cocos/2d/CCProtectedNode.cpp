@@ -88,11 +88,6 @@ void ProtectedNode::addProtectedChild(Node *child, int zOrder, int tag)
     CCASSERT( child != nullptr, "Argument must be non-nil");
     CCASSERT( child->getParent() == nullptr, "child already added. It can't be added again");
     
-    if (_protectedChildren.empty())
-    {
-        _protectedChildren.reserve(4);
-    }
-    
     this->insertProtectedChild(child, zOrder);
     
     child->setTag(tag);
@@ -255,7 +250,7 @@ void ProtectedNode::insertProtectedChild(cocos2d::Node *child, int z)
 void ProtectedNode::sortAllProtectedChildren()
 {
     if( _reorderProtectedChildDirty ) {
-        std::sort( std::begin(_protectedChildren), std::end(_protectedChildren), nodeComparisonLess );
+        sortNodes(_protectedChildren);
         _reorderProtectedChildDirty = false;
     }
 }
@@ -275,6 +270,11 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
     {
         return;
     }
+
+    if (isCulledBySpatialIndex(parentTransform, parentFlags))
+    {
+        return;
+    }
     
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
     
@@ -283,8 +283,12 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
     // but it is deprecated and your code should not rely on it
     Director* director = Director::getInstance();
     CCASSERT(nullptr != director, "Director is null when seting matrix stack");
-    director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    bool useMatrixStack = isUsingMatrixStack();
+    if (useMatrixStack)
+    {
+        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
     
     int i = 0;      // used by _children
     int j = 0;      // used by _protectedChildren
@@ -333,7 +337,10 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
     // reset for next frame
     _orderOfArrival = 0;
     
-    director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (useMatrixStack)
+    {
+        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    }
 }
 
 void ProtectedNode::onEnter()
@@ -128,6 +128,7 @@ public:
     /// @} end of Children and Parent
     
     virtual void visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags) override;
+    virtual bool isVisitThreadSafe() const override { return false; }
     
     virtual void cleanup() override;
     
@@ -171,7 +172,7 @@ protected:
     /// helper that reorder a child
     void insertProtectedChild(Node* child, int z);
     
-    Vector<Node*> _protectedChildren;        ///< array of children nodes
+    SmallVector<Node*, 4> _protectedChildren;        ///< array of children nodes, widgets rarely have more than 4
     bool _reorderProtectedChildDirty;
     
 private:
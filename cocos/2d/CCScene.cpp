@@ -33,14 +33,16 @@ THE SOFTWARE.
 #include "2d/CCLayer.h"
 #include "2d/CCSprite.h"
 #include "2d/CCSpriteBatchNode.h"
+#include "2d/CCTransformSystem.h"
 #include "physics/CCPhysicsWorld.h"
 #include "deprecated/CCString.h"
 
 NS_CC_BEGIN
 
 Scene::Scene()
+: _transformSystem(nullptr)
 #if CC_USE_PHYSICS
-: _physicsWorld(nullptr)
+, _physicsWorld(nullptr)
 #endif
 {
     _ignoreAnchorPointForPosition = true;
@@ -56,6 +58,7 @@ Scene::Scene()
 
 Scene::~Scene()
 {
+    CC_SAFE_DELETE(_transformSystem);
 #if CC_USE_PHYSICS
     CC_SAFE_DELETE(_physicsWorld);
 #endif
@@ -63,6 +66,18 @@ Scene::~Scene()
     CC_SAFE_RELEASE(_event);
 }
 
+void Scene::setTransformSystemEnabled(bool enabled)
+{
+    if (enabled && !_transformSystem)
+    {
+        _transformSystem = new (std::nothrow) TransformSystem(this);
+    }
+    else if (!enabled)
+    {
+        CC_SAFE_DELETE(_transformSystem);
+    }
+}
+
 bool Scene::init()
 {
     auto size = Director::getInstance()->getWinSize();
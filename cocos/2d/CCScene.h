@@ -67,6 +67,13 @@ public:
     
     /** get all cameras */
     const std::vector<Camera*>& getCameras() const { return _cameras; }
+
+    /** Stores the transforms of the scene graph in contiguous arrays, updated once per frame.
+     Meant for scenes with a lot of nodes, see TransformSystem. Disabled by default.
+     */
+    void setTransformSystemEnabled(bool enabled);
+    bool isTransformSystemEnabled() const { return _transformSystem != nullptr; }
+    TransformSystem* getTransformSystem() const { return _transformSystem; }
     
 CC_CONSTRUCTOR_ACCESS:
     Scene();
@@ -87,6 +94,7 @@ protected:
     std::vector<Camera*> _cameras; //weak ref to Camera
     Camera*              _defaultCamera; //weak ref, default camera created by scene, _cameras[0], Caution that the default camera can not be added to _cameras before onEnter is called
     EventListenerCustom*       _event;
+    TransformSystem*           _transformSystem;
     
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(Scene);
@@ -0,0 +1,379 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/CCSpatialIndex.h"
+
+#include <algorithm>
+#include <float.h>
+#include <string.h>
+
+#include "2d/CCNode.h"
+#include "base/CCCamera.h"
+#include "base/CCDirector.h"
+#include "math/CCAffineTransform.h"
+#include "renderer/CCRenderer.h"
+
+NS_CC_BEGIN
+
+// nodes spanning more cells than this are tested by every query instead
+static const int MAX_CELLS_PER_NODE = 64;
+
+SpatialIndex* SpatialIndex::create(float cellSize)
+{
+    SpatialIndex* ret = new (std::nothrow) SpatialIndex();
+    if (ret && ret->init(cellSize))
+    {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+SpatialIndex::SpatialIndex()
+: _cellSize(0)
+, _viewMargin(0)
+, _queryStamp(0)
+, _culledCount(0)
+, _viewValid(false)
+{
+}
+
+SpatialIndex::~SpatialIndex()
+{
+    removeAllNodes();
+}
+
+bool SpatialIndex::init(float cellSize)
+{
+    CCASSERT(cellSize > 0, "Invalid cell size");
+    _cellSize = cellSize;
+    return true;
+}
+
+void SpatialIndex::addNode(Node* node)
+{
+    CCASSERT(node != nullptr, "Invalid node");
+    CCASSERT(node->_spatialIndex == nullptr, "The node is already in an index");
+
+    Entry entry;
+    entry.node = node;
+    entry.pendingFlags = 0;
+    entry.boundsValid = false;
+    entry.gridDirty = false;
+    entry.inGrid = false;
+    entry.large = false;
+    entry.minX = entry.minY = entry.maxX = entry.maxY = 0;
+    entry.queryStamp = 0;
+
+    node->_spatialIndex = this;
+    node->_spatialSlot = (int)_entries.size();
+    _entries.push_back(entry);
+}
+
+void SpatialIndex::removeNode(Node* node)
+{
+    if (node->_spatialIndex != this)
+        return;
+
+    int slot = node->_spatialSlot;
+    removeFromGrid(_entries[slot]);
+
+    // the last entry takes the place of the removed one
+    if (slot != (int)_entries.size() - 1)
+    {
+        _entries[slot] = _entries.back();
+        _entries[slot].node->_spatialSlot = slot;
+    }
+    _entries.pop_back();
+
+    node->_spatialIndex = nullptr;
+    node->_spatialSlot = -1;
+}
+
+void SpatialIndex::removeAllNodes()
+{
+    for (auto& entry : _entries)
+    {
+        entry.node->_spatialIndex = nullptr;
+        entry.node->_spatialSlot = -1;
+    }
+    _entries.clear();
+    _cells.clear();
+    _largeNodes.clear();
+}
+
+const Rect& SpatialIndex::getBounds(const Node* node) const
+{
+    CCASSERT(node->_spatialIndex == this, "The node is not in this index");
+    return _entries[node->_spatialSlot].bounds;
+}
+
+void SpatialIndex::updateBounds(Entry& entry)
+{
+    const Size& size = entry.node->getContentSize();
+    entry.bounds = RectApplyTransform(Rect(0, 0, size.width, size.height), entry.node->getNodeToWorldTransform());
+    entry.boundsValid = true;
+    entry.gridDirty = true;
+}
+
+void SpatialIndex::update()
+{
+    for (auto& entry : _entries)
+    {
+        updateBounds(entry);
+    }
+}
+
+bool SpatialIndex::cullNode(Node* node, const Mat4& parentTransform, uint32_t& parentFlags)
+{
+    Entry& entry = _entries[node->_spatialSlot];
+    uint32_t flags = parentFlags | entry.pendingFlags;
+
+    // baking or rendering to a texture, the node is not drawn in world space
+    if (!Director::getInstance()->getRenderer()->isCullingEnabled())
+    {
+        entry.pendingFlags = 0;
+        parentFlags = flags;
+        return false;
+    }
+
+    if (!entry.boundsValid || (flags & Node::FLAGS_DIRTY_MASK) || node->_transformUpdated || node->_contentSizeDirty)
+    {
+        const Size& size = node->getContentSize();
+        Mat4 world = parentTransform * node->getNodeToParentTransform();
+        entry.bounds = RectApplyTransform(Rect(0, 0, size.width, size.height), world);
+        entry.boundsValid = true;
+        entry.gridDirty = true;
+    }
+
+    if (entry.bounds.intersectsRect(getViewRect()))
+    {
+        entry.pendingFlags = 0;
+        parentFlags = flags;
+        return false;
+    }
+
+    // the node and its children will need these flags when they are visited again
+    entry.pendingFlags = flags & Node::FLAGS_DIRTY_MASK;
+    ++_culledCount;
+    return true;
+}
+
+Rect SpatialIndex::getViewRect()
+{
+    const Camera* camera = Camera::getVisitingCamera();
+    if (!camera)
+    {
+        Director* director = Director::getInstance();
+        Vec2 origin = director->getVisibleOrigin();
+        Size size = director->getVisibleSize();
+        return Rect(origin.x - _viewMargin, origin.y - _viewMargin, size.width + _viewMargin * 2, size.height + _viewMargin * 2);
+    }
+
+    std::lock_guard<std::mutex> lock(_viewMutex);
+
+    const Mat4& viewProjection = camera->getViewProjectionMatrix();
+    if (_viewValid && memcmp(viewProjection.m, _viewProjection.m, sizeof(_viewProjection.m)) == 0)
+    {
+        return _viewRect;
+    }
+
+    // intersect the rays of the corners of the screen with the plane z = 0
+    Mat4 inverse = viewProjection.getInversed();
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    static const float corners[4][2] = { {-1, -1}, {1, -1}, {1, 1}, {-1, 1} };
+    for (int i = 0; i < 4; ++i)
+    {
+        Vec4 nearPoint(corners[i][0], corners[i][1], -1, 1);
+        Vec4 farPoint(corners[i][0], corners[i][1], 1, 1);
+        inverse.transformVector(&nearPoint);
+        inverse.transformVector(&farPoint);
+        Vec3 n(nearPoint.x / nearPoint.w, nearPoint.y / nearPoint.w, nearPoint.z / nearPoint.w);
+        Vec3 f(farPoint.x / farPoint.w, farPoint.y / farPoint.w, farPoint.z / farPoint.w);
+
+        float t = (n.z != f.z) ? n.z / (n.z - f.z) : 0;
+        t = clampf(t, 0, 1);
+        float x = n.x + (f.x - n.x) * t;
+        float y = n.y + (f.y - n.y) * t;
+
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    _viewProjection = viewProjection;
+    _viewRect.setRect(minX - _viewMargin, minY - _viewMargin, maxX - minX + _viewMargin * 2, maxY - minY + _viewMargin * 2);
+    _viewValid = true;
+    return _viewRect;
+}
+
+void SpatialIndex::insertInGrid(Entry& entry)
+{
+    entry.minX = (int)floorf(entry.bounds.getMinX() / _cellSize);
+    entry.minY = (int)floorf(entry.bounds.getMinY() / _cellSize);
+    entry.maxX = (int)floorf(entry.bounds.getMaxX() / _cellSize);
+    entry.maxY = (int)floorf(entry.bounds.getMaxY() / _cellSize);
+    entry.large = (entry.maxX - entry.minX + 1) * (entry.maxY - entry.minY + 1) > MAX_CELLS_PER_NODE;
+
+    if (entry.large)
+    {
+        _largeNodes.push_back(entry.node);
+    }
+    else
+    {
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+            for (int y = entry.minY; y <= entry.maxY; ++y)
+                _cells[getCellKey(x, y)].push_back(entry.node);
+        }
+    }
+
+    entry.inGrid = true;
+    entry.gridDirty = false;
+}
+
+static void eraseNode(std::vector<Node*>& nodes, Node* node)
+{
+    auto it = std::find(nodes.begin(), nodes.end(), node);
+    if (it != nodes.end())
+    {
+        *it = nodes.back();
+        nodes.pop_back();
+    }
+}
+
+void SpatialIndex::removeFromGrid(Entry& entry)
+{
+    if (!entry.inGrid)
+        return;
+
+    if (entry.large)
+    {
+        eraseNode(_largeNodes, entry.node);
+    }
+    else
+    {
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+            for (int y = entry.minY; y <= entry.maxY; ++y)
+            {
+                auto it = _cells.find(getCellKey(x, y));
+                if (it == _cells.end())
+                    continue;
+
+                eraseNode(it->second, entry.node);
+                if (it->second.empty())
+                    _cells.erase(it);
+            }
+        }
+    }
+
+    entry.inGrid = false;
+}
+
+void SpatialIndex::syncGrid()
+{
+    // only the nodes that moved since the last query change cells
+    for (auto& entry : _entries)
+    {
+        if (!entry.boundsValid)
+            updateBounds(entry);
+
+        if (entry.gridDirty)
+        {
+            removeFromGrid(entry);
+            insertInGrid(entry);
+        }
+    }
+}
+
+void SpatialIndex::query(const Rect& rect, const Vec2* point, std::vector<Node*>* result)
+{
+    syncGrid();
+
+    if (++_queryStamp == 0)
+    {
+        for (auto& entry : _entries)
+            entry.queryStamp = 0;
+        _queryStamp = 1;
+    }
+
+    auto test = [&](Node* node) {
+        Entry& entry = _entries[node->_spatialSlot];
+        if (entry.queryStamp == _queryStamp)
+            return;
+        entry.queryStamp = _queryStamp;
+
+        bool hit = point ? entry.bounds.containsPoint(*point) : entry.bounds.intersectsRect(rect);
+        if (hit && node->isRunning())
+            result->push_back(node);
+    };
+
+    int minX = (int)floorf(rect.getMinX() / _cellSize);
+    int minY = (int)floorf(rect.getMinY() / _cellSize);
+    int maxX = (int)floorf(rect.getMaxX() / _cellSize);
+    int maxY = (int)floorf(rect.getMaxY() / _cellSize);
+
+    // a rectangle covering more cells than there are nodes is faster to test node by node
+    if ((double)(maxX - minX + 1) * (maxY - minY + 1) > _entries.size())
+    {
+        for (auto& entry : _entries)
+            test(entry.node);
+        return;
+    }
+
+    for (int x = minX; x <= maxX; ++x)
+    {
+        for (int y = minY; y <= maxY; ++y)
+        {
+            auto it = _cells.find(getCellKey(x, y));
+            if (it == _cells.end())
+                continue;
+
+            for (auto node : it->second)
+                test(node);
+        }
+    }
+
+    for (auto node : _largeNodes)
+        test(node);
+}
+
+std::vector<Node*> SpatialIndex::queryRect(const Rect& rect)
+{
+    std::vector<Node*> result;
+    query(rect, nullptr, &result);
+    return result;
+}
+
+std::vector<Node*> SpatialIndex::queryPoint(const Vec2& point)
+{
+    std::vector<Node*> result;
+    query(Rect(point.x, point.y, 0, 0), &point, &result);
+    return result;
+}
+
+NS_CC_END
@@ -0,0 +1,167 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CCSPATIALINDEX_H__
+#define __CCSPATIALINDEX_H__
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "base/CCRef.h"
+#include "math/CCGeometry.h"
+#include "math/CCMath.h"
+
+NS_CC_BEGIN
+
+class Node;
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+/** @brief A uniform grid of the world bounding boxes of registered nodes.
+
+ A registered node, and all its children, is skipped by the visit when its bounding box is out of the
+ view of the visiting camera. Its bounding box is its content size transformed to world space: nodes
+ whose children are drawn outside of their content size should be given a larger content size.
+
+ The bounding boxes are updated when the visit finds the transform of the node dirty, so a culled node
+ costs one rectangle test per frame, whatever the size of its subtree. Gameplay code can query the nodes
+ of a region with queryRect() and queryPoint(), which use the bounding boxes of the last visit, or of the
+ last update().
+
+ Only Node, ProtectedNode and Label check the index in their visit(). The index is usually owned by the
+ Layer or Scene of a scrolling world, which keeps a reference to it.
+
+ @code
+ _index = SpatialIndex::create(256);
+ _index->retain();
+ for (auto tile : tiles)
+     _index->addNode(tile);
+ ...
+ auto enemies = _index->queryRect(Rect(x - 100, y - 100, 200, 200));
+ @endcode
+ */
+class CC_DLL SpatialIndex : public Ref
+{
+public:
+    /** Creates an index with square cells of cellSize world units */
+    static SpatialIndex* create(float cellSize);
+
+    /** Registers a node. A node can only be in one index */
+    void addNode(Node* node);
+    /** Unregisters a node. Nodes are unregistered when they are destroyed */
+    void removeNode(Node* node);
+    /** Unregisters all the nodes */
+    void removeAllNodes();
+
+    ssize_t getNodeCount() const { return _entries.size(); }
+    float getCellSize() const { return _cellSize; }
+
+    /** Recomputes the bounding boxes of all the registered nodes, for queries made after nodes moved in the same frame */
+    void update();
+
+    /** The registered nodes in the scene whose bounding box intersects rect */
+    std::vector<Node*> queryRect(const Rect& rect);
+    /** The registered nodes in the scene whose bounding box contains point */
+    std::vector<Node*> queryPoint(const Vec2& point);
+
+    /** The world bounding box of a registered node, as of the last visit */
+    const Rect& getBounds(const Node* node) const;
+
+    /** Margin added around the view before testing the nodes, in world units. 0 by default */
+    void setViewMargin(float margin) { _viewMargin = margin; _viewValid = false; }
+    float getViewMargin() const { return _viewMargin; }
+
+    /** Number of registered nodes culled by the last visits, reset by resetCulledCount() */
+    unsigned int getCulledCount() const { return _culledCount; }
+    void resetCulledCount() { _culledCount = 0; }
+
+    /** Called by the visit of a registered node.
+     @return true if the node is out of the view of the visiting camera and must not be visited.
+     The flags of its parents are kept until the node is visible again.
+     */
+    bool cullNode(Node* node, const Mat4& parentTransform, uint32_t& parentFlags);
+
+CC_CONSTRUCTOR_ACCESS:
+    SpatialIndex();
+    virtual ~SpatialIndex();
+
+    bool init(float cellSize);
+
+protected:
+    struct Entry
+    {
+        Node* node;
+        Rect bounds;
+        uint32_t pendingFlags;
+        bool boundsValid;
+        // the bounds changed since the node was stored in the cells
+        bool gridDirty;
+        // cells the node is stored in
+        bool inGrid;
+        bool large;
+        int minX, minY, maxX, maxY;
+        // last query that returned the node, to return it once when it spans several cells
+        unsigned int queryStamp;
+    };
+
+    void updateBounds(Entry& entry);
+    void syncGrid();
+    void insertInGrid(Entry& entry);
+    void removeFromGrid(Entry& entry);
+    void query(const Rect& rect, const Vec2* point, std::vector<Node*>* result);
+    /** The part of the plane z = 0 seen by the visiting camera */
+    Rect getViewRect();
+
+    static long long getCellKey(int x, int y) { return ((long long)x << 32) | (unsigned int)y; }
+
+    float _cellSize;
+    float _viewMargin;
+    std::vector<Entry> _entries;
+    std::unordered_map<long long, std::vector<Node*>> _cells;
+    // nodes spanning too many cells, tested by every query
+    std::vector<Node*> _largeNodes;
+    unsigned int _queryStamp;
+    std::atomic<unsigned int> _culledCount;
+
+    // the view is computed once per camera and frame. Nodes may be visited from several threads
+    std::mutex _viewMutex;
+    Mat4 _viewProjection;
+    Rect _viewRect;
+    bool _viewValid;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(SpatialIndex);
+};
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCSPATIALINDEX_H__
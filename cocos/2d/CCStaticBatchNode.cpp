@@ -0,0 +1,336 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/CCStaticBatchNode.h"
+
+#include <thread>
+
+#include "base/CCDirector.h"
+#include "math/MathUtil.h"
+#include "platform/CCGLView.h"
+#include "renderer/CCGLProgram.h"
+#include "renderer/CCGLProgramCache.h"
+#include "renderer/CCGLProgramState.h"
+#include "renderer/CCQuadCommand.h"
+#include "renderer/CCRenderCommandBuffer.h"
+#include "renderer/CCRenderer.h"
+#include "renderer/CCTexture2D.h"
+#include "renderer/CCVertexIndexBuffer.h"
+#include "renderer/CCVertexIndexData.h"
+
+NS_CC_BEGIN
+
+StaticBatchNode* StaticBatchNode::create()
+{
+    StaticBatchNode* ret = new (std::nothrow) StaticBatchNode();
+    if (ret && ret->init())
+    {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+StaticBatchNode::StaticBatchNode()
+: _dirty(true)
+, _baked(false)
+, _childrenInBatchSpace(false)
+, _indexBuffer(nullptr)
+, _glProgramState(nullptr)
+{
+}
+
+StaticBatchNode::~StaticBatchNode()
+{
+    releaseBatches();
+    CC_SAFE_RELEASE(_glProgramState);
+}
+
+void StaticBatchNode::markDirtyFor(Node* descendant)
+{
+    for (Node* node = descendant; node; node = node->getParent())
+    {
+        StaticBatchNode* batch = dynamic_cast<StaticBatchNode*>(node);
+        if (batch)
+        {
+            batch->markDirty();
+            return;
+        }
+    }
+}
+
+void StaticBatchNode::releaseBatches()
+{
+    for (auto& batch : _batches)
+    {
+        batch.texture->release();
+    }
+    _batches.clear();
+
+    for (auto& page : _pages)
+    {
+        page.vertexData->release();
+        page.vertexBuffer->release();
+    }
+    _pages.clear();
+
+    CC_SAFE_RELEASE_NULL(_indexBuffer);
+}
+
+void StaticBatchNode::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags)
+{
+    if (!_visible)
+    {
+        return;
+    }
+
+    if (_dirty)
+    {
+        bake(renderer);
+    }
+
+    if (!_baked)
+    {
+        // the children still have the transforms of the bake
+        uint32_t flags = _childrenInBatchSpace ? (parentFlags | FLAGS_DIRTY_MASK) : parentFlags;
+        _childrenInBatchSpace = false;
+        Node::visit(renderer, parentTransform, flags);
+        return;
+    }
+
+    // the children are in the batches, only the transform of this node is needed
+    uint32_t flags = processParentFlags(parentTransform, parentFlags);
+    if (isVisitableByVisitingCamera())
+    {
+        draw(renderer, _modelViewTransform, flags);
+    }
+}
+
+void StaticBatchNode::bake(Renderer* renderer)
+{
+    CCASSERT(!renderer->isRecording(), "StaticBatchNode must be baked on the main thread");
+
+    _dirty = false;
+    releaseBatches();
+
+    // record what the children would draw, relative to this node and without culling
+    RenderCommandBuffer recorded;
+    renderer->beginRecording(std::vector<std::thread::id>(1, std::this_thread::get_id()));
+    renderer->setRecordingBuffer(0, &recorded);
+    bool culling = renderer->isCullingEnabled();
+    renderer->setCullingEnabled(false);
+
+    sortAllChildren();
+    for (auto child : _children)
+    {
+        child->visit(renderer, Mat4::IDENTITY, FLAGS_DIRTY_MASK);
+    }
+
+    renderer->setCullingEnabled(culling);
+    renderer->endRecording();
+    _childrenInBatchSpace = true;
+
+    std::vector<RenderCommand*> commands;
+    _baked = recorded.getCommands(&commands) && bakeCommands(commands);
+    if (!_baked)
+    {
+        CCLOG("cocos2d: StaticBatchNode: the subtree draws more than sprites, it is visited every frame");
+        releaseBatches();
+    }
+}
+
+bool StaticBatchNode::bakeCommands(const std::vector<RenderCommand*>& commands)
+{
+    GLProgram* spriteProgram = GLProgramCache::getInstance()->getGLProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP);
+
+    ssize_t totalQuads = 0;
+    for (auto command : commands)
+    {
+        if (command->getType() != RenderCommand::Type::QUAD_COMMAND)
+        {
+            return false;
+        }
+
+        auto quadCommand = static_cast<QuadCommand*>(command);
+        // the vertices are transformed by the GPU, with the MVP version of the sprite shader
+        if (quadCommand->getMaterialID() == QuadCommand::MATERIAL_ID_DO_NOT_BATCH
+            || quadCommand->getGLProgramState()->getGLProgram() != spriteProgram)
+        {
+            return false;
+        }
+
+        totalQuads += quadCommand->getQuadCount();
+    }
+
+    if (totalQuads == 0)
+    {
+        return true;
+    }
+
+    // the quads, moved to the space of this node, in draw order
+    std::vector<V3F_C4B_T2F_Quad> quads(totalQuads);
+    ssize_t quadIndex = 0;
+    uint32_t lastMaterialID = 0;
+
+    for (auto command : commands)
+    {
+        auto quadCommand = static_cast<QuadCommand*>(command);
+        ssize_t quadCount = quadCommand->getQuadCount();
+        if (quadCount == 0)
+        {
+            continue;
+        }
+
+        std::copy(quadCommand->getQuads(), quadCommand->getQuads() + quadCount, quads.begin() + quadIndex);
+        MathUtil::transformVertices(quadCommand->getModelView().m, &quads[quadIndex], quadCount * 4, sizeof(V3F_C4B_T2F));
+
+        ssize_t end = quadIndex + quadCount;
+        while (quadIndex < end)
+        {
+            int page = (int)(quadIndex / MAX_QUADS_PER_PAGE);
+            int firstQuad = (int)(quadIndex % MAX_QUADS_PER_PAGE);
+            int count = (int)std::min(end - quadIndex, (ssize_t)(MAX_QUADS_PER_PAGE - firstQuad));
+
+            Batch* last = _batches.empty() ? nullptr : &_batches.back();
+            if (last && lastMaterialID == quadCommand->getMaterialID() && last->page == page
+                && last->globalOrder == quadCommand->getGlobalOrder())
+            {
+                last->quadCount += count;
+            }
+            else
+            {
+                Batch batch = { quadCommand->getTexture(), quadCommand->getBlendType(), quadCommand->getGlobalOrder(), page, firstQuad, count };
+                batch.texture->retain();
+                _batches.push_back(batch);
+                lastMaterialID = quadCommand->getMaterialID();
+            }
+
+            quadIndex += count;
+        }
+    }
+
+    // upload once, the buffers are never written again until the next bake
+    int pageCount = (int)((totalQuads + MAX_QUADS_PER_PAGE - 1) / MAX_QUADS_PER_PAGE);
+    for (int i = 0; i < pageCount; ++i)
+    {
+        int firstQuad = i * MAX_QUADS_PER_PAGE;
+        int quadCount = (int)std::min(totalQuads - firstQuad, (ssize_t)MAX_QUADS_PER_PAGE);
+
+        Page page;
+        page.vertexBuffer = VertexBuffer::create(sizeof(V3F_C4B_T2F), quadCount * 4);
+        page.vertexBuffer->retain();
+        page.vertexBuffer->updateVertices(&quads[firstQuad], quadCount * 4, 0);
+
+        page.vertexData = VertexData::create();
+        page.vertexData->retain();
+        page.vertexData->setStream(page.vertexBuffer, VertexStreamAttribute(0, GLProgram::VERTEX_ATTRIB_POSITION, GL_FLOAT, 3));
+        page.vertexData->setStream(page.vertexBuffer, VertexStreamAttribute(offsetof(V3F_C4B_T2F, colors), GLProgram::VERTEX_ATTRIB_COLOR, GL_UNSIGNED_BYTE, 4, true));
+        page.vertexData->setStream(page.vertexBuffer, VertexStreamAttribute(offsetof(V3F_C4B_T2F, texCoords), GLProgram::VERTEX_ATTRIB_TEX_COORD, GL_FLOAT, 2));
+        _pages.push_back(page);
+    }
+
+    int indexedQuads = (int)std::min(totalQuads, (ssize_t)MAX_QUADS_PER_PAGE);
+    std::vector<GLushort> indices(indexedQuads * 6);
+    for (int i = 0; i < indexedQuads; ++i)
+    {
+        indices[i * 6 + 0] = (GLushort)(i * 4 + 0);
+        indices[i * 6 + 1] = (GLushort)(i * 4 + 1);
+        indices[i * 6 + 2] = (GLushort)(i * 4 + 2);
+        indices[i * 6 + 3] = (GLushort)(i * 4 + 3);
+        indices[i * 6 + 4] = (GLushort)(i * 4 + 2);
+        indices[i * 6 + 5] = (GLushort)(i * 4 + 1);
+    }
+    _indexBuffer = IndexBuffer::create(IndexBuffer::IndexType::INDEX_TYPE_SHORT_16, indexedQuads * 6);
+    _indexBuffer->retain();
+    _indexBuffer->updateIndices(indices.data(), indexedQuads * 6, 0);
+
+    if (!_glProgramState)
+    {
+        _glProgramState = GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR);
+        CC_SAFE_RETAIN(_glProgramState);
+    }
+
+    _commands.resize(_batches.size());
+    return true;
+}
+
+void StaticBatchNode::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
+{
+    for (size_t i = 0; i < _batches.size(); ++i)
+    {
+        _commands[i].init(_batches[i].globalOrder);
+        _commands[i].func = CC_CALLBACK_0(StaticBatchNode::onDraw, this, (int)i, transform);
+        renderer->addCommand(&_commands[i]);
+    }
+}
+
+void StaticBatchNode::onDraw(int batchIndex, const Mat4 &transform)
+{
+    const Batch& batch = _batches[batchIndex];
+    GLView* glView = Director::getInstance()->getOpenGLView();
+
+    batch.texture->bind();
+    glView->setBlendFunc(batch.blendFunc);
+    _glProgramState->apply(transform);
+
+    VertexData* vertexData = _pages[batch.page].vertexData;
+    vertexData->use();
+    glView->drawElements(GL_TRIANGLES, (GLsizei)batch.quadCount * 6, _indexBuffer, batch.firstQuad * 6);
+    vertexData->disable();
+
+    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, batch.quadCount * 6);
+}
+
+void StaticBatchNode::addChild(Node *child, int localZOrder, int tag)
+{
+    Node::addChild(child, localZOrder, tag);
+    markDirty();
+}
+
+void StaticBatchNode::addChild(Node *child, int localZOrder, const std::string &name)
+{
+    Node::addChild(child, localZOrder, name);
+    markDirty();
+}
+
+void StaticBatchNode::removeChild(Node *child, bool cleanup)
+{
+    Node::removeChild(child, cleanup);
+    markDirty();
+}
+
+void StaticBatchNode::removeAllChildrenWithCleanup(bool cleanup)
+{
+    Node::removeAllChildrenWithCleanup(cleanup);
+    markDirty();
+}
+
+void StaticBatchNode::reorderChild(Node *child, int localZOrder)
+{
+    Node::reorderChild(child, localZOrder);
+    markDirty();
+}
+
+NS_CC_END
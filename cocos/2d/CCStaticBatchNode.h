@@ -0,0 +1,144 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_STATIC_BATCH_NODE_H__
+#define __CC_STATIC_BATCH_NODE_H__
+
+#include <vector>
+
+#include "2d/CCNode.h"
+#include "renderer/CCCustomCommand.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup sprite_nodes
+ * @{
+ */
+
+class Texture2D;
+class GLProgramState;
+class VertexBuffer;
+class IndexBuffer;
+class VertexData;
+
+/** StaticBatchNode draws a subtree that doesn't change from buffers kept on the GPU.
+
+ The first time it is visited, and every time it is marked dirty, the quads of its descendants are
+ baked into vertex buffers, in the space of the StaticBatchNode. The other frames the descendants are
+ neither visited nor transformed, and nothing is uploaded: the node adds one command per run of quads
+ that share a material, in the order the quads were drawn. The StaticBatchNode itself can move, rotate
+ or scale freely, its transform is applied by the GPU.
+
+ Changes made inside the subtree are not seen until markDirty() is called: moving, recoloring or
+ animating a descendant, changing its texture or frame. Adding, removing and reordering the direct
+ children marks the node dirty automatically.
+
+ Only the sprite-like nodes using the default shader (QuadCommands with
+ GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP) can be baked. If the subtree draws anything else,
+ eg: labels with effects, particles, DrawNodes, ClippingNodes or another StaticBatchNode, the
+ StaticBatchNode logs it and visits its children normally until it is marked dirty again.
+ */
+class CC_DLL StaticBatchNode : public Node
+{
+public:
+    static StaticBatchNode* create();
+
+    /** Bakes the subtree again the next time it is visited */
+    void markDirty() { _dirty = true; }
+    bool isDirty() const { return _dirty; }
+
+    /** Marks the StaticBatchNode that contains a node, if any, dirty. Convenient for nodes deep in the subtree */
+    static void markDirtyFor(Node* descendant);
+
+    /** Whether the subtree is drawn from the baked buffers, false when it contains nodes that can't be baked */
+    bool isBaked() const { return _baked; }
+
+    /** Number of commands the baked subtree is drawn with */
+    ssize_t getBatchCount() const { return _batches.size(); }
+
+    // Overrides
+    virtual void visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags) override;
+    virtual void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags) override;
+    /** Baking records the children on the main thread, a baked node can be visited from any thread */
+    virtual bool isVisitThreadSafe() const override { return !_dirty; }
+
+    using Node::addChild;
+    virtual void addChild(Node *child, int localZOrder, int tag) override;
+    virtual void addChild(Node *child, int localZOrder, const std::string &name) override;
+    virtual void removeChild(Node *child, bool cleanup = true) override;
+    virtual void removeAllChildrenWithCleanup(bool cleanup) override;
+    virtual void reorderChild(Node *child, int localZOrder) override;
+
+CC_CONSTRUCTOR_ACCESS:
+    StaticBatchNode();
+    virtual ~StaticBatchNode();
+
+protected:
+    /** Quads of a same material and global order, drawn with one command */
+    struct Batch
+    {
+        Texture2D* texture;
+        BlendFunc blendFunc;
+        float globalOrder;
+        int page;
+        int firstQuad;
+        int quadCount;
+    };
+
+    /** Indices are 16 bits, the quads are split into buffers of at most MAX_QUADS_PER_PAGE quads */
+    struct Page
+    {
+        VertexBuffer* vertexBuffer;
+        VertexData* vertexData;
+    };
+
+    static const int MAX_QUADS_PER_PAGE = 65536 / 4;
+
+    void bake(Renderer* renderer);
+    bool bakeCommands(const std::vector<RenderCommand*>& commands);
+    void releaseBatches();
+    void onDraw(int batch, const Mat4 &transform);
+
+    bool _dirty;
+    bool _baked;
+    // the transforms of the children are relative to this node after a bake
+    bool _childrenInBatchSpace;
+
+    std::vector<Batch> _batches;
+    std::vector<Page> _pages;
+    std::vector<CustomCommand> _commands;
+    IndexBuffer* _indexBuffer;
+    GLProgramState* _glProgramState;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(StaticBatchNode);
+};
+
+// end of sprite_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CC_STATIC_BATCH_NODE_H__
@@ -0,0 +1,304 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/CCTransformSystem.h"
+
+#include "2d/CCNode.h"
+
+NS_CC_BEGIN
+
+TransformSystem::TransformSystem(Node* root)
+: _root(root)
+, _orderDirty(true)
+, _lastUpdateCount(0)
+{
+    addNode(root);
+}
+
+TransformSystem::~TransformSystem()
+{
+    removeNode(_root);
+}
+
+void TransformSystem::addNode(Node* node)
+{
+    std::vector<Node*> stack(1, node);
+    while (!stack.empty())
+    {
+        Node* n = stack.back();
+        stack.pop_back();
+
+        // nodes computing their own transform stay on the Node path, with their subtree
+        if (!n->isTransformSystemSupported())
+            continue;
+
+        n->_transformSystem = this;
+        n->_transformSlot = -1;
+        for (auto child : n->_children)
+            stack.push_back(child);
+    }
+
+    _orderDirty = true;
+}
+
+void TransformSystem::removeNode(Node* node)
+{
+    std::vector<Node*> stack(1, node);
+    while (!stack.empty())
+    {
+        Node* n = stack.back();
+        stack.pop_back();
+
+        if (n->_transformSystem != this)
+            continue;
+
+        if (n->_transformSlot >= 0)
+            _nodes[n->_transformSlot] = nullptr;
+        n->_transformSystem = nullptr;
+        n->_transformSlot = -1;
+        for (auto child : n->_children)
+            stack.push_back(child);
+    }
+
+    _orderDirty = true;
+}
+
+bool TransformSystem::isWorldValid(int slot) const
+{
+    if (slot < 0 || _orderDirty)
+        return false;
+
+    for (int s = slot; s >= 0; s = _parents[s])
+    {
+        if (_flags[s] & FLAG_PENDING)
+            return false;
+    }
+    return true;
+}
+
+void TransformSystem::rebuild()
+{
+    _nodes.clear();
+    _parents.clear();
+
+    // depth first, so that every parent comes before its children
+    std::vector<std::pair<Node*, int>> stack(1, std::make_pair(_root, -1));
+    while (!stack.empty())
+    {
+        auto top = stack.back();
+        stack.pop_back();
+
+        Node* n = top.first;
+        if (n->_transformSystem != this)
+            continue;
+
+        int slot = (int)_nodes.size();
+        n->_transformSlot = slot;
+        _nodes.push_back(n);
+        _parents.push_back(top.second);
+
+        for (auto it = n->_children.crbegin(); it != n->_children.crend(); ++it)
+            stack.push_back(std::make_pair(*it, slot));
+    }
+
+    size_t count = _nodes.size();
+    _flags.assign(count, FLAG_PENDING);
+    _positionX.resize(count);
+    _positionY.resize(count);
+    _positionZ.resize(count);
+    _rotationX.resize(count);
+    _rotationY.resize(count);
+    _scaleX.resize(count);
+    _scaleY.resize(count);
+    _scaleZ.resize(count);
+    _skewX.resize(count);
+    _skewY.resize(count);
+    _anchorX.resize(count);
+    _anchorY.resize(count);
+    _local.resize(count);
+    _world.resize(count);
+
+    _orderDirty = false;
+}
+
+void TransformSystem::update()
+{
+    if (_orderDirty)
+        rebuild();
+
+    int count = (int)_nodes.size();
+    int first = count;
+    _lastUpdateCount = 0;
+
+    // the flags are contiguous, finding the changed nodes doesn't touch the others
+    for (int i = 0; i < count; ++i)
+    {
+        if (_flags[i] & FLAG_PENDING)
+        {
+            if (first == count)
+                first = i;
+            gather(i);
+        }
+    }
+
+    if (first == count)
+        return;
+
+    computeLocals(first, count);
+    computeWorlds(first, count);
+
+    for (int i = first; i < count; ++i)
+    {
+        // the node reads its own cache from now on, as if it had computed the matrix
+        if (_flags[i] & FLAG_COMPUTE_LOCAL)
+        {
+            Node* node = _nodes[i];
+            node->_transform = _local[i];
+            node->_transformDirty = false;
+        }
+        _flags[i] = 0;
+    }
+}
+
+void TransformSystem::gather(int slot)
+{
+    Node* node = _nodes[slot];
+
+    // the transform has been set or computed by the node, or it needs the general case
+    if (!node->_transformDirty || node->_rotationX || node->_rotationY || node->_useAdditionalTransform)
+    {
+        _local[slot] = node->getNodeToParentTransform();
+        return;
+    }
+
+    float x = node->_position.x;
+    float y = node->_position.y;
+    if (node->_ignoreAnchorPointForPosition)
+    {
+        x += node->_anchorPointInPoints.x;
+        y += node->_anchorPointInPoints.y;
+    }
+
+    _positionX[slot] = x;
+    _positionY[slot] = y;
+    _positionZ[slot] = node->_positionZ;
+    _rotationX[slot] = node->_rotationZ_X;
+    _rotationY[slot] = node->_rotationZ_Y;
+    _scaleX[slot] = node->_scaleX;
+    _scaleY[slot] = node->_scaleY;
+    _scaleZ[slot] = node->_scaleZ;
+    _skewX[slot] = node->_skewX;
+    _skewY[slot] = node->_skewY;
+    _anchorX[slot] = node->_anchorPointInPoints.x;
+    _anchorY[slot] = node->_anchorPointInPoints.y;
+    _flags[slot] |= FLAG_COMPUTE_LOCAL;
+}
+
+void TransformSystem::computeLocals(int first, int last)
+{
+    // same as Node::getNodeToParentTransform() without the 3D rotations, where the anchor point translations cancel out
+    for (int i = first; i < last; ++i)
+    {
+        if (!(_flags[i] & FLAG_COMPUTE_LOCAL))
+            continue;
+
+        float radiansX = -CC_DEGREES_TO_RADIANS(_rotationX[i]);
+        float radiansY = -CC_DEGREES_TO_RADIANS(_rotationY[i]);
+        float cx = cosf(radiansX);
+        float sx = sinf(radiansX);
+        float cy = cosf(radiansY);
+        float sy = sinf(radiansY);
+
+        float x = _positionX[i];
+        float y = _positionY[i];
+        float ax = _anchorX[i];
+        float ay = _anchorY[i];
+        bool needsSkewMatrix = (_skewX[i] || _skewY[i]);
+
+        if (!needsSkewMatrix)
+        {
+            float sax = ax * _scaleX[i];
+            float say = ay * _scaleY[i];
+            x += cy * -sax + -sx * -say;
+            y += sy * -sax +  cx * -say;
+        }
+
+        float* m = _local[i].m;
+        m[0] = cy * _scaleX[i];
+        m[1] = sy * _scaleX[i];
+        m[2] = 0;
+        m[3] = 0;
+        m[4] = -sx * _scaleY[i];
+        m[5] = cx * _scaleY[i];
+        m[6] = 0;
+        m[7] = 0;
+        m[8] = 0;
+        m[9] = 0;
+        m[10] = _scaleZ[i];
+        m[11] = 0;
+        m[12] = x;
+        m[13] = y;
+        m[14] = _positionZ[i];
+        m[15] = 1;
+
+        if (needsSkewMatrix)
+        {
+            float tanX = tanf(CC_DEGREES_TO_RADIANS(_skewX[i]));
+            float tanY = tanf(CC_DEGREES_TO_RADIANS(_skewY[i]));
+
+            // m * skew, the skew matrix only mixes the two first columns
+            float m0 = m[0], m1 = m[1], m4 = m[4], m5 = m[5];
+            m[0] = m0 + m4 * tanX;
+            m[1] = m1 + m5 * tanX;
+            m[4] = m0 * tanY + m4;
+            m[5] = m1 * tanY + m5;
+
+            m[12] += m[0] * -ax + m[4] * -ay;
+            m[13] += m[1] * -ax + m[5] * -ay;
+        }
+
+        ++_lastUpdateCount;
+    }
+}
+
+void TransformSystem::computeWorlds(int first, int last)
+{
+    // the parents come first, their world matrix is final when their children are reached
+    for (int i = first; i < last; ++i)
+    {
+        int parent = _parents[i];
+        bool parentChanged = parent >= 0 && (_flags[parent] & FLAG_WORLD_CHANGED);
+        if (!(_flags[i] & FLAG_PENDING) && !parentChanged)
+            continue;
+
+        if (parent < 0)
+            _world[i] = _local[i];
+        else
+            Mat4::multiply(_world[parent], _local[i], &_world[i]);
+
+        _flags[i] |= FLAG_WORLD_CHANGED;
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,151 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CCTRANSFORMSYSTEM_H__
+#define __CCTRANSFORMSYSTEM_H__
+
+#include <vector>
+
+#include "base/ccMacros.h"
+#include "math/CCMath.h"
+
+NS_CC_BEGIN
+
+class Node;
+
+/**
+ * @addtogroup base_nodes
+ * @{
+ */
+
+/** @brief Keeps the transforms of a scene graph in contiguous arrays.
+
+ The nodes of the tree are stored in parent-before-child order. Their position, rotation, scale, skew and
+ anchor point, their local matrices and their world matrices live in one array each, indexed by the slot of
+ the node.
+
+ Once per frame, update() copies the parameters of the nodes that changed since the last frame, then
+ computes their local matrices and the world matrices of the changed subtrees in linear passes over the
+ arrays. Until the next change, Node::getNodeToParentTransform() and Node::getNodeToWorldTransform()
+ read those arrays instead of walking the tree.
+
+ Nodes with a 3D rotation, an additional transform or a transform set with setNodeToParentTransform()
+ are computed by Node, and only their result is stored. Nodes returning false from
+ Node::isTransformSystemSupported(), and their descendants, are not registered at all.
+
+ A TransformSystem is owned by a Scene, see Scene::setTransformSystemEnabled().
+ */
+class CC_DLL TransformSystem
+{
+public:
+    /** Registers root and all its descendants */
+    explicit TransformSystem(Node* root);
+    ~TransformSystem();
+
+    /** Brings the local and world matrices of the changed nodes up to date. Called by the Director before the scene is visited */
+    void update();
+
+    /** Number of registered nodes, valid after update() */
+    ssize_t getNodeCount() const { return _nodes.size(); }
+
+    /** Number of local matrices computed by the last update() */
+    ssize_t getLastUpdateCount() const { return _lastUpdateCount; }
+
+    /** Flags the transform of the node in a slot as changed. Nodes call it from any thread, it only writes the flag of the slot */
+    void markDirty(int slot)
+    {
+        if (slot >= 0)
+            _flags[slot] |= FLAG_PENDING;
+    }
+
+    /** Registers a node and its descendants, the slots are assigned by the next update() */
+    void addNode(Node* node);
+    /** Unregisters a node and its descendants */
+    void removeNode(Node* node);
+
+    /** Whether the local matrix of the slot reflects the current state of its node */
+    bool isLocalValid(int slot) const
+    {
+        return slot >= 0 && !_orderDirty && !(_flags[slot] & FLAG_PENDING);
+    }
+    const Mat4& getLocal(int slot) const { return _local[slot]; }
+
+    /** Whether the world matrix of the slot reflects the current state of its node and its ancestors */
+    bool isWorldValid(int slot) const;
+    const Mat4& getWorld(int slot) const { return _world[slot]; }
+
+protected:
+    enum
+    {
+        // the node changed since the last update
+        FLAG_PENDING = 1 << 0,
+        // the local matrix has to be computed from the parameters of the slot
+        FLAG_COMPUTE_LOCAL = 1 << 1,
+        // the world matrix was computed by the current update
+        FLAG_WORLD_CHANGED = 1 << 2,
+    };
+
+    /** Assigns the slots in depth first order */
+    void rebuild();
+    /** Copies the transform parameters of a changed node */
+    void gather(int slot);
+    /** Computes the local matrices of the slots in [first, last) flagged with FLAG_COMPUTE_LOCAL */
+    void computeLocals(int first, int last);
+    /** Concatenates the world matrices of the slots in [first, last) which, or whose parent, changed */
+    void computeWorlds(int first, int last);
+
+    Node* _root;
+    bool _orderDirty;
+    ssize_t _lastUpdateCount;
+
+    std::vector<Node*> _nodes;
+    std::vector<int> _parents;
+    std::vector<unsigned char> _flags;
+
+    std::vector<float> _positionX;
+    std::vector<float> _positionY;
+    std::vector<float> _positionZ;
+    std::vector<float> _rotationX;
+    std::vector<float> _rotationY;
+    std::vector<float> _scaleX;
+    std::vector<float> _scaleY;
+    std::vector<float> _scaleZ;
+    std::vector<float> _skewX;
+    std::vector<float> _skewY;
+    std::vector<float> _anchorX;
+    std::vector<float> _anchorY;
+
+    std::vector<Mat4> _local;
+    std::vector<Mat4> _world;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(TransformSystem);
+};
+
+// end of base_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CCTRANSFORMSYSTEM_H__
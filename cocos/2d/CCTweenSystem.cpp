@@ -0,0 +1,415 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "2d/CCTweenSystem.h"
+
+#include <float.h>
+#include <typeinfo>
+
+#include "2d/CCActionInterval.h"
+#include "2d/CCActionEase.h"
+#include "2d/CCTweenFunction.h"
+#include "2d/CCNode.h"
+
+NS_CC_BEGIN
+
+namespace
+{
+    struct KindEntry
+    {
+        const std::type_info& type;
+        int kind;
+    };
+
+    // MOVE, SCALE, FADE, ROTATE
+    const KindEntry s_kinds[] = {
+        { typeid(MoveBy), 0 },
+        { typeid(MoveTo), 0 },
+        { typeid(ScaleTo), 1 },
+        { typeid(ScaleBy), 1 },
+        { typeid(FadeTo), 2 },
+        { typeid(FadeIn), 2 },
+        { typeid(FadeOut), 2 },
+        { typeid(RotateTo), 3 },
+    };
+
+    struct EasingEntry
+    {
+        const std::type_info& type;
+        int easing;
+    };
+
+    // in the order of TweenSystem::Easing, LINEAR excepted
+    const EasingEntry s_easings[] = {
+        { typeid(EaseIn), 1 },
+        { typeid(EaseOut), 2 },
+        { typeid(EaseInOut), 3 },
+        { typeid(EaseExponentialIn), 4 },
+        { typeid(EaseExponentialOut), 5 },
+        { typeid(EaseExponentialInOut), 6 },
+        { typeid(EaseSineIn), 7 },
+        { typeid(EaseSineOut), 8 },
+        { typeid(EaseSineInOut), 9 },
+        { typeid(EaseElasticIn), 10 },
+        { typeid(EaseElasticOut), 11 },
+        { typeid(EaseElasticInOut), 12 },
+        { typeid(EaseBounceIn), 13 },
+        { typeid(EaseBounceOut), 14 },
+        { typeid(EaseBounceInOut), 15 },
+        { typeid(EaseBackIn), 16 },
+        { typeid(EaseBackOut), 17 },
+        { typeid(EaseBackInOut), 18 },
+        { typeid(EaseQuadraticActionIn), 19 },
+        { typeid(EaseQuadraticActionOut), 20 },
+        { typeid(EaseQuadraticActionInOut), 21 },
+        { typeid(EaseQuarticActionIn), 22 },
+        { typeid(EaseQuarticActionOut), 23 },
+        { typeid(EaseQuarticActionInOut), 24 },
+        { typeid(EaseQuinticActionIn), 25 },
+        { typeid(EaseQuinticActionOut), 26 },
+        { typeid(EaseQuinticActionInOut), 27 },
+        { typeid(EaseCircleActionIn), 28 },
+        { typeid(EaseCircleActionOut), 29 },
+        { typeid(EaseCircleActionInOut), 30 },
+        { typeid(EaseCubicActionIn), 31 },
+        { typeid(EaseCubicActionOut), 32 },
+        { typeid(EaseCubicActionInOut), 33 },
+    };
+
+    // Only the exact classes are batched: a subclass may override update()
+    int findKind(const Action* action)
+    {
+        const std::type_info& type = typeid(*action);
+        for (const auto& entry : s_kinds)
+        {
+            if (entry.type == type)
+                return entry.kind;
+        }
+        return -1;
+    }
+}
+
+TweenSystem::TweenSystem()
+: _removedCount(0)
+, _updating(false)
+{
+}
+
+TweenSystem::~TweenSystem()
+{
+    for (auto& tween : _tweens)
+    {
+        if (tween.action)
+            tween.action->_tweenSlot = -1;
+    }
+    for (auto& tween : _added)
+    {
+        if (tween.action)
+            tween.action->_tweenSlot = -1;
+    }
+}
+
+bool TweenSystem::findEasing(const Action* action, Easing* easing, float* param)
+{
+    const std::type_info& type = typeid(*action);
+    for (const auto& entry : s_easings)
+    {
+        if (entry.type == type)
+        {
+            *easing = (Easing)entry.easing;
+            if (*easing <= Easing::RATE_IN_OUT)
+                *param = static_cast<const EaseRateAction*>(action)->getRate();
+            else if (*easing >= Easing::ELASTIC_IN && *easing <= Easing::ELASTIC_IN_OUT)
+                *param = static_cast<const EaseElastic*>(action)->getPeriod();
+            else
+                *param = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TweenSystem::canBatch(const Action* action)
+{
+    Easing easing;
+    float param;
+    if (findEasing(action, &easing, &param))
+        action = static_cast<const ActionEase*>(action)->_inner;
+
+    return findKind(action) >= 0;
+}
+
+bool TweenSystem::isBatched(const Action* action)
+{
+    return action->_tweenSlot >= 0;
+}
+
+void TweenSystem::add(ActionInterval* action, const bool* paused)
+{
+    CCASSERT(action->_tweenSlot < 0, "TweenSystem: the action is already batched");
+
+    Tween tween;
+    tween.action = action;
+    tween.target = action->getTarget();
+    tween.paused = paused;
+    tween.easing = Easing::LINEAR;
+    tween.easingParam = 0;
+    tween.duration = action->_duration;
+    tween.elapsed = action->_elapsed;
+    tween.firstTick = action->_firstTick;
+
+    ActionInterval* inner = action;
+    if (findEasing(action, &tween.easing, &tween.easingParam))
+        inner = static_cast<ActionEase*>(action)->_inner;
+
+    switch (findKind(inner))
+    {
+        case 0:
+        {
+            auto move = static_cast<MoveBy*>(inner);
+            tween.kind = Kind::MOVE;
+            tween.from.set(move->_startPosition.x, move->_startPosition.y, 0);
+            tween.delta.set(move->_positionDelta.x, move->_positionDelta.y, 0);
+            tween.previous = move->_previousPosition;
+            break;
+        }
+        case 1:
+        {
+            auto scale = static_cast<ScaleTo*>(inner);
+            tween.kind = Kind::SCALE;
+            tween.from.set(scale->_startScaleX, scale->_startScaleY, scale->_startScaleZ);
+            tween.delta.set(scale->_deltaX, scale->_deltaY, scale->_deltaZ);
+            break;
+        }
+        case 2:
+        {
+            auto fade = static_cast<FadeTo*>(inner);
+            tween.kind = Kind::FADE;
+            tween.from.set(fade->_fromOpacity, 0, 0);
+            tween.delta.set(fade->_toOpacity - fade->_fromOpacity, 0, 0);
+            break;
+        }
+        case 3:
+        {
+            auto rotate = static_cast<RotateTo*>(inner);
+            tween.kind = rotate->_is3D ? Kind::ROTATE_3D : Kind::ROTATE;
+            tween.from = rotate->_startAngle;
+            tween.delta = rotate->_diffAngle;
+            break;
+        }
+        default:
+            CCASSERT(false, "TweenSystem: the action can't be batched");
+            return;
+    }
+
+    // records added while updating are appended once the loop is over, their slots follow the current ones
+    if (_updating)
+    {
+        action->_tweenSlot = _tweens.size() + _added.size();
+        _added.push_back(tween);
+    }
+    else
+    {
+        action->_tweenSlot = _tweens.size();
+        _tweens.push_back(tween);
+    }
+}
+
+void TweenSystem::remove(Action* action)
+{
+    ssize_t slot = action->_tweenSlot;
+    if (slot < 0)
+        return;
+
+    action->_tweenSlot = -1;
+
+    if (_updating)
+    {
+        if (slot < (ssize_t)_tweens.size())
+            _tweens[slot].action = nullptr;
+        else
+            _added[slot - _tweens.size()].action = nullptr;
+        ++_removedCount;
+        return;
+    }
+
+    if (slot != (ssize_t)_tweens.size() - 1)
+    {
+        _tweens[slot] = _tweens.back();
+        _tweens[slot].action->_tweenSlot = slot;
+    }
+    _tweens.pop_back();
+}
+
+void TweenSystem::compact()
+{
+    ssize_t count = 0;
+    for (auto& tween : _tweens)
+    {
+        if (tween.action)
+        {
+            tween.action->_tweenSlot = count;
+            _tweens[count++] = tween;
+        }
+    }
+    _tweens.resize(count);
+    _removedCount = 0;
+}
+
+float TweenSystem::ease(Easing easing, float param, float time)
+{
+    switch (easing)
+    {
+        case Easing::LINEAR:                return time;
+        case Easing::RATE_IN:               return tweenfunc::easeIn(time, param);
+        case Easing::RATE_OUT:              return tweenfunc::easeOut(time, param);
+        case Easing::RATE_IN_OUT:           return tweenfunc::easeInOut(time, param);
+        case Easing::EXPONENTIAL_IN:        return tweenfunc::expoEaseIn(time);
+        case Easing::EXPONENTIAL_OUT:       return tweenfunc::expoEaseOut(time);
+        case Easing::EXPONENTIAL_IN_OUT:    return tweenfunc::expoEaseInOut(time);
+        case Easing::SINE_IN:               return tweenfunc::sineEaseIn(time);
+        case Easing::SINE_OUT:              return tweenfunc::sineEaseOut(time);
+        case Easing::SINE_IN_OUT:           return tweenfunc::sineEaseInOut(time);
+        case Easing::ELASTIC_IN:            return tweenfunc::elasticEaseIn(time, param);
+        case Easing::ELASTIC_OUT:           return tweenfunc::elasticEaseOut(time, param);
+        case Easing::ELASTIC_IN_OUT:        return tweenfunc::elasticEaseInOut(time, param);
+        case Easing::BOUNCE_IN:             return tweenfunc::bounceEaseIn(time);
+        case Easing::BOUNCE_OUT:            return tweenfunc::bounceEaseOut(time);
+        case Easing::BOUNCE_IN_OUT:         return tweenfunc::bounceEaseInOut(time);
+        case Easing::BACK_IN:               return tweenfunc::backEaseIn(time);
+        case Easing::BACK_OUT:              return tweenfunc::backEaseOut(time);
+        case Easing::BACK_IN_OUT:           return tweenfunc::backEaseInOut(time);
+        case Easing::QUADRATIC_IN:          return tweenfunc::quadraticIn(time);
+        case Easing::QUADRATIC_OUT:         return tweenfunc::quadraticOut(time);
+        case Easing::QUADRATIC_IN_OUT:      return tweenfunc::quadraticInOut(time);
+        case Easing::QUARTIC_IN:            return tweenfunc::quartEaseIn(time);
+        case Easing::QUARTIC_OUT:           return tweenfunc::quartEaseOut(time);
+        case Easing::QUARTIC_IN_OUT:        return tweenfunc::quartEaseInOut(time);
+        case Easing::QUINTIC_IN:            return tweenfunc::quintEaseIn(time);
+        case Easing::QUINTIC_OUT:           return tweenfunc::quintEaseOut(time);
+        case Easing::QUINTIC_IN_OUT:        return tweenfunc::quintEaseInOut(time);
+        case Easing::CIRCLE_IN:             return tweenfunc::circEaseIn(time);
+        case Easing::CIRCLE_OUT:            return tweenfunc::circEaseOut(time);
+        case Easing::CIRCLE_IN_OUT:         return tweenfunc::circEaseInOut(time);
+        case Easing::CUBIC_IN:              return tweenfunc::cubicEaseIn(time);
+        case Easing::CUBIC_OUT:             return tweenfunc::cubicEaseOut(time);
+        case Easing::CUBIC_IN_OUT:          return tweenfunc::cubicEaseInOut(time);
+    }
+    return time;
+}
+
+// Same arithmetic as the update() of the batched actions
+void TweenSystem::apply(Tween& tween, float time)
+{
+    Node* target = tween.target;
+    switch (tween.kind)
+    {
+        case Kind::MOVE:
+        {
+#if CC_ENABLE_STACKABLE_ACTIONS
+            Vec2 currentPos = target->getPosition();
+            tween.from.x += currentPos.x - tween.previous.x;
+            tween.from.y += currentPos.y - tween.previous.y;
+            Vec2 newPos(tween.from.x + tween.delta.x * time, tween.from.y + tween.delta.y * time);
+            tween.previous = newPos;
+            target->setPosition(newPos);
+#else
+            target->setPosition(Vec2(tween.from.x + tween.delta.x * time, tween.from.y + tween.delta.y * time));
+#endif // CC_ENABLE_STACKABLE_ACTIONS
+            break;
+        }
+        case Kind::SCALE:
+            target->setScaleX(tween.from.x + tween.delta.x * time);
+            target->setScaleY(tween.from.y + tween.delta.y * time);
+            target->setScaleZ(tween.from.z + tween.delta.z * time);
+            break;
+        case Kind::FADE:
+            target->setOpacity((GLubyte)(tween.from.x + tween.delta.x * time));
+            break;
+        case Kind::ROTATE:
+#if CC_USE_PHYSICS
+            if (tween.from.x == tween.from.y && tween.delta.x == tween.delta.y)
+            {
+                target->setRotation(tween.from.x + tween.delta.x * time);
+                break;
+            }
+#endif // CC_USE_PHYSICS
+            target->setRotationSkewX(tween.from.x + tween.delta.x * time);
+            target->setRotationSkewY(tween.from.y + tween.delta.y * time);
+            break;
+        case Kind::ROTATE_3D:
+            target->setRotation3D(tween.from + tween.delta * time);
+            break;
+    }
+}
+
+void TweenSystem::update(float dt, std::vector<Action*>& finished)
+{
+    _updating = true;
+
+    // The setters of the targets may add or remove actions: removed records are cleared in place and added
+    // records are kept aside, so the array is neither reordered nor reallocated by the loop.
+    for (auto& tween : _tweens)
+    {
+        if (tween.action == nullptr || *tween.paused)
+            continue;
+
+        // ActionInterval::step()
+        if (tween.firstTick)
+        {
+            tween.firstTick = false;
+            tween.elapsed = 0;
+        }
+        else
+        {
+            tween.elapsed += dt;
+        }
+        tween.action->_firstTick = false;
+        tween.action->_elapsed = tween.elapsed;
+
+        float time = MAX(0, MIN(1, tween.elapsed / MAX(tween.duration, FLT_EPSILON)));
+        apply(tween, ease(tween.easing, tween.easingParam, time));
+
+        if (tween.action && tween.elapsed >= tween.duration)
+        {
+            tween.action->retain();
+            finished.push_back(tween.action);
+        }
+    }
+
+    _updating = false;
+
+    if (!_added.empty())
+    {
+        _tweens.insert(_tweens.end(), _added.begin(), _added.end());
+        _added.clear();
+    }
+    if (_removedCount > 0)
+    {
+        compact();
+    }
+}
+
+NS_CC_END
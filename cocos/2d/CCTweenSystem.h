@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CCTWEENSYSTEM_H__
+#define __CCTWEENSYSTEM_H__
+
+#include <vector>
+
+#include "base/ccMacros.h"
+#include "math/CCMath.h"
+
+NS_CC_BEGIN
+
+class Node;
+class Action;
+class ActionInterval;
+
+/**
+ * @addtogroup actions
+ * @{
+ */
+
+/** @brief Advances the simple interval actions of an ActionManager from one contiguous array.
+
+ MoveBy, MoveTo, ScaleTo, ScaleBy, FadeTo, FadeIn, FadeOut and RotateTo, used directly or wrapped in one of
+ the easing actions built on a tweenfunc curve, are copied into a plain record when they start. update()
+ advances all the records in one loop: it computes the eased time and sets the property of the target without
+ calling Action::step() or Action::update().
+
+ The action stays the handle of the tween. getElapsed() and isDone() keep working, removing the action
+ removes its record and the action is stopped and removed from its ActionManager when the tween ends.
+ Subclasses of those actions and every other action are stepped by the ActionManager as before.
+
+ A TweenSystem is owned by an ActionManager, see ActionManager::setTweenBatchingEnabled().
+ */
+class CC_DLL TweenSystem
+{
+public:
+    TweenSystem();
+    ~TweenSystem();
+
+    /** Whether the action and its inner action can be advanced by a TweenSystem */
+    static bool canBatch(const Action* action);
+
+    /** Copies a started action into a record. The action must pass canBatch().
+     @param paused The flag telling whether the target of the action is paused. It has to outlive the record.
+     */
+    void add(ActionInterval* action, const bool* paused);
+    /** Removes the record of an action. Records removed during update() are only released once it returns */
+    void remove(Action* action);
+
+    /** Whether the action is advanced by a TweenSystem */
+    static bool isBatched(const Action* action);
+
+    /** Advances the records of the targets which are not paused.
+     The actions whose tween ended are appended to finished, retained. The caller stops, removes and releases them.
+     */
+    void update(float dt, std::vector<Action*>& finished);
+
+    /** Number of records */
+    ssize_t getTweenCount() const { return _tweens.size() + _added.size() - _removedCount; }
+
+protected:
+    enum class Kind : unsigned char
+    {
+        MOVE,
+        SCALE,
+        FADE,
+        ROTATE,
+        ROTATE_3D,
+    };
+
+    enum class Easing : unsigned char
+    {
+        LINEAR,
+        RATE_IN,
+        RATE_OUT,
+        RATE_IN_OUT,
+        EXPONENTIAL_IN,
+        EXPONENTIAL_OUT,
+        EXPONENTIAL_IN_OUT,
+        SINE_IN,
+        SINE_OUT,
+        SINE_IN_OUT,
+        ELASTIC_IN,
+        ELASTIC_OUT,
+        ELASTIC_IN_OUT,
+        BOUNCE_IN,
+        BOUNCE_OUT,
+        BOUNCE_IN_OUT,
+        BACK_IN,
+        BACK_OUT,
+        BACK_IN_OUT,
+        QUADRATIC_IN,
+        QUADRATIC_OUT,
+        QUADRATIC_IN_OUT,
+        QUARTIC_IN,
+        QUARTIC_OUT,
+        QUARTIC_IN_OUT,
+        QUINTIC_IN,
+        QUINTIC_OUT,
+        QUINTIC_IN_OUT,
+        CIRCLE_IN,
+        CIRCLE_OUT,
+        CIRCLE_IN_OUT,
+        CUBIC_IN,
+        CUBIC_OUT,
+        CUBIC_IN_OUT,
+    };
+
+    struct Tween
+    {
+        /** the action which owns the record, nullptr once removed */
+        ActionInterval* action;
+        Node* target;
+        const bool* paused;
+        Kind kind;
+        Easing easing;
+        bool firstTick;
+        /** rate or period of the easing */
+        float easingParam;
+        float duration;
+        float elapsed;
+        Vec3 from;
+        Vec3 delta;
+        /** position set by the last update, used by stackable moves */
+        Vec2 previous;
+    };
+
+    static bool findEasing(const Action* action, Easing* easing, float* param);
+    static float ease(Easing easing, float param, float time);
+    void apply(Tween& tween, float time);
+    /** Drops the records removed during update() */
+    void compact();
+
+    std::vector<Tween> _tweens;
+    /** records added during update() */
+    std::vector<Tween> _added;
+    /** records cleared during update() */
+    ssize_t _removedCount;
+    bool _updating;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(TweenSystem);
+};
+
+// end of actions group
+/// @}
+
+NS_CC_END
+
+#endif // __CCTWEENSYSTEM_H__
@@ -57,6 +57,7 @@ public:
     
     virtual Mat4 getWorldToNodeTransform() const override;
     virtual void visit(Renderer *renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
+    virtual bool isVisitThreadSafe() const override { return false; }
 
 CC_CONSTRUCTOR_ACCESS:
     
@@ -48,7 +48,12 @@ cocos2d.cpp \
 2d/CCMenuItem.cpp \
 2d/CCMotionStreak.cpp \
 2d/CCNode.cpp \
+2d/CCSpatialIndex.cpp \
+2d/CCNodePath.cpp \
+2d/CCTransformSystem.cpp \
+2d/CCTweenSystem.cpp \
 2d/CCNodeGrid.cpp \
+2d/CCParallelVisitor.cpp \
 2d/CCParallaxNode.cpp \
 2d/CCParticleBatchNode.cpp \
 2d/CCParticleExamples.cpp \
@@ -60,6 +65,7 @@ cocos2d.cpp \
 2d/CCScene.cpp \
 2d/CCSprite.cpp \
 2d/CCSpriteBatchNode.cpp \
+2d/CCStaticBatchNode.cpp \
 2d/CCSpriteFrame.cpp \
 2d/CCSpriteFrameCache.cpp \
 2d/CCTMXLayer.cpp \
@@ -120,6 +126,9 @@ base/CCProfiling.cpp \
 base/ccRandom.cpp \
 base/CCRef.cpp \
 base/CCScheduler.cpp \
+base/CCFramePacer.cpp \
+base/CCJobSystem.cpp \
+base/CCTaskQueue.cpp \
 base/CCScriptSupport.cpp \
 base/CCTouch.cpp \
 base/CCUserDefault.cpp \
@@ -144,12 +153,15 @@ renderer/CCBatchCommand.cpp \
 renderer/CCCustomCommand.cpp \
 renderer/CCGLProgram.cpp \
 renderer/CCGLProgramCache.cpp \
+renderer/CCGLProgramBinaryCache.cpp \
 renderer/CCGLProgramState.cpp \
 renderer/CCGLProgramStateCache.cpp \
 renderer/CCGroupCommand.cpp \
 renderer/CCQuadCommand.cpp \
 renderer/CCMeshCommand.cpp \
 renderer/CCRenderCommand.cpp \
+renderer/CCRenderCommandBuffer.cpp \
+renderer/CCRenderStats.cpp \
 renderer/CCRenderer.cpp \
 renderer/CCTexture2D.cpp \
 renderer/CCTextureAtlas.cpp \
@@ -23,27 +23,52 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "base/CCAutoreleasePool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+#if CC_ENABLE_AUTORELEASE_TRACKING
+#include <typeinfo>
+#endif
+
 #include "base/ccMacros.h"
 
 NS_CC_BEGIN
 
+// objects are released this many slots after being prefetched
+static const size_t PREFETCH_DISTANCE = 8;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CC_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define CC_PREFETCH(address)
+#endif
+
 AutoreleasePool::AutoreleasePool()
-: _name("")
+: _count(0)
+, _name("")
 #if defined(COCOS2D_DEBUG) && (COCOS2D_DEBUG > 0)
 , _isClearing(false)
 #endif
 {
-    _managedObjectArray.reserve(150);
+    resetStatistics();
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    _trackedClears = 0;
+#endif
     PoolManager::getInstance()->push(this);
 }
 
 AutoreleasePool::AutoreleasePool(const std::string &name)
-: _name(name)
+: _count(0)
+, _name(name)
 #if defined(COCOS2D_DEBUG) && (COCOS2D_DEBUG > 0)
 , _isClearing(false)
 #endif
 {
-    _managedObjectArray.reserve(150);
+    resetStatistics();
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    _trackedClears = 0;
+#endif
     PoolManager::getInstance()->push(this);
 }
 
@@ -51,35 +76,96 @@ AutoreleasePool::~AutoreleasePool()
 {
     CCLOGINFO("deallocing AutoreleasePool: %p", this);
     clear();
+
+    for (auto chunk : _chunks)
+        delete [] chunk;
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    for (auto chunk : _callSiteChunks)
+        delete [] chunk;
+#endif
     
     PoolManager::getInstance()->pop();
 }
 
+void AutoreleasePool::addChunk()
+{
+    _chunks.push_back(new Ref*[CHUNK_SIZE]);
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    _callSiteChunks.push_back(new const void*[CHUNK_SIZE]);
+#endif
+}
+
 void AutoreleasePool::addObject(Ref* object)
 {
-    _managedObjectArray.push_back(object);
+    if (_count == _chunks.size() * CHUNK_SIZE)
+        addChunk();
+
+    objectAt(_count) = object;
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    _callSiteChunks[_count / CHUNK_SIZE][_count % CHUNK_SIZE] = nullptr;
+#endif
+    ++_count;
+}
+
+#if CC_ENABLE_AUTORELEASE_TRACKING
+void AutoreleasePool::addObject(Ref* object, const void* callSite)
+{
+    size_t index = _count;
+    addObject(object);
+    _callSiteChunks[index / CHUNK_SIZE][index % CHUNK_SIZE] = callSite;
 }
+#endif
 
 void AutoreleasePool::clear()
 {
 #if defined(COCOS2D_DEBUG) && (COCOS2D_DEBUG > 0)
     _isClearing = true;
 #endif
-    for (const auto &obj : _managedObjectArray)
+    auto start = std::chrono::steady_clock::now();
+
+    // the destructors may autorelease more objects, _count grows but the chunks don't move
+    size_t i = 0;
+    for (; i < _count; ++i)
     {
+        if (i + PREFETCH_DISTANCE < _count)
+            CC_PREFETCH(objectAt(i + PREFETCH_DISTANCE));
+
+        Ref* obj = objectAt(i);
+#if CC_ENABLE_AUTORELEASE_TRACKING
+        const void* callSite = _callSiteChunks[i / CHUNK_SIZE][i % CHUNK_SIZE];
+        auto& site = _callSites[callSite];
+        ++site.objects;
+        site.lastType = typeid(*obj).name();
+#endif
         obj->release();
     }
-    _managedObjectArray.clear();
+    _count = 0;
+
+    float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    _statistics.lastCount = (unsigned int)i;
+    _statistics.peakCount = std::max(_statistics.peakCount, _statistics.lastCount);
+    _statistics.lastClearTime = elapsed;
+    _statistics.peakClearTime = std::max(_statistics.peakClearTime, elapsed);
+    _statistics.totalClearTime += elapsed;
+    ++_statistics.clearCount;
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    ++_trackedClears;
+#endif
 #if defined(COCOS2D_DEBUG) && (COCOS2D_DEBUG > 0)
     _isClearing = false;
 #endif
 }
 
+void AutoreleasePool::resetStatistics()
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
 bool AutoreleasePool::contains(Ref* object) const
 {
-    for (const auto& obj : _managedObjectArray)
+    for (size_t i = 0; i < _count; ++i)
     {
-        if (obj == object)
+        if (_chunks[i / CHUNK_SIZE][i % CHUNK_SIZE] == object)
             return true;
     }
     return false;
@@ -87,15 +173,45 @@ bool AutoreleasePool::contains(Ref* object) const
 
 void AutoreleasePool::dump()
 {
-    CCLOG("autorelease pool: %s, number of managed object %d\n", _name.c_str(), static_cast<int>(_managedObjectArray.size()));
+    CCLOG("autorelease pool: %s, number of managed object %d\n", _name.c_str(), static_cast<int>(_count));
     CCLOG("%20s%20s%20s", "Object pointer", "Object id", "reference count");
-    for (const auto &obj : _managedObjectArray)
+    for (size_t i = 0; i < _count; ++i)
     {
+        Ref* obj = objectAt(i);
         CC_UNUSED_PARAM(obj);
         CCLOG("%20p%20u\n", obj, obj->getReferenceCount());
     }
 }
 
+#if CC_ENABLE_AUTORELEASE_TRACKING
+void AutoreleasePool::dumpCallSites(int count)
+{
+    std::vector<std::pair<const void*, const CallSite*>> sites;
+    for (const auto& site : _callSites)
+        sites.push_back(std::make_pair(site.first, &site.second));
+
+    std::sort(sites.begin(), sites.end(), [](const std::pair<const void*, const CallSite*>& a, const std::pair<const void*, const CallSite*>& b) {
+        return a.second->objects > b.second->objects;
+    });
+
+    CCLOG("autorelease pool: %s, call sites of the objects released by the last %u clears", _name.c_str(), _trackedClears);
+    CCLOG("%20s%20s%20s  %s", "Call site", "Objects", "Per clear", "Last type");
+    for (int i = 0; i < count && i < (int)sites.size(); ++i)
+    {
+        const CallSite* site = sites[i].second;
+        CC_UNUSED_PARAM(site);
+        CCLOG("%20p%20u%20.1f  %s", sites[i].first, site->objects,
+              _trackedClears ? (float)site->objects / _trackedClears : 0.0f, site->lastType.c_str());
+    }
+}
+
+void AutoreleasePool::resetCallSites()
+{
+    _callSites.clear();
+    _trackedClears = 0;
+}
+#endif
+
 
 //--------------------------------------------------------------------
 //
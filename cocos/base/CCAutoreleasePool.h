@@ -30,6 +30,17 @@ THE SOFTWARE.
 #include <string>
 #include "base/CCRef.h"
 
+#if CC_ENABLE_AUTORELEASE_TRACKING
+#include <unordered_map>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CC_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define CC_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+#endif // CC_ENABLE_AUTORELEASE_TRACKING
+
 NS_CC_BEGIN
 
 /**
@@ -40,6 +51,23 @@ NS_CC_BEGIN
 class CC_DLL AutoreleasePool
 {
 public:
+    /** Counters of the objects released by clear() */
+    struct Statistics
+    {
+        /** Objects released by the last clear() */
+        unsigned int lastCount;
+        /** Most objects released by one clear() */
+        unsigned int peakCount;
+        /** Milliseconds spent in the last clear(), destructors included */
+        float lastClearTime;
+        /** Longest clear(), in milliseconds */
+        float peakClearTime;
+        /** Milliseconds spent in clear() since the last reset */
+        float totalClearTime;
+        /** Number of clear() since the last reset */
+        unsigned int clearCount;
+    };
+
     /**
      * @warn Don't create an auto release pool in heap, create it in stack.
      * @js NA
@@ -71,15 +99,27 @@ public:
      */
     void addObject(Ref *object);
 
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    /** Adds an object and records where it was autoreleased from */
+    void addObject(Ref *object, const void* callSite);
+#endif
+
     /**
      * Clear the autorelease pool.
      *
      * Ref::release() will be called for each time the managed object is
-     * added to the pool.
+     * added to the pool. Objects autoreleased by the destructors are released too.
+     * The storage is kept for the next frame.
      * @js NA
      * @lua NA
      */
     void clear();
+
+    /** Number of objects waiting to be released */
+    ssize_t getObjectCount() const { return _count; }
+
+    const Statistics& getStatistics() const { return _statistics; }
+    void resetStatistics();
     
 #if defined(COCOS2D_DEBUG) && (COCOS2D_DEBUG > 0)
     /**
@@ -101,19 +141,46 @@ public:
      *
      */
     void dump();
+
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    /**
+     * Logs the call sites that autoreleased the most objects since the last resetCallSites(),
+     * with the average number of objects per clear() and the type of the last object.
+     */
+    void dumpCallSites(int count = 10);
+    void resetCallSites();
+#endif
     
 private:
+    /** Objects are stored in chunks that never move, so that growing the pool doesn't copy it */
+    static const size_t CHUNK_SIZE = 1024;
+
+    Ref*& objectAt(size_t index) { return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+    void addChunk();
+
     /**
-     * The underlying array of object managed by the pool.
+     * The objects managed by the pool, _count of them.
      *
-     * Although Array retains the object once when an object is added, proper
-     * Ref::release() is called outside the array to make sure that the pool
-     * does not affect the managed object's reference count. So an object can
-     * be destructed properly by calling Ref::release() even if the object
-     * is in the pool.
+     * The pool doesn't retain the objects: the reference given to the pool by
+     * autorelease() is released by clear(). So an object can be destructed
+     * properly by calling Ref::release() even if the object is in the pool.
      */
-    std::vector<Ref*> _managedObjectArray;
+    std::vector<Ref**> _chunks;
+    size_t _count;
     std::string _name;
+    Statistics _statistics;
+
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    struct CallSite
+    {
+        unsigned int objects;
+        std::string lastType;
+    };
+
+    std::vector<const void**> _callSiteChunks;
+    std::unordered_map<const void*, CallSite> _callSites;
+    unsigned int _trackedClears;
+#endif
     
 #if defined(COCOS2D_DEBUG) && (COCOS2D_DEBUG > 0)
     /**
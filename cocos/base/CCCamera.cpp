@@ -83,7 +83,7 @@ void Camera::setPosition3D(const Vec3& position)
 {
     Node::setPosition3D(position);
     
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    markTransformDirty();
 }
 
 const Mat4& Camera::getProjectionMatrix() const
@@ -47,6 +47,10 @@ Configuration::Configuration()
 , _supportsBGRA8888(false)
 , _supportsDiscardFramebuffer(false)
 , _supportsShareableVAO(false)
+, _supportsMapBufferRange(false)
+, _supportsSync(false)
+, _supportsInstancing(false)
+, _supportsProgramBinary(false)
 , _maxSamplesAllowed(0)
 , _maxTextureUnits(0)
 , _glExtensions(nullptr)
@@ -101,6 +105,17 @@ std::string Configuration::getInfo() const
 
 void Configuration::gatherGPUInfo()
 {
+#if CC_USE_NULL_RENDERER
+    // there is no GL context to query, report a minimal GL ES 2.0 like device without extensions
+    static char s_noExtensions[] = "";
+	_valueDict["gl.vendor"] = Value("cocos2d-x");
+	_valueDict["gl.renderer"] = Value("null renderer");
+	_valueDict["gl.version"] = Value("2.0");
+
+    _glExtensions = s_noExtensions;
+    _maxTextureSize = 4096;
+    _maxTextureUnits = 8;
+#else
 	_valueDict["gl.vendor"] = Value((const char*)glGetString(GL_VENDOR));
 	_valueDict["gl.renderer"] = Value((const char*)glGetString(GL_RENDERER));
 	_valueDict["gl.version"] = Value((const char*)glGetString(GL_VERSION));
@@ -108,9 +123,10 @@ void Configuration::gatherGPUInfo()
     _glExtensions = (char *)glGetString(GL_EXTENSIONS);
 
     glGetIntegerv(GL_MAX_TEXTURE_SIZE, &_maxTextureSize);
-	_valueDict["gl.max_texture_size"] = Value((int)_maxTextureSize);
-
     glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &_maxTextureUnits);
+#endif // CC_USE_NULL_RENDERER
+
+	_valueDict["gl.max_texture_size"] = Value((int)_maxTextureSize);
 	_valueDict["gl.max_texture_units"] = Value((int)_maxTextureUnits);
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
@@ -142,6 +158,35 @@ void Configuration::gatherGPUInfo()
     _supportsShareableVAO = checkForGLExtension("vertex_array_object");
 	_valueDict["gl.supports_vertex_array_object"] = Value(_supportsShareableVAO);
 
+    _supportsMapBufferRange = checkForGLExtension("_map_buffer_range");
+    _valueDict["gl.supports_map_buffer_range"] = Value(_supportsMapBufferRange);
+
+    _supportsSync = checkForGLExtension("GL_ARB_sync");
+    _valueDict["gl.supports_sync"] = Value(_supportsSync);
+
+    // GL_ARB_instanced_arrays, GL_EXT_instanced_arrays and GL_ANGLE_instanced_arrays all bring the instanced draw calls
+    _supportsInstancing = checkForGLExtension("_instanced_arrays");
+#if defined(__glew_h__) && defined(GL_VERTEX_ATTRIB_ARRAY_DIVISOR)
+    // GLEW only loads the core entry points the context version provides
+    _supportsInstancing = _supportsInstancing && glDrawElementsInstanced && glVertexAttribDivisor;
+#endif
+    _valueDict["gl.supports_instancing"] = Value(_supportsInstancing);
+
+    // GL_ARB_get_program_binary and GL_OES_get_program_binary. Drivers may expose the extension with no binary format
+    _supportsProgramBinary = checkForGLExtension("_get_program_binary");
+#if defined(GL_NUM_PROGRAM_BINARY_FORMATS) && !CC_USE_NULL_RENDERER
+#if defined(__glew_h__)
+    _supportsProgramBinary = _supportsProgramBinary && glGetProgramBinary && glProgramBinary;
+#endif
+    if (_supportsProgramBinary)
+    {
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        _supportsProgramBinary = formats > 0;
+    }
+#endif
+    _valueDict["gl.supports_program_binary"] = Value(_supportsProgramBinary);
+
     CHECK_GL_ERROR_DEBUG();
 }
 
@@ -247,6 +292,45 @@ bool Configuration::supportsShareableVAO() const
 #endif
 }
 
+bool Configuration::supportsMapBufferRange() const
+{
+    // the GL ES 2.0 headers only declare the EXT version
+#ifdef GL_MAP_UNSYNCHRONIZED_BIT
+    return _supportsMapBufferRange;
+#else
+    return false;
+#endif
+}
+
+bool Configuration::supportsSync() const
+{
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+    return _supportsSync;
+#else
+    return false;
+#endif
+}
+
+bool Configuration::supportsInstancing() const
+{
+    // only defined where CCGL.h maps glVertexAttribDivisor and glDrawElementsInstanced to the platform entry points
+#ifdef GL_VERTEX_ATTRIB_ARRAY_DIVISOR
+    return _supportsInstancing;
+#else
+    return false;
+#endif
+}
+
+bool Configuration::supportsProgramBinary() const
+{
+    // only defined where CCGL.h maps glGetProgramBinary and glProgramBinary to the platform entry points
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    return _supportsProgramBinary;
+#else
+    return false;
+#endif
+}
+
 //
 // generic getters for properties
 //
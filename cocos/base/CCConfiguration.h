@@ -110,6 +110,18 @@ public:
      */
 	bool supportsShareableVAO() const;
 
+    /** Whether or not glMapBufferRange is supported, which lets buffers be written without synchronizing with the GPU */
+    bool supportsMapBufferRange() const;
+
+    /** Whether or not sync objects (glFenceSync) are supported */
+    bool supportsSync() const;
+
+    /** Whether or not instanced drawing (glDrawElementsInstanced and glVertexAttribDivisor) is supported */
+    bool supportsInstancing() const;
+
+    /** Whether or not linked programs can be read back and reloaded with glGetProgramBinary and glProgramBinary */
+    bool supportsProgramBinary() const;
+
     /** returns whether or not an OpenGL is supported */
     bool checkForGLExtension(const std::string &searchName) const;
 
@@ -146,6 +158,10 @@ protected:
     bool            _supportsBGRA8888;
     bool            _supportsDiscardFramebuffer;
     bool            _supportsShareableVAO;
+    bool            _supportsMapBufferRange;
+    bool            _supportsSync;
+    bool            _supportsInstancing;
+    bool            _supportsProgramBinary;
     GLint           _maxSamplesAllowed;
     GLint           _maxTextureUnits;
     char *          _glExtensions;
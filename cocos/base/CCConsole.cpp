@@ -61,6 +61,7 @@
 #include "2d/CCScene.h"
 #include "platform/CCFileUtils.h"
 #include "renderer/CCTextureCache.h"
+#include "renderer/CCRenderer.h"
 #include "base/base64.h"
 #include "base/ccUtils.h"
 NS_CC_BEGIN
@@ -290,6 +291,7 @@ Console::Console()
         } },
         { "help", "Print this message", std::bind(&Console::commandHelp, this, std::placeholders::_1, std::placeholders::_2) },
         { "projection", "Change or print the current projection. Args: [2d | 3d]", std::bind(&Console::commandProjection, this, std::placeholders::_1, std::placeholders::_2) },
+        { "renderstats", "Print the render statistics of the last frames, 1 by default. Args: [frames | reset | history frames]", std::bind(&Console::commandRenderStats, this, std::placeholders::_1, std::placeholders::_2) },
         { "resolution", "Change or print the window resolution. Args: [width height resolution_policy | ]", std::bind(&Console::commandResolution, this, std::placeholders::_1, std::placeholders::_2) },
         { "scenegraph", "Print the scene graph", std::bind(&Console::commandSceneGraph, this, std::placeholders::_1, std::placeholders::_2) },
         { "texture", "Flush or print the TextureCache info. Args: [flush | ] ", std::bind(&Console::commandTextures, this, std::placeholders::_1, std::placeholders::_2) },
@@ -591,6 +593,41 @@ void Console::commandTextures(int fd, const std::string& args)
     }
 }
 
+void Console::commandRenderStats(int fd, const std::string& args)
+{
+    Scheduler *sched = Director::getInstance()->getScheduler();
+    auto argv = split(args, ' ');
+
+    if (argv.empty() || (argv.size() == 1 && isFloat(argv[0])))
+    {
+        int frames = argv.empty() ? 1 : atoi(argv[0].c_str());
+        sched->performFunctionInCocosThread( [=](){
+            mydprintf(fd, "%s", Director::getInstance()->getRenderer()->getStats().getDescription(frames).c_str());
+            sendPrompt(fd);
+        }
+                                            );
+    }
+    else if (argv.size() == 1 && argv[0] == "reset")
+    {
+        sched->performFunctionInCocosThread( [](){
+            Director::getInstance()->getRenderer()->getStats().reset();
+        }
+                                            );
+    }
+    else if (argv.size() == 2 && argv[0] == "history" && isFloat(argv[1]) && atoi(argv[1].c_str()) > 0)
+    {
+        int frames = atoi(argv[1].c_str());
+        sched->performFunctionInCocosThread( [=](){
+            Director::getInstance()->getRenderer()->getStats().setHistorySize(frames);
+        }
+                                            );
+    }
+    else
+    {
+        mydprintf(fd, "Unsupported argument: '%s'. Supported arguments: a number of frames, 'reset', 'history' and a number of frames or nothing\n", args.c_str());
+    }
+}
+
 
 void Console::commandDirector(int fd, const std::string& args)
 {
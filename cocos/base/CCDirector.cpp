@@ -30,9 +30,11 @@ THE SOFTWARE.
 
 // standard includes
 #include <string>
+#include <algorithm>
 
 #include "2d/CCDrawingPrimitives.h"
 #include "2d/CCScene.h"
+#include "2d/CCTransformSystem.h"
 #include "2d/CCSpriteFrameCache.h"
 #include "platform/CCFileUtils.h"
 #include "platform/CCImage.h"
@@ -42,7 +44,9 @@ THE SOFTWARE.
 #include "2d/CCAnimationCache.h"
 #include "2d/CCTransition.h"
 #include "2d/CCFontFreeType.h"
+#include "2d/CCParallelVisitor.h"
 #include "renderer/CCGLProgramCache.h"
+#include "renderer/CCGLProgramBinaryCache.h"
 #include "renderer/CCGLProgramStateCache.h"
 #include "renderer/CCTextureCache.h"
 #include "renderer/ccGLStateCache.h"
@@ -51,6 +55,7 @@ THE SOFTWARE.
 #include "base/CCUserDefault.h"
 #include "base/ccFPSImages.h"
 #include "base/CCScheduler.h"
+#include "base/CCJobSystem.h"
 #include "base/ccMacros.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventCustom.h"
@@ -138,6 +143,7 @@ bool Director::init(void)
 
     // scheduler
     _scheduler = new Scheduler();
+    _jobSystem = new JobSystem(CC_JOB_SYSTEM_WORKERS);
     // action manager
     _actionManager = new ActionManager();
     _scheduler->scheduleUpdate(_actionManager, Scheduler::PRIORITY_SYSTEM, false);
@@ -158,6 +164,17 @@ bool Director::init(void)
     initMatrixStack();
 
     _renderer = new Renderer;
+    _parallelVisitor = nullptr;
+    _matrixStackEnabled = true;
+
+    _fixedTimeStep = 0;
+    _fixedStepAccumulator = 0;
+    _maxFixedStepsPerFrame = 5;
+    _lastFrameFixedSteps = 0;
+    _interpolationAlpha = 1;
+
+    _framePacer = new FramePacer();
+    _lastInputEventCount = 0;
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
     _console = new Console;
@@ -169,6 +186,11 @@ Director::~Director(void)
 {
     CCLOGINFO("deallocing Director: %p", this);
 
+    // runs the queued jobs first, they may use the other members
+    delete _jobSystem;
+
+    delete _framePacer;
+
     CC_SAFE_RELEASE(_FPSLabel);
     CC_SAFE_RELEASE(_drawnVerticesLabel);
     CC_SAFE_RELEASE(_drawnBatchesLabel);
@@ -183,6 +205,7 @@ Director::~Director(void)
     delete _eventAfterVisit;
     delete _eventProjectionChanged;
 
+    CC_SAFE_DELETE(_parallelVisitor);
     delete _renderer;
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
@@ -267,7 +290,10 @@ void Director::drawScene()
     //tick before glClear: issue #533
     if (! _paused)
     {
-        _scheduler->update(_deltaTime);
+        if (_fixedTimeStep > 0)
+            runFixedSteps();
+        else
+            _scheduler->update(_deltaTime);
         _eventDispatcher->dispatchEvent(_eventAfterUpdate);
     }
 
@@ -285,6 +311,21 @@ void Director::drawScene()
     
     if (_runningScene)
     {
+        // the scene is drawn between the last two simulated states, the updates of the next frame see the simulated one
+        bool interpolate = _fixedTimeStep > 0 && !_interpolatedNodes.empty();
+        if (interpolate)
+        {
+            for (auto node : _interpolatedNodes)
+            {
+                node->applyInterpolatedTransform(_interpolationAlpha);
+            }
+        }
+
+        if (_runningScene->getTransformSystem())
+        {
+            _runningScene->getTransformSystem()->update();
+        }
+
         Camera* defaultCamera = nullptr;
         const auto& cameras = _runningScene->_cameras;
         //draw with camera
@@ -301,7 +342,12 @@ void Director::drawScene()
             loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION, Camera::_visitingCamera->getViewProjectionMatrix());
             
             //visit the scene
-            _runningScene->visit(_renderer, Mat4::IDENTITY, 0);
+            auto visitStart = RenderStats::Clock::now();
+            if (_parallelVisitor)
+                _parallelVisitor->visit(_runningScene, _renderer, Mat4::IDENTITY, 0);
+            else
+                _runningScene->visit(_renderer, Mat4::IDENTITY, 0);
+            _renderer->getStats().getCurrentFrame().visitTime += RenderStats::millisecondsSince(visitStart);
             _renderer->render();
             
             popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
@@ -314,12 +360,25 @@ void Director::drawScene()
             loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION, Camera::_visitingCamera->getViewProjectionMatrix());
             
             //visit the scene
-            _runningScene->visit(_renderer, Mat4::IDENTITY, 0);
+            auto visitStart = RenderStats::Clock::now();
+            if (_parallelVisitor)
+                _parallelVisitor->visit(_runningScene, _renderer, Mat4::IDENTITY, 0);
+            else
+                _runningScene->visit(_renderer, Mat4::IDENTITY, 0);
+            _renderer->getStats().getCurrentFrame().visitTime += RenderStats::millisecondsSince(visitStart);
             _renderer->render();
             
             popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
         }
         Camera::_visitingCamera = nullptr;
+
+        if (interpolate)
+        {
+            for (auto node : _interpolatedNodes)
+            {
+                node->restoreSimulatedTransform();
+            }
+        }
         
         _eventDispatcher->dispatchEvent(_eventAfterVisit);
     }
@@ -348,6 +407,8 @@ void Director::drawScene()
         _openGLView->swapBuffers();
     }
 
+    _renderer->getStats().endFrame();
+
     if (_displayStats)
     {
         calculateMPF();
@@ -391,6 +452,71 @@ float Director::getDeltaTime() const
 {
     return _deltaTime;
 }
+
+void Director::setFixedTimeStep(float step)
+{
+    _fixedTimeStep = MAX(0, step);
+    _fixedStepAccumulator = 0;
+    _lastFrameFixedSteps = 0;
+    _interpolationAlpha = _fixedTimeStep > 0 ? 0 : 1;
+
+    for (auto node : _interpolatedNodes)
+    {
+        node->resetTransformInterpolation();
+    }
+}
+
+void Director::runFixedSteps()
+{
+    _fixedStepAccumulator += _deltaTime;
+
+    int steps = (int)(_fixedStepAccumulator / _fixedTimeStep);
+    if (steps > _maxFixedStepsPerFrame)
+    {
+        // too far behind to catch up, the simulation slows down instead of spiraling
+        steps = _maxFixedStepsPerFrame;
+        _fixedStepAccumulator = steps * _fixedTimeStep + fmodf(_fixedStepAccumulator, _fixedTimeStep);
+    }
+
+    for (int i = 0; i < steps; ++i)
+    {
+        // the nodes are drawn from the state preceding the last step of the frame
+        if (i == steps - 1)
+        {
+            for (auto node : _interpolatedNodes)
+            {
+                node->saveInterpolationState();
+            }
+        }
+
+        _scheduler->update(_fixedTimeStep);
+        _fixedStepAccumulator -= _fixedTimeStep;
+    }
+
+    _lastFrameFixedSteps = steps;
+    _interpolationAlpha = clampf(_fixedStepAccumulator / _fixedTimeStep, 0, 1);
+}
+
+void Director::addInterpolatedNode(Node* node)
+{
+    CCASSERT(node->_interpolationSlot < 0, "node already registered");
+    node->_interpolationSlot = (int)_interpolatedNodes.size();
+    _interpolatedNodes.push_back(node);
+}
+
+void Director::removeInterpolatedNode(Node* node)
+{
+    int slot = node->_interpolationSlot;
+    CCASSERT(slot >= 0 && _interpolatedNodes[slot] == node, "node not registered");
+
+    node->restoreSimulatedTransform();
+
+    Node* last = _interpolatedNodes.back();
+    _interpolatedNodes[slot] = last;
+    last->_interpolationSlot = slot;
+    _interpolatedNodes.pop_back();
+    node->_interpolationSlot = -1;
+}
 void Director::setOpenGLView(GLView *openGLView)
 {
     CCASSERT(openGLView, "opengl view should not be null");
@@ -990,6 +1116,7 @@ void Director::purgeDirector()
     AnimationCache::destroyInstance();
     SpriteFrameCache::destroyInstance();
     GLProgramCache::destroyInstance();
+    GLProgramBinaryCache::destroyInstance();
     GLProgramStateCache::destroyInstance();
     FileUtils::destroyInstance();
 
@@ -1251,6 +1378,27 @@ void Director::setEventDispatcher(EventDispatcher* dispatcher)
     }
 }
 
+void Director::setParallelVisitEnabled(bool enabled)
+{
+    if (enabled == (_parallelVisitor != nullptr))
+    {
+        return;
+    }
+
+    CC_SAFE_DELETE(_parallelVisitor);
+    if (enabled)
+    {
+        // no threads of its own, the tasks are jobs
+        _parallelVisitor = new (std::nothrow) ParallelVisitor(_jobSystem);
+    }
+}
+
+const AutoreleasePool::Statistics& Director::getAutoreleaseStatistics() const
+{
+    // the pool cleared by mainLoop()
+    return PoolManager::getInstance()->getCurrentPool()->getStatistics();
+}
+
 /***************************************************
 * implementation of DisplayLinkDirector
 **************************************************/
@@ -1267,6 +1415,7 @@ void DisplayLinkDirector::startAnimation()
 
     _invalid = false;
 
+    _framePacer->setInterval(_animationInterval);
     Application::getInstance()->setAnimationInterval(_animationInterval);
     
     // fix issue #3509, skip one fps to avoid incorrect time calculation.
@@ -1282,10 +1431,23 @@ void DisplayLinkDirector::mainLoop()
     }
     else if (! _invalid)
     {
+        _framePacer->beginFrame();
+
         drawScene();
      
         // release the objects
         PoolManager::getInstance()->getCurrentPool()->clear();
+
+        // input, actions and scene changes keep the frame pacer away from its idle interval
+        if (_framePacer->getIdleInterval() > 0)
+        {
+            unsigned int inputEventCount = _eventDispatcher->getInputEventCount();
+            if (inputEventCount != _lastInputEventCount || _nextScene || _actionManager->hasRunningActions())
+            {
+                _lastInputEventCount = inputEventCount;
+                _framePacer->markActive();
+            }
+        }
     }
 }
 
@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include "base/CCPlatformMacros.h"
 
 #include "base/CCRef.h"
+#include "base/CCAutoreleasePool.h"
+#include "base/CCFramePacer.h"
 #include "base/ccTypes.h"
 #include "math/CCGeometry.h"
 #include "base/CCVector.h"
@@ -61,6 +63,8 @@ class EventCustom;
 class EventListenerCustom;
 class TextureCache;
 class Renderer;
+class ParallelVisitor;
+class JobSystem;
 class Camera;
 
 #if  (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
@@ -392,6 +396,30 @@ public:
      */
     Renderer* getRenderer() const { return _renderer; }
 
+    /** Visits the running scene with the main thread and the workers of the JobSystem. Disabled by default.
+     The commands reach the Renderer in the same order as with a serial visit, but the Mat4 stack is not updated by the nodes.
+     Nodes that can't be visited from a worker thread must override Node::isVisitThreadSafe().
+     */
+    void setParallelVisitEnabled(bool enabled);
+    /** Returns whether the running scene is visited by several threads */
+    bool isParallelVisitEnabled() const { return _parallelVisitor != nullptr; }
+    ParallelVisitor* getParallelVisitor() const { return _parallelVisitor; }
+
+    /** Gets the JobSystem of the engine, which runs the background and parallel work of every subsystem.
+     Its number of workers is set by CC_JOB_SYSTEM_WORKERS.
+     */
+    JobSystem* getJobSystem() const { return _jobSystem; }
+
+    /** Whether the nodes load their transform in the modelview Mat4 stack while they are visited. Enabled by default.
+     When disabled, only the nodes declaring Node::setMatrixStackNeeded(true) maintain it, which saves a push, a load and
+     a pop per visited node. Nodes whose draw code reads the stack, with kmGL* functions or getMatrix(), need it.
+     */
+    void setMatrixStackEnabled(bool enabled) { _matrixStackEnabled = enabled; }
+    bool isMatrixStackEnabled() const { return _matrixStackEnabled; }
+
+    /** Objects per frame, peak and time spent releasing the objects autoreleased during the frames */
+    const AutoreleasePool::Statistics& getAutoreleaseStatistics() const;
+
     /** Returns the Console 
      @since v3.0
      */
@@ -407,6 +435,34 @@ public:
      */
     float getFrameRate() const { return _frameRate; }
 
+    /** Runs the Scheduler with a fixed time step instead of the time elapsed since the last frame. 0 disables it, which is the default.
+     Each frame adds its delta time to an accumulator, then calls Scheduler::update(step) for every full step it holds, up to
+     getMaxFixedStepsPerFrame() times. Updates, actions and the PhysicsWorld of the running scene advance by the same amount every time,
+     whatever the frame rate. getDeltaTime() still returns the duration of the frame.
+     */
+    void setFixedTimeStep(float step);
+    float getFixedTimeStep() const { return _fixedTimeStep; }
+
+    /** Most fixed steps run by a frame, 5 by default. The time a slow frame can't catch up with is dropped */
+    void setMaxFixedStepsPerFrame(int steps) { _maxFixedStepsPerFrame = MAX(1, steps); }
+    int getMaxFixedStepsPerFrame() const { return _maxFixedStepsPerFrame; }
+
+    /** Part of a fixed step left in the accumulator after the updates of the frame, from 0 to 1. 1 without a fixed time step.
+     Nodes with Node::setTransformInterpolationEnabled(true) are drawn this far from their previous simulated state to the current one.
+     */
+    float getInterpolationAlpha() const { return _interpolationAlpha; }
+
+    /** Number of fixed steps run by the last frame */
+    int getLastFrameFixedSteps() const { return _lastFrameFixedSteps; }
+
+    /** Gets the FramePacer that measures the frames. The desktop main loops also sleep with it between two frames.
+     Set its idle interval to slow the loop down while the scene gets no input and runs no action.
+     */
+    FramePacer* getFramePacer() const { return _framePacer; }
+
+    /** Duration and variance of the recent frames */
+    const FramePacer::Statistics& getFrameStatistics() const { return _framePacer->getStatistics(); }
+
 protected:
     void purgeDirector();
     bool _purgeDirectorInNextLoop; // this flag will be set to true in end()
@@ -421,6 +477,13 @@ protected:
     /** calculates delta time since last time it was called */    
     void calculateDeltaTime();
 
+    /** Runs the fixed steps held by the accumulator and computes the interpolation alpha */
+    void runFixedSteps();
+
+    /** Called by the nodes with transform interpolation while they are running */
+    void addInterpolatedNode(Node* node);
+    void removeInterpolatedNode(Node* node);
+
     //textureCache creation or release
     void initTextureCache();
     void destroyTextureCache();
@@ -507,6 +570,30 @@ protected:
     /* Renderer for the Director */
     Renderer *_renderer;
 
+    /* Visits the running scene in parallel, nullptr when disabled */
+    ParallelVisitor *_parallelVisitor;
+
+    /* Worker pool shared by the subsystems */
+    JobSystem *_jobSystem;
+
+    /* whether the nodes keep the modelview Mat4 stack up to date while visited */
+    bool _matrixStackEnabled;
+
+    /* fixed time step of the Scheduler, 0 when the frame delta time is used */
+    float _fixedTimeStep;
+    float _fixedStepAccumulator;
+    int _maxFixedStepsPerFrame;
+    int _lastFrameFixedSteps;
+    float _interpolationAlpha;
+
+    /* running nodes drawn between their last two simulated states, weak references */
+    std::vector<Node*> _interpolatedNodes;
+
+    /* measures and paces the frames */
+    FramePacer *_framePacer;
+    /* input events seen by the last frame, to detect an idle scene */
+    unsigned int _lastInputEventCount;
+
 #if  (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
     /* Console for the director */
     Console *_console;
@@ -514,6 +601,7 @@ protected:
 
     // GLView will recreate stats labels to fit visible rect
     friend class GLView;
+    friend class Node;
 };
 
 /** 
@@ -204,6 +204,7 @@ EventDispatcher::EventDispatcher()
 : _inDispatch(0)
 , _isEnabled(false)
 , _nodePriorityIndex(0)
+, _inputEventCount(0)
 {
     _toAddedListeners.reserve(50);
     
@@ -789,6 +790,12 @@ void EventDispatcher::dispatchEvent(Event* event)
 {
     if (!_isEnabled)
         return;
+
+    auto type = event->getType();
+    if (type != Event::Type::CUSTOM && type != Event::Type::FOCUS && type != Event::Type::ACCELERATION)
+    {
+        ++_inputEventCount;
+    }
     
     updateDirtyFlagForSceneGraph();
     
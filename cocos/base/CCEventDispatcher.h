@@ -122,6 +122,9 @@ public:
     /** Checks whether dispatching events is enabled */
     bool isEnabled() const;
 
+    /** Number of touch, keyboard, mouse and controller events dispatched so far. The Director compares it between frames to detect an idle scene */
+    unsigned int getInputEventCount() const { return _inputEventCount; }
+
     /////////////////////////////////////////////
     
     /** Dispatches the event
@@ -273,6 +276,9 @@ protected:
     bool _isEnabled;
     
     int _nodePriorityIndex;
+
+    /** Input events dispatched since the creation of the dispatcher */
+    unsigned int _inputEventCount;
     
     std::set<std::string> _internalCustomListenerIDs;
 };
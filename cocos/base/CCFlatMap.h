@@ -0,0 +1,252 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CCFLATMAP_H__
+#define __CCFLATMAP_H__
+
+#include "base/ccMacros.h"
+#include "base/CCRef.h"
+#include <vector>
+#include <algorithm>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup data_structures
+ * @{
+ */
+
+/** Map of Ref objects stored as a vector of pairs sorted by key.
+
+ It retains and releases its values exactly like cocos2d::Map<K, V>. Lookups are binary searches
+ and insertions shift the following pairs, so it suits maps of a few dozen entries at most,
+ which are looked up and iterated far more often than they change.
+ An empty FlatMap doesn't allocate anything, and iterating it walks contiguous memory in key order.
+ */
+template <class K, class V>
+class FlatMap
+{
+public:
+    typedef std::pair<K, V> value_type;
+
+    // ------------------------------------------
+    // Iterators
+    // ------------------------------------------
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    iterator begin() { return _data.begin(); }
+    const_iterator begin() const { return _data.begin(); }
+
+    iterator end() { return _data.end(); }
+    const_iterator end() const { return _data.end(); }
+
+    const_iterator cbegin() const { return _data.cbegin(); }
+    const_iterator cend() const { return _data.cend(); }
+
+    /** Default constructor */
+    FlatMap<K, V>()
+    : _data()
+    {
+        static_assert(std::is_convertible<V, Ref*>::value, "Invalid Type for cocos2d::FlatMap<K, V>!");
+    }
+
+    /** Copy constructor */
+    FlatMap<K, V>(const FlatMap<K, V>& other)
+    : _data(other._data)
+    {
+        addRefForAllObjects();
+    }
+
+    /** Move constructor */
+    FlatMap<K, V>(FlatMap<K, V>&& other)
+    : _data(std::move(other._data))
+    {
+    }
+
+    /** Destructor. It releases all the objects in the map */
+    ~FlatMap<K, V>()
+    {
+        clear();
+    }
+
+    /** Copy assignment operator */
+    FlatMap<K, V>& operator=(const FlatMap<K, V>& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            _data = other._data;
+            addRefForAllObjects();
+        }
+        return *this;
+    }
+
+    /** Move assignment operator */
+    FlatMap<K, V>& operator=(FlatMap<K, V>&& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            _data = std::move(other._data);
+        }
+        return *this;
+    }
+
+    /** Sets capacity of the map */
+    void reserve(ssize_t capacity) { _data.reserve(capacity); }
+
+    /** The number of elements in the map */
+    ssize_t size() const { return _data.size(); }
+
+    /** Returns whether the map is empty */
+    bool empty() const { return _data.empty(); }
+
+    /** Returns all keys in the map, in ascending order */
+    std::vector<K> keys() const
+    {
+        std::vector<K> keys;
+        keys.reserve(_data.size());
+
+        for (const auto& pair : _data)
+        {
+            keys.push_back(pair.first);
+        }
+
+        return keys;
+    }
+
+    /** Returns the object mapped to key, or nullptr */
+    V at(const K& key) const
+    {
+        auto iter = find(key);
+        if (iter != _data.end())
+            return iter->second;
+        return nullptr;
+    }
+
+    /** Returns an iterator to the pair with key, or end() */
+    const_iterator find(const K& key) const
+    {
+        auto iter = lowerBound(key);
+        if (iter != _data.end() && !(key < iter->first))
+            return iter;
+        return _data.end();
+    }
+
+    iterator find(const K& key)
+    {
+        auto iter = lowerBound(key);
+        if (iter != _data.end() && !(key < iter->first))
+            return iter;
+        return _data.end();
+    }
+
+    /** @brief Inserts an object in the map and retains it.
+     *  @note If the map already contains the key, the old object is released and replaced.
+     */
+    void insert(const K& key, V object)
+    {
+        CCASSERT(object != nullptr, "Object is nullptr!");
+        object->retain();
+
+        auto iter = lowerBound(key);
+        if (iter != _data.end() && !(key < iter->first))
+        {
+            iter->second->release();
+            iter->second = object;
+        }
+        else
+        {
+            _data.insert(iter, value_type(key, object));
+        }
+    }
+
+    /** Removes the pair at position and releases its object */
+    iterator erase(const_iterator position)
+    {
+        CCASSERT(position != _data.cend(), "Invalid iterator!");
+        position->second->release();
+        // std::vector::erase(const_iterator) is missing from older standard libraries
+        return _data.erase(_data.begin() + (position - _data.cbegin()));
+    }
+
+    /** Removes the pair with key. Returns the number of pairs removed */
+    size_t erase(const K& key)
+    {
+        auto iter = find(key);
+        if (iter != _data.end())
+        {
+            erase(iter);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    /** Releases and removes all the objects */
+    void clear()
+    {
+        for (auto iter = _data.cbegin(); iter != _data.cend(); ++iter)
+        {
+            iter->second->release();
+        }
+
+        _data.clear();
+    }
+
+protected:
+    const_iterator lowerBound(const K& key) const
+    {
+        return std::lower_bound(_data.begin(), _data.end(), key, [](const value_type& pair, const K& k) {
+            return pair.first < k;
+        });
+    }
+
+    iterator lowerBound(const K& key)
+    {
+        return std::lower_bound(_data.begin(), _data.end(), key, [](const value_type& pair, const K& k) {
+            return pair.first < k;
+        });
+    }
+
+    /** Retains all the objects in the map */
+    void addRefForAllObjects()
+    {
+        for (auto iter = _data.begin(); iter != _data.end(); ++iter)
+        {
+            iter->second->retain();
+        }
+    }
+
+    std::vector<value_type> _data;
+};
+
+// end of data_structures group
+/// @}
+
+NS_CC_END
+
+#endif // __CCFLATMAP_H__
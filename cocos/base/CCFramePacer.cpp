@@ -0,0 +1,200 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "base/CCFramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+NS_CC_BEGIN
+
+namespace
+{
+    // longest sleep between two calls to the wake up function of an idle wait
+    const std::chrono::milliseconds WAKE_UP_PERIOD(8);
+
+    // bounds of the spin at the end of a wait
+    const std::chrono::microseconds MIN_SLEEP_SLACK(100);
+    const std::chrono::microseconds MAX_SLEEP_SLACK(4000);
+
+    float toMilliseconds(FramePacer::Clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(duration).count();
+    }
+}
+
+FramePacer::FramePacer()
+: _interval(1.0 / 60)
+, _idleInterval(0)
+, _idleDelay(1)
+, _currentInterval(1.0 / 60)
+, _started(false)
+, _deadline(Clock::now())
+, _lastActivity(Clock::now())
+, _sleepSlack(std::chrono::microseconds(1000))
+{
+    resetStatistics();
+}
+
+void FramePacer::setInterval(double interval)
+{
+    _interval = _currentInterval = interval;
+    _deadline = Clock::now();
+}
+
+bool FramePacer::isIdle(Clock::time_point now) const
+{
+    return _idleInterval > 0 && now - _lastActivity > std::chrono::duration<double>(_idleDelay);
+}
+
+void FramePacer::beginFrame()
+{
+    auto now = Clock::now();
+    if (_started)
+    {
+        recordFrameTime(toMilliseconds(now - _frameStart));
+    }
+    _started = true;
+    _frameStart = now;
+}
+
+void FramePacer::recordFrameTime(float frameTime)
+{
+    _frameTimes[_frameTimeIndex] = frameTime;
+    _frameTimeIndex = (_frameTimeIndex + 1) % STATISTICS_WINDOW;
+    _frameTimeCount = std::min(_frameTimeCount + 1, (int)STATISTICS_WINDOW);
+
+    double sum = 0;
+    double sumOfSquares = 0;
+    float minTime = frameTime;
+    float maxTime = frameTime;
+    for (int i = 0; i < _frameTimeCount; ++i)
+    {
+        float time = _frameTimes[i];
+        sum += time;
+        sumOfSquares += time * time;
+        minTime = std::min(minTime, time);
+        maxTime = std::max(maxTime, time);
+    }
+
+    double average = sum / _frameTimeCount;
+    double variance = sumOfSquares / _frameTimeCount - average * average;
+
+    _statistics.lastFrameTime = frameTime;
+    _statistics.averageFrameTime = (float)average;
+    _statistics.frameTimeDeviation = (float)std::sqrt(std::max(0.0, variance));
+    _statistics.minFrameTime = minTime;
+    _statistics.maxFrameTime = maxTime;
+    ++_statistics.frameCount;
+    if (frameTime > _currentInterval * 1500)
+    {
+        ++_statistics.lateFrames;
+    }
+}
+
+void FramePacer::waitForNextFrame(const std::function<bool()>& wakeUp)
+{
+    auto now = Clock::now();
+    if (_started)
+    {
+        _statistics.lastWorkTime = toMilliseconds(now - _frameStart);
+    }
+
+    bool idle = isIdle(now);
+    if (idle)
+    {
+        ++_statistics.idleFrames;
+    }
+    _currentInterval = idle ? _idleInterval : _interval;
+    auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(_currentInterval));
+
+    _deadline += interval;
+    if (_deadline <= now)
+    {
+        // more than a frame behind: start again from now rather than running frames back to back
+        if (now - _deadline > interval)
+        {
+            _deadline = now;
+        }
+        return;
+    }
+
+    while (true)
+    {
+        auto remaining = _deadline - Clock::now();
+        if (remaining <= _sleepSlack)
+            break;
+
+        auto sleepTime = remaining - _sleepSlack;
+        if (idle && wakeUp && sleepTime > WAKE_UP_PERIOD)
+        {
+            sleepTime = WAKE_UP_PERIOD;
+        }
+
+        auto sleepStart = Clock::now();
+        std::this_thread::sleep_for(sleepTime);
+        auto overslept = Clock::now() - sleepStart - sleepTime;
+
+        // the slack jumps to the worst recent oversleep and decays slowly
+        if (overslept > _sleepSlack)
+            _sleepSlack = overslept;
+        else
+            _sleepSlack -= (_sleepSlack - overslept) / 16;
+        _sleepSlack = std::max<Clock::duration>(MIN_SLEEP_SLACK, std::min<Clock::duration>(MAX_SLEEP_SLACK, _sleepSlack));
+
+        if (idle && wakeUp && wakeUp())
+        {
+            markActive();
+            _deadline = Clock::now();
+            _statistics.sleepSlack = toMilliseconds(_sleepSlack);
+            return;
+        }
+    }
+
+    while (Clock::now() < _deadline)
+    {
+        std::this_thread::yield();
+    }
+    _statistics.sleepSlack = toMilliseconds(_sleepSlack);
+}
+
+void FramePacer::resetStatistics()
+{
+    _frameTimeIndex = 0;
+    _frameTimeCount = 0;
+    _statistics.lastFrameTime = 0;
+    _statistics.averageFrameTime = 0;
+    _statistics.frameTimeDeviation = 0;
+    _statistics.minFrameTime = 0;
+    _statistics.maxFrameTime = 0;
+    _statistics.lastWorkTime = 0;
+    _statistics.sleepSlack = toMilliseconds(_sleepSlack);
+    _statistics.lateFrames = 0;
+    _statistics.idleFrames = 0;
+    _statistics.frameCount = 0;
+}
+
+NS_CC_END
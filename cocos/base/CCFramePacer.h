@@ -0,0 +1,150 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CCFRAMEPACER_H__
+#define __CCFRAMEPACER_H__
+
+#include <chrono>
+#include <functional>
+
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** @brief Measures the frames of the main loop, and sleeps until the next one is due.
+
+ beginFrame() is called by the Director at the start of every frame and updates the statistics.
+ waitForNextFrame() is called by the main loops that pace themselves, the desktop ones, after a frame.
+ It sleeps most of the remaining time, then spins over the last part, the slack, which follows how late the
+ system wakes the thread up. The deadlines follow each other by one interval, so a late frame is caught up by
+ the next one instead of shifting all the following frames.
+
+ With an idle interval, the loop slows down to it once the Director saw no input and no running action
+ for the idle delay. Updates scheduled with Node::scheduleUpdate() don't keep the loop active: scenes
+ animated that way should not use an idle interval.
+
+ Owned by the Director, see Director::getFramePacer(). Not thread safe, used from the cocos thread.
+ */
+class CC_DLL FramePacer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /** Number of frames the average, deviation, minimum and maximum are computed over */
+    static const int STATISTICS_WINDOW = 120;
+
+    /** Frame times, in milliseconds */
+    struct Statistics
+    {
+        /** Time between the starts of the last two frames */
+        float lastFrameTime;
+        /** Mean of the frame time over the window */
+        float averageFrameTime;
+        /** Standard deviation of the frame time over the window */
+        float frameTimeDeviation;
+        /** Shortest frame of the window */
+        float minFrameTime;
+        /** Longest frame of the window */
+        float maxFrameTime;
+        /** Time the last frame worked, before it waited for the next one */
+        float lastWorkTime;
+        /** Current spin time at the end of the waits */
+        float sleepSlack;
+        /** Frames longer than one interval and a half since the last reset */
+        unsigned int lateFrames;
+        /** Frames paced with the idle interval since the last reset */
+        unsigned int idleFrames;
+        /** Frames since the last reset */
+        unsigned int frameCount;
+    };
+
+    FramePacer();
+
+    /** Time between two frames, in seconds. Set by the Director from its animation interval */
+    void setInterval(double interval);
+    double getInterval() const { return _interval; }
+
+    /** Time between two frames while the scene is idle, in seconds. 0 disables idle pacing, which is the default */
+    void setIdleInterval(double interval) { _idleInterval = interval; }
+    double getIdleInterval() const { return _idleInterval; }
+
+    /** Time without activity after which the scene is idle, in seconds. 1 by default */
+    void setIdleDelay(double delay) { _idleDelay = delay; }
+    double getIdleDelay() const { return _idleDelay; }
+
+    /** Keeps the normal interval for the idle delay from now */
+    void markActive() { _lastActivity = Clock::now(); }
+
+    /** Whether the frames are paced with the idle interval */
+    bool isIdle() const { return isIdle(Clock::now()); }
+
+    /** Starts a frame and records the time since the start of the previous one */
+    void beginFrame();
+
+    /** Sleeps until the next frame is due.
+     While idle, the sleep is cut in short slices, after which wakeUp, if any, is called. When it returns true the
+     wait ends at once and the scene is active again: main loops poll their input events from it.
+     */
+    void waitForNextFrame(const std::function<bool()>& wakeUp = nullptr);
+
+    const Statistics& getStatistics() const { return _statistics; }
+    void resetStatistics();
+
+protected:
+    bool isIdle(Clock::time_point now) const;
+    void recordFrameTime(float frameTime);
+
+    double _interval;
+    double _idleInterval;
+    double _idleDelay;
+    /** interval of the frame being paced, the idle one or not */
+    double _currentInterval;
+
+    bool _started;
+    Clock::time_point _frameStart;
+    Clock::time_point _deadline;
+    Clock::time_point _lastActivity;
+    Clock::duration _sleepSlack;
+
+    float _frameTimes[STATISTICS_WINDOW];
+    int _frameTimeIndex;
+    int _frameTimeCount;
+    Statistics _statistics;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(FramePacer);
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __CCFRAMEPACER_H__
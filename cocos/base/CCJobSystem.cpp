@@ -0,0 +1,420 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "base/CCJobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
+
+NS_CC_BEGIN
+
+// the pool and the index of the worker running on this thread, set once by workerLoop()
+struct CurrentWorker
+{
+    const JobSystem* jobSystem;
+    int index;
+};
+static thread_local CurrentWorker s_currentWorker = { nullptr, -1 };
+
+Job::Job(std::function<void()>&& work, bool mainThread)
+: _work(std::move(work))
+, _mainThread(mainThread)
+, _pendingDependencies(1)
+, _done(false)
+{
+}
+
+JobSystem::JobSystem(int workerCount)
+: _quit(false)
+, _queuedJobs(0)
+, _executedJobs(0)
+, _stolenJobs(0)
+, _waiters(0)
+{
+    start(workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+void JobSystem::setWorkerCount(int workerCount)
+{
+    CCASSERT(getCurrentWorker() < 0, "JobSystem: a worker can't change the number of workers");
+
+    stop();
+    start(workerCount);
+}
+
+void JobSystem::start(int workerCount)
+{
+    if (workerCount <= 0)
+    {
+        workerCount = std::max(2, (int)std::thread::hardware_concurrency() - 1);
+    }
+
+    _quit = false;
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(new Worker());
+    }
+    // the workers look at each other's queues, they are started once all of them exist
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _quit = true;
+    }
+    _wakeUpCondition.notify_all();
+
+    for (auto worker : _workers)
+    {
+        worker->thread.join();
+    }
+    for (auto worker : _workers)
+    {
+        delete worker;
+    }
+    _workers.clear();
+}
+
+int JobSystem::getCurrentWorker() const
+{
+    // not looked up in _workers: their threads may still be being assigned by start()
+    return s_currentWorker.jobSystem == this ? s_currentWorker.index : -1;
+}
+
+JobHandle JobSystem::schedule(std::function<void()> work)
+{
+    return createJob(std::move(work), false, nullptr, 0);
+}
+
+JobHandle JobSystem::schedule(std::function<void()> work, const JobHandle& dependency)
+{
+    return createJob(std::move(work), false, &dependency, 1);
+}
+
+JobHandle JobSystem::schedule(std::function<void()> work, const std::vector<JobHandle>& dependencies)
+{
+    return createJob(std::move(work), false, dependencies.data(), dependencies.size());
+}
+
+JobHandle JobSystem::scheduleOnMainThread(std::function<void()> work, const JobHandle& dependency)
+{
+    return createJob(std::move(work), true, &dependency, 1);
+}
+
+JobHandle JobSystem::scheduleOnMainThread(std::function<void()> work, const std::vector<JobHandle>& dependencies)
+{
+    return createJob(std::move(work), true, dependencies.data(), dependencies.size());
+}
+
+JobHandle JobSystem::parallelFor(ssize_t begin, ssize_t end, ssize_t grainSize, const std::function<void(ssize_t first, ssize_t last)>& body)
+{
+    grainSize = std::max<ssize_t>(1, grainSize);
+
+    // shared by the ranges instead of being copied into each of them
+    auto sharedBody = std::make_shared<std::function<void(ssize_t, ssize_t)>>(body);
+
+    std::vector<JobHandle> ranges;
+    for (ssize_t first = begin; first < end; first += grainSize)
+    {
+        ssize_t last = std::min(first + grainSize, end);
+        ranges.push_back(schedule([sharedBody, first, last]() { (*sharedBody)(first, last); }));
+    }
+
+    return schedule(nullptr, ranges);
+}
+
+void JobSystem::parallelForAndWait(ssize_t begin, ssize_t end, ssize_t grainSize, const std::function<void(ssize_t first, ssize_t last)>& body)
+{
+    grainSize = std::max<ssize_t>(1, grainSize);
+    ssize_t rangeCount = (end - begin + grainSize - 1) / grainSize;
+    if (rangeCount <= 0)
+        return;
+
+    // the ranges are claimed one by one, by the caller and by the helpers
+    struct Ranges
+    {
+        std::function<void(ssize_t, ssize_t)> body;
+        ssize_t begin;
+        ssize_t end;
+        ssize_t grainSize;
+        ssize_t count;
+        std::atomic<ssize_t> next;
+        std::atomic<ssize_t> done;
+        std::mutex mutex;
+        std::condition_variable doneCondition;
+    };
+    auto ranges = std::make_shared<Ranges>();
+    ranges->body = body;
+    ranges->begin = begin;
+    ranges->end = end;
+    ranges->grainSize = grainSize;
+    ranges->count = rangeCount;
+    ranges->next = 0;
+    ranges->done = 0;
+
+    auto runRanges = [](Ranges& r) {
+        ssize_t range;
+        while ((range = r.next.fetch_add(1, std::memory_order_relaxed)) < r.count)
+        {
+            ssize_t first = r.begin + range * r.grainSize;
+            r.body(first, std::min(first + r.grainSize, r.end));
+
+            if (r.done.fetch_add(1, std::memory_order_acq_rel) + 1 == r.count)
+            {
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.doneCondition.notify_all();
+            }
+        }
+    };
+
+    // a helper which starts late finds no range left and returns, the caller doesn't wait for it
+    ssize_t helperCount = std::min<ssize_t>((ssize_t)_workers.size(), rangeCount - 1);
+    for (ssize_t i = 0; i < helperCount; ++i)
+    {
+        schedule([this, ranges, runRanges]() {
+            // wait() on another thread may run the helper, body must not run there
+            if (getCurrentWorker() >= 0)
+                runRanges(*ranges);
+        });
+    }
+
+    runRanges(*ranges);
+
+    std::unique_lock<std::mutex> lock(ranges->mutex);
+    ranges->doneCondition.wait(lock, [&ranges]() { return ranges->done.load(std::memory_order_acquire) == ranges->count; });
+}
+
+JobHandle JobSystem::createJob(std::function<void()>&& work, bool mainThread, const JobHandle* dependencies, size_t count)
+{
+    JobHandle job(new (std::nothrow) Job(std::move(work), mainThread));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const JobHandle& dependency = dependencies[i];
+        if (dependency == nullptr)
+            continue;
+
+        std::lock_guard<std::mutex> lock(dependency->_mutex);
+        if (!dependency->isDone())
+        {
+            job->_pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependency->_dependents.push_back(job);
+        }
+    }
+
+    // drop the reference held while the dependencies were added
+    if (job->_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        submit(job);
+    }
+    return job;
+}
+
+void JobSystem::submit(const JobHandle& job)
+{
+    if (job->_mainThread)
+    {
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread([this, job]() {
+            execute(job);
+        });
+        return;
+    }
+
+    int worker = getCurrentWorker();
+    if (worker >= 0)
+    {
+        std::lock_guard<std::mutex> lock(_workers[worker]->mutex);
+        _workers[worker]->jobs.push_back(job);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(_sharedMutex);
+        _sharedJobs.push_back(job);
+    }
+
+    // counted once queued: a worker seeing the count finds the job
+    _queuedJobs.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _wakeUpCondition.notify_one();
+}
+
+bool JobSystem::takeJob(int worker, JobHandle* job)
+{
+    bool found = false;
+
+    // own queue, newest first: its data is likely still in the cache
+    if (worker >= 0)
+    {
+        std::lock_guard<std::mutex> lock(_workers[worker]->mutex);
+        auto& jobs = _workers[worker]->jobs;
+        if (!jobs.empty())
+        {
+            *job = std::move(jobs.back());
+            jobs.pop_back();
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        std::lock_guard<std::mutex> lock(_sharedMutex);
+        if (!_sharedJobs.empty())
+        {
+            *job = std::move(_sharedJobs.front());
+            _sharedJobs.pop_front();
+            found = true;
+        }
+    }
+
+    // steal the oldest job of another worker
+    int workerCount = (int)_workers.size();
+    for (int i = 1; !found && i <= workerCount; ++i)
+    {
+        int victim = (worker + i) % workerCount;
+        if (victim == worker)
+            continue;
+
+        std::lock_guard<std::mutex> lock(_workers[victim]->mutex);
+        auto& jobs = _workers[victim]->jobs;
+        if (!jobs.empty())
+        {
+            *job = std::move(jobs.front());
+            jobs.pop_front();
+            found = true;
+            _stolenJobs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (found)
+    {
+        _queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return found;
+}
+
+void JobSystem::execute(const JobHandle& job)
+{
+    if (job->_work)
+    {
+        job->_work();
+        job->_work = nullptr;
+    }
+    _executedJobs.fetch_add(1, std::memory_order_relaxed);
+
+    finish(job);
+}
+
+void JobSystem::finish(const JobHandle& job)
+{
+    std::vector<JobHandle> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->_mutex);
+        job->_done.store(true, std::memory_order_release);
+        dependents.swap(job->_dependents);
+    }
+
+    for (const auto& dependent : dependents)
+    {
+        if (dependent->_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            submit(dependent);
+        }
+    }
+
+    if (_waiters.load(std::memory_order_acquire) > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_doneMutex);
+        }
+        _doneCondition.notify_all();
+    }
+}
+
+void JobSystem::wait(const JobHandle& job)
+{
+    if (job == nullptr)
+        return;
+
+    int worker = getCurrentWorker();
+    _waiters.fetch_add(1, std::memory_order_acq_rel);
+
+    while (!job->isDone())
+    {
+        // help instead of sleeping
+        JobHandle other;
+        if (takeJob(worker, &other))
+        {
+            execute(other);
+            continue;
+        }
+
+        // woken up when a job ends, the timeout picks up the jobs queued meanwhile
+        std::unique_lock<std::mutex> lock(_doneMutex);
+        _doneCondition.wait_for(lock, std::chrono::milliseconds(1), [&job]() { return job->isDone(); });
+    }
+
+    _waiters.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::workerLoop(int worker)
+{
+    s_currentWorker.jobSystem = this;
+    s_currentWorker.index = worker;
+
+    while (true)
+    {
+        JobHandle job;
+        if (takeJob(worker, &job))
+        {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        if (_quit && _queuedJobs.load(std::memory_order_acquire) == 0)
+            return;
+
+        _wakeUpCondition.wait(lock, [this]() {
+            return _quit || _queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,201 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CCJOBSYSTEM_H__
+#define __CCJOBSYSTEM_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+class JobSystem;
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** @brief A unit of work scheduled on a JobSystem. Jobs are referenced through JobHandle */
+class CC_DLL Job
+{
+public:
+    /** Whether the job has run. Thread safe */
+    bool isDone() const { return _done.load(std::memory_order_acquire); }
+
+    /** Whether the job runs on the cocos thread */
+    bool isMainThreadJob() const { return _mainThread; }
+
+CC_CONSTRUCTOR_ACCESS:
+    Job(std::function<void()>&& work, bool mainThread);
+
+protected:
+    std::function<void()> _work;
+    bool _mainThread;
+    /** unfinished dependencies, plus one until the job is submitted */
+    std::atomic<int> _pendingDependencies;
+    std::atomic<bool> _done;
+
+    /** jobs waiting for this one, guarded by _mutex */
+    std::mutex _mutex;
+    std::vector<std::shared_ptr<Job>> _dependents;
+
+    friend class JobSystem;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(Job);
+};
+
+typedef std::shared_ptr<Job> JobHandle;
+
+/** @brief Runs jobs on a pool of worker threads.
+
+ Each worker owns a queue. A job scheduled by a worker goes to the back of its own queue and the worker takes
+ its jobs from the back, while idle workers steal from the front of the other queues. Jobs scheduled by other
+ threads go to a shared queue.
+
+ A job may depend on other jobs, it is queued once all of them have run. Jobs scheduled with
+ scheduleOnMainThread() run on the cocos thread, through Scheduler::performFunctionInCocosThread(), which
+ makes them the continuations of the work done in the background.
+
+ The jobs of a JobSystem may block briefly, to read a file, but they then hold a worker: split long work into
+ several jobs, and don't run endless loops in them. Transfers that can wait on a server for seconds, like the
+ requests of HttpClient, keep their own threads.
+
+ The JobSystem of the engine is owned by the Director, see Director::getJobSystem(). The parallel visit of the
+ scene runs on it too, see ParallelVisitor.
+ */
+class CC_DLL JobSystem
+{
+public:
+    /** Starts the workers. 0 starts one worker per core but one, and at least two */
+    explicit JobSystem(int workerCount = 0);
+    /** Runs the queued jobs, then stops the workers */
+    ~JobSystem();
+
+    /** Runs the queued jobs, then restarts the pool with another number of workers.
+     Call it from a thread which is not a worker. 0 picks the count as the constructor does.
+     */
+    void setWorkerCount(int workerCount);
+    int getWorkerCount() const { return (int)_workers.size(); }
+    /** Index of the calling thread among the workers, -1 if it is not a worker */
+    int getCurrentWorker() const;
+    /** Id of the thread of a worker, until the next setWorkerCount() */
+    std::thread::id getWorkerThreadID(int worker) const { return _workers[worker]->thread.get_id(); }
+
+    /** Schedules a job on a worker */
+    JobHandle schedule(std::function<void()> work);
+    /** Schedules a job on a worker, once dependency has run. dependency may be null */
+    JobHandle schedule(std::function<void()> work, const JobHandle& dependency);
+    /** Schedules a job on a worker, once every dependency has run. Null dependencies are ignored */
+    JobHandle schedule(std::function<void()> work, const std::vector<JobHandle>& dependencies);
+
+    /** Schedules a job on the cocos thread, once dependency has run. dependency may be null */
+    JobHandle scheduleOnMainThread(std::function<void()> work, const JobHandle& dependency = nullptr);
+    /** Schedules a job on the cocos thread, once every dependency has run */
+    JobHandle scheduleOnMainThread(std::function<void()> work, const std::vector<JobHandle>& dependencies);
+
+    /** Calls body(first, last) on the workers for consecutive ranges of [begin, end) of at most grainSize indices.
+     @return A job which is done once every range was processed.
+     */
+    JobHandle parallelFor(ssize_t begin, ssize_t end, ssize_t grainSize, const std::function<void(ssize_t first, ssize_t last)>& body);
+
+    /** Calls body(first, last) for consecutive ranges of [begin, end) of at most grainSize indices, on the calling
+     thread and on the idle workers, and returns once every range was processed.
+     Unlike wait(), the calling thread runs no other job meanwhile: a long job of the queue can't hold it.
+     body only runs on the calling thread and on the workers.
+     */
+    void parallelForAndWait(ssize_t begin, ssize_t end, ssize_t grainSize, const std::function<void(ssize_t first, ssize_t last)>& body);
+
+    /** Runs queued jobs on the calling thread until job is done.
+     Don't wait from the cocos thread for a job which depends on a main thread job: it would never run.
+     */
+    void wait(const JobHandle& job);
+
+    /** Number of jobs queued and not started yet */
+    ssize_t getQueuedJobCount() const { return _queuedJobs.load(std::memory_order_relaxed); }
+    /** Number of jobs run by the workers or by wait() since the creation of the pool */
+    uint64_t getExecutedJobCount() const { return _executedJobs.load(std::memory_order_relaxed); }
+    /** Number of jobs a worker took from the queue of another worker */
+    uint64_t getStolenJobCount() const { return _stolenJobs.load(std::memory_order_relaxed); }
+
+protected:
+    struct Worker
+    {
+        std::thread thread;
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    JobHandle createJob(std::function<void()>&& work, bool mainThread, const JobHandle* dependencies, size_t count);
+    /** Called when the last dependency of a job has run */
+    void submit(const JobHandle& job);
+    void finish(const JobHandle& job);
+    void execute(const JobHandle& job);
+
+    /** Takes a job from the queue of the worker, then from the shared queue, then from the other workers */
+    bool takeJob(int worker, JobHandle* job);
+
+    void start(int workerCount);
+    void stop();
+    void workerLoop(int worker);
+
+    std::vector<Worker*> _workers;
+
+    std::mutex _sharedMutex;
+    std::deque<JobHandle> _sharedJobs;
+
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUpCondition;
+    bool _quit;
+
+    std::atomic<ssize_t> _queuedJobs;
+    std::atomic<uint64_t> _executedJobs;
+    std::atomic<uint64_t> _stolenJobs;
+
+    // threads blocked in wait()
+    std::atomic<int> _waiters;
+    std::mutex _doneMutex;
+    std::condition_variable _doneCondition;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(JobSystem);
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __CCJOBSYSTEM_H__
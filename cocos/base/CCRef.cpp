@@ -136,7 +136,11 @@ void Ref::release()
 
 Ref* Ref::autorelease()
 {
+#if CC_ENABLE_AUTORELEASE_TRACKING
+    PoolManager::getInstance()->getCurrentPool()->addObject(this, CC_RETURN_ADDRESS());
+#else
     PoolManager::getInstance()->getCurrentPool()->addObject(this);
+#endif
     return this;
 }
 
@@ -32,6 +32,8 @@ THE SOFTWARE.
 #include "base/ccCArray.h"
 #include "base/CCScriptSupport.h"
 
+#include <algorithm>
+
 NS_CC_BEGIN
 
 // data structures
@@ -65,6 +67,7 @@ typedef struct _hashSelectorEntry
     Timer               *currentTimer;
     bool                currentTimerSalvaged;
     bool                paused;
+    double              pausedSince;   // time of the scheduler clock when the target was paused
     UT_hash_handle      hh;
 } tHashTimerEntry;
 
@@ -79,6 +82,9 @@ Timer::Timer()
 , _repeat(0)
 , _delay(0.0f)
 , _interval(0.0f)
+, _lastUpdateTime(0.0)
+, _queueGeneration(0)
+, _queued(false)
 {
 }
 
@@ -146,6 +152,16 @@ void Timer::update(float dt)
 }
 
 
+float Timer::getTimeToTrigger() const
+{
+    if (_elapsed == -1)
+    {
+        return 0;
+    }
+
+    return (_useDelay ? _delay : _interval) - _elapsed;
+}
+
 // TimerTargetSelector
 
 TimerTargetSelector::TimerTargetSelector()
@@ -252,20 +268,23 @@ Scheduler::Scheduler(void)
 , _updatesPosList(nullptr)
 , _hashForUpdates(nullptr)
 , _hashForTimers(nullptr)
+, _staleTimerEntries(0)
+, _timerSequence(0)
+, _timerClock(0.0)
 , _currentTarget(nullptr)
 , _currentTargetSalvaged(false)
 , _updateHashLocked(false)
 #if CC_ENABLE_SCRIPT_BINDING
 , _scriptHandlerEntries(20)
 #endif
+, _performTimeBudget(0)
 {
-    // I don't expect to have more than 30 functions to all per frame
-    _functionsToPerform.reserve(30);
 }
 
 Scheduler::~Scheduler(void)
 {
     unscheduleAll();
+    clearTimerQueue();
 }
 
 void Scheduler::removeHashElement(_hashSelectorEntry *element)
@@ -275,6 +294,161 @@ void Scheduler::removeHashElement(_hashSelectorEntry *element)
     free(element);
 }
 
+bool Scheduler::timerFiresLater(const TimerQueueEntry& a, const TimerQueueEntry& b)
+{
+    // std heaps keep their greatest element first, the next timer to fire must be the greatest
+    if (a.fireTime != b.fireTime)
+    {
+        return a.fireTime > b.fireTime;
+    }
+    return a.sequence > b.sequence;
+}
+
+void Scheduler::queueTimer(Timer *timer, void *target)
+{
+    CCASSERT(!timer->_queued, "The timer is already queued");
+
+    TimerQueueEntry entry;
+    entry.fireTime = timer->_lastUpdateTime + std::max(0.0f, timer->getTimeToTrigger());
+    entry.sequence = _timerSequence++;
+    entry.generation = timer->_queueGeneration;
+    entry.timer = timer;
+    entry.target = target;
+
+    timer->retain();
+    timer->_queued = true;
+
+    _timerQueue.push_back(entry);
+    std::push_heap(_timerQueue.begin(), _timerQueue.end(), timerFiresLater);
+}
+
+void Scheduler::dequeueTimer(Timer *timer)
+{
+    // the entry is left in the heap, and dropped when it reaches the top
+    timer->_queueGeneration++;
+
+    if (timer->_queued)
+    {
+        timer->_queued = false;
+
+        // don't let the entries of timers scheduled and unscheduled over and over pile up
+        if (++_staleTimerEntries > 64 && _staleTimerEntries > _timerQueue.size() / 2)
+        {
+            compactTimerQueue();
+        }
+    }
+}
+
+void Scheduler::compactTimerQueue()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < _timerQueue.size(); ++i)
+    {
+        const TimerQueueEntry entry = _timerQueue[i];
+        if (entry.generation == entry.timer->_queueGeneration)
+        {
+            _timerQueue[kept++] = entry;
+        }
+        else
+        {
+            entry.timer->release();
+        }
+    }
+
+    _timerQueue.resize(kept);
+    std::make_heap(_timerQueue.begin(), _timerQueue.end(), timerFiresLater);
+    _staleTimerEntries = 0;
+}
+
+void Scheduler::clearTimerQueue()
+{
+    for (const auto& entry : _timerQueue)
+    {
+        entry.timer->_queued = false;
+        entry.timer->release();
+    }
+    _timerQueue.clear();
+    _staleTimerEntries = 0;
+}
+
+void Scheduler::fireTimer(Timer *timer, void *target)
+{
+    tHashTimerEntry *element = nullptr;
+    HASH_FIND_PTR(_hashForTimers, &target, element);
+    CCASSERT(element && !element->paused, "Only the timers of running targets are queued");
+    if (!element)
+    {
+        return;
+    }
+
+    _currentTarget = element;
+    _currentTargetSalvaged = false;
+    element->currentTimer = timer;
+    element->currentTimerSalvaged = false;
+
+    unsigned int generation = timer->_queueGeneration;
+    float dt = static_cast<float>(_timerClock - timer->_lastUpdateTime);
+    timer->_lastUpdateTime = _timerClock;
+    timer->update(dt);
+
+    // neither unscheduled nor queued again by a pause and a resume of its target
+    if (timer->_queueGeneration == generation)
+    {
+        queueTimer(timer, target);
+    }
+
+    if (element->currentTimerSalvaged)
+    {
+        // The currentTimer told the remove itself. To prevent the timer from
+        // accidentally deallocating itself before finishing its step, we retained
+        // it. Now that step is done, it's safe to release it.
+        timer->release();
+    }
+    element->currentTimer = nullptr;
+
+    // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
+    if (_currentTargetSalvaged && element->timers->num == 0)
+    {
+        removeHashElement(element);
+    }
+    _currentTarget = nullptr;
+}
+
+void Scheduler::pauseTimers(_hashSelectorEntry *element)
+{
+    if (element->paused)
+    {
+        return;
+    }
+
+    element->paused = true;
+    element->pausedSince = _timerClock;
+
+    for (int i = 0; i < element->timers->num; ++i)
+    {
+        dequeueTimer(static_cast<Timer*>(element->timers->arr[i]));
+    }
+}
+
+void Scheduler::resumeTimers(_hashSelectorEntry *element)
+{
+    if (!element->paused)
+    {
+        return;
+    }
+
+    element->paused = false;
+
+    // the time spent paused doesn't count
+    double pausedTime = _timerClock - element->pausedSince;
+    for (int i = 0; i < element->timers->num; ++i)
+    {
+        Timer* timer = static_cast<Timer*>(element->timers->arr[i]);
+        timer->_lastUpdateTime += pausedTime;
+        queueTimer(timer, element->target);
+    }
+}
+
 void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, bool paused, const std::string& key)
 {
     this->schedule(callback, target, interval, kRepeatForever, 0.0f, paused, key);
@@ -297,6 +471,7 @@ void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float in
 
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
         element->paused = paused;
+        element->pausedSince = _timerClock;
     }
     else
     {
@@ -317,6 +492,12 @@ void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float in
             {
                 CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
                 timer->setInterval(interval);
+                if (! element->paused)
+                {
+                    // the timer fires at another time
+                    dequeueTimer(timer);
+                    queueTimer(timer, target);
+                }
                 return;
             }        
         }
@@ -326,6 +507,10 @@ void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float in
     TimerTargetCallback *timer = new TimerTargetCallback();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
     ccArrayAppendObject(element->timers, timer);
+    if (! element->paused)
+    {
+        queueTimer(timer, target);
+    }
     timer->release();
 }
 
@@ -357,6 +542,7 @@ void Scheduler::unschedule(const std::string &key, void *target)
                     element->currentTimerSalvaged = true;
                 }
 
+                dequeueTimer(timer);
                 ccArrayRemoveObjectAtIndex(element->timers, i, true);
 
                 // update timerIndex in case we are in tick:, looping over the actions
@@ -652,6 +838,10 @@ void Scheduler::unscheduleAllForTarget(void *target)
             element->currentTimer->retain();
             element->currentTimerSalvaged = true;
         }
+        for (int i = 0; i < element->timers->num; ++i)
+        {
+            dequeueTimer(static_cast<Timer*>(element->timers->arr[i]));
+        }
         ccArrayRemoveAllObjects(element->timers);
 
         if (_currentTarget == element)
@@ -700,7 +890,7 @@ void Scheduler::resumeTarget(void *target)
     HASH_FIND_PTR(_hashForTimers, &target, element);
     if (element)
     {
-        element->paused = false;
+        resumeTimers(element);
     }
 
     // update selector
@@ -722,7 +912,7 @@ void Scheduler::pauseTarget(void *target)
     HASH_FIND_PTR(_hashForTimers, &target, element);
     if (element)
     {
-        element->paused = true;
+        pauseTimers(element);
     }
 
     // update selector
@@ -771,7 +961,7 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     for(tHashTimerEntry *element = _hashForTimers; element != nullptr;
         element = (tHashTimerEntry*)element->hh.next)
     {
-        element->paused = true;
+        pauseTimers(element);
         idsWithSelectors.insert(element->target);
     }
 
@@ -819,11 +1009,7 @@ void Scheduler::resumeTargets(const std::set<void*>& targetsToResume)
 
 void Scheduler::performFunctionInCocosThread(const std::function<void ()> &function)
 {
-    _performMutex.lock();
-
-    _functionsToPerform.push_back(function);
-
-    _performMutex.unlock();
+    _functionsToPerform.push(function);
 }
 
 // main loop
@@ -870,44 +1056,38 @@ void Scheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (tHashTimerEntry *elt = _hashForTimers; elt != nullptr; )
+    // Fire the custom selectors that are due. The others are not looked at
+    _timerClock += dt;
+
+    while (!_timerQueue.empty() && _timerQueue.front().fireTime <= _timerClock)
     {
-        _currentTarget = elt;
-        _currentTargetSalvaged = false;
+        std::pop_heap(_timerQueue.begin(), _timerQueue.end(), timerFiresLater);
+        TimerQueueEntry entry = _timerQueue.back();
+        _timerQueue.pop_back();
 
-        if (! _currentTarget->paused)
+        if (entry.generation == entry.timer->_queueGeneration)
         {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers->num; ++(elt->timerIndex))
-            {
-                elt->currentTimer = (Timer*)(elt->timers->arr[elt->timerIndex]);
-                elt->currentTimerSalvaged = false;
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimerSalvaged)
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
-            }
+            entry.timer->_queued = false;
+            _dueTimers.push_back(entry);
         }
+        else
+        {
+            _staleTimerEntries--;
+            entry.timer->release();
+        }
+    }
 
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashTimerEntry *)elt->hh.next;
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers->num == 0)
+    // The due timers are all collected first: the timers firing every frame are queued again for the next update
+    for (const auto& entry : _dueTimers)
+    {
+        // unless a timer that fired before unscheduled it or paused its target
+        if (entry.generation == entry.timer->_queueGeneration)
         {
-            removeHashElement(_currentTarget);
+            fireTimer(entry.timer, entry.target);
         }
+        entry.timer->release();
     }
+    _dueTimers.clear();
 
     // delete all updates that are marked for deletion
     // updates with priority < 0
@@ -966,18 +1146,10 @@ void Scheduler::update(float dt)
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
-    // And almost never there will be functions scheduled to be called.
-    if( !_functionsToPerform.empty() ) {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if new functions are added in callback, it will cause thread deadlock.
-        auto temp = _functionsToPerform;
-        _functionsToPerform.clear();
-        _performMutex.unlock();
-        for( const auto &function : temp ) {
-            function();
-        }
-        
+    // Almost never there will be functions scheduled to be called.
+    // Functions added by these callbacks are run on the next frame.
+    if( !_functionsToPerform.isEmpty() ) {
+        _functionsToPerform.run(-1, _performTimeBudget);
     }
 }
 
@@ -997,6 +1169,7 @@ void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, uns
         
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
         element->paused = paused;
+        element->pausedSince = _timerClock;
     }
     else
     {
@@ -1017,6 +1190,12 @@ void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, uns
             {
                 CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
                 timer->setInterval(interval);
+                if (! element->paused)
+                {
+                    // the timer fires at another time
+                    dequeueTimer(timer);
+                    queueTimer(timer, target);
+                }
                 return;
             }
         }
@@ -1026,6 +1205,10 @@ void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, uns
     TimerTargetSelector *timer = new TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
     ccArrayAppendObject(element->timers, timer);
+    if (! element->paused)
+    {
+        queueTimer(timer, target);
+    }
     timer->release();
 }
 
@@ -1097,6 +1280,7 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Ref *target)
                     element->currentTimerSalvaged = true;
                 }
                 
+                dequeueTimer(timer);
                 ccArrayRemoveObjectAtIndex(element->timers, i, true);
                 
                 // update timerIndex in case we are in tick:, looping over the actions
@@ -31,8 +31,10 @@ THE SOFTWARE.
 #include <functional>
 #include <mutex>
 #include <set>
+#include <vector>
 
 #include "base/CCRef.h"
+#include "base/CCTaskQueue.h"
 #include "base/CCVector.h"
 #include "base/uthash.h"
 
@@ -70,7 +72,9 @@ public:
     void update(float dt);
     
 protected:
-    
+    /** Time left before the timer triggers, 0 if it was never updated */
+    float getTimeToTrigger() const;
+
     Scheduler* _scheduler; // weak ref
     float _elapsed;
     bool _runForever;
@@ -79,6 +83,15 @@ protected:
     unsigned int _repeat; //0 = once, 1 is 2 x executed
     float _delay;
     float _interval;
+
+    // time of the Scheduler clock when the timer was last updated
+    double _lastUpdateTime;
+    // incremented when the timer leaves the queue of the Scheduler, entries of other generations are ignored
+    unsigned int _queueGeneration;
+    // whether the queue of the Scheduler holds an entry of the current generation
+    bool _queued;
+
+    friend class Scheduler;
 };
 
 
@@ -363,6 +376,17 @@ public:
      @since v3.0
      */
     void performFunctionInCocosThread( const std::function<void()> &function);
+
+    /** Limits the time spent each frame running the functions given to performFunctionInCocosThread().
+     Once the budget is spent, the remaining functions run on the next frames. At least one function runs per frame.
+     0, the default, runs every pending function.
+     @param seconds The budget, in seconds.
+     */
+    void setPerformFunctionsTimeBudget(float seconds) { _performTimeBudget = seconds; }
+    float getPerformFunctionsTimeBudget() const { return _performTimeBudget; }
+
+    /** The queue of the functions given to performFunctionInCocosThread(), for its depth and counters */
+    const TaskQueue& getPerformFunctionQueue() const { return _functionsToPerform; }
     
     /////////////////////////////////////
     
@@ -436,6 +460,15 @@ protected:
     void priorityIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused);
     void appendIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused);
 
+    // interval timers specific
+    void queueTimer(Timer *timer, void *target);
+    void dequeueTimer(Timer *timer);
+    void fireTimer(Timer *timer, void *target);
+    void pauseTimers(struct _hashSelectorEntry *element);
+    void resumeTimers(struct _hashSelectorEntry *element);
+    void compactTimerQueue();
+    void clearTimerQueue();
+
 
     float _timeScale;
 
@@ -449,6 +482,26 @@ protected:
 
     // Used for "selectors with interval"
     struct _hashSelectorEntry *_hashForTimers;
+
+    // The timers of the targets that are not paused, as a min-heap ordered by the time they fire next.
+    // Only the timers that are due are updated, instead of every timer every frame
+    struct TimerQueueEntry
+    {
+        double fireTime;
+        // timers due at the same time fire in the order they were queued
+        unsigned int sequence;
+        unsigned int generation;
+        Timer *timer;   // retained
+        void *target;
+    };
+    std::vector<TimerQueueEntry> _timerQueue;
+    static bool timerFiresLater(const TimerQueueEntry& a, const TimerQueueEntry& b);
+    std::vector<TimerQueueEntry> _dueTimers;
+    // entries of timers that were unscheduled, paused or changed since they were queued
+    size_t _staleTimerEntries;
+    unsigned int _timerSequence;
+    // scaled time elapsed since the Scheduler was created
+    double _timerClock;
     struct _hashSelectorEntry *_currentTarget;
     bool _currentTargetSalvaged;
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
@@ -459,8 +512,8 @@ protected:
 #endif
     
     // Used for "perform Function"
-    std::vector<std::function<void()>> _functionsToPerform;
-    std::mutex _performMutex;
+    TaskQueue _functionsToPerform;
+    float _performTimeBudget;
 };
 
 // end of global group
@@ -0,0 +1,388 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CCSMALLVECTOR_H__
+#define __CCSMALLVECTOR_H__
+
+#include "base/ccMacros.h"
+#include "base/CCRef.h"
+#include <algorithm> // for std::find
+#include <iterator>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup data_structures
+ * @{
+ */
+
+/** Vector of Ref objects that keeps its first N elements inside the object itself.
+
+ It retains and releases its elements exactly like cocos2d::Vector<T>, but it only
+ allocates memory once it holds more than N elements. Iterators are plain pointers,
+ so iterating never goes through std::vector and the elements of a small vector
+ sit right next to its owner.
+ Use it for members that usually hold a handful of objects and are not exposed as Vector<T>.
+ */
+template<class T, int N>
+class SmallVector
+{
+public:
+    // ------------------------------------------
+    // Iterators
+    // ------------------------------------------
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    iterator begin() { return _data; }
+    const_iterator begin() const { return _data; }
+
+    iterator end() { return _data + _size; }
+    const_iterator end() const { return _data + _size; }
+
+    const_iterator cbegin() const { return _data; }
+    const_iterator cend() const { return _data + _size; }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    /** Constructor */
+    SmallVector()
+    : _data(_inline)
+    , _size(0)
+    , _capacity(N)
+    {
+        static_assert(std::is_convertible<T, Ref*>::value, "Invalid Type for cocos2d::SmallVector<T, N>!");
+        static_assert(N > 0, "SmallVector needs an inline capacity");
+    }
+
+    /** Destructor */
+    ~SmallVector()
+    {
+        clear();
+        freeStorage();
+    }
+
+    /** Copy constructor */
+    SmallVector(const SmallVector& other)
+    : _data(_inline)
+    , _size(0)
+    , _capacity(N)
+    {
+        reserve(other._size);
+        std::copy(other.begin(), other.end(), _data);
+        _size = other._size;
+        addRefForAllObjects();
+    }
+
+    /** Move constructor */
+    SmallVector(SmallVector&& other)
+    : _data(_inline)
+    , _size(0)
+    , _capacity(N)
+    {
+        steal(other);
+    }
+
+    /** Copy assignment operator */
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            reserve(other._size);
+            std::copy(other.begin(), other.end(), _data);
+            _size = other._size;
+            addRefForAllObjects();
+        }
+        return *this;
+    }
+
+    /** Move assignment operator */
+    SmallVector& operator=(SmallVector&& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            freeStorage();
+            steal(other);
+        }
+        return *this;
+    }
+
+    /** Makes room for n elements. Nothing is allocated while n is not greater than N */
+    void reserve(ssize_t n)
+    {
+        if (n > _capacity)
+        {
+            T* data = new T[n];
+            std::copy(begin(), end(), data);
+            freeStorage();
+            _data = data;
+            _capacity = n;
+        }
+    }
+
+    /** Number of elements the vector can hold without allocating */
+    ssize_t capacity() const { return _capacity; }
+
+    /** Returns the number of elements in the vector */
+    ssize_t size() const { return _size; }
+
+    /** Returns whether the vector is empty */
+    bool empty() const { return _size == 0; }
+
+    /** Returns whether the elements are still stored inside the vector itself */
+    bool isInline() const { return _data == _inline; }
+
+    /** Returns index of a certain object, -1 if the vector doesn't contain the object */
+    ssize_t getIndex(T object) const
+    {
+        auto iter = std::find(begin(), end(), object);
+        if (iter != end())
+            return iter - begin();
+
+        return -1;
+    }
+
+    /** Returns an iterator to the first element equal to object, or end() */
+    const_iterator find(T object) const { return std::find(begin(), end(), object); }
+    iterator find(T object) { return std::find(begin(), end(), object); }
+
+    /** Returns the element at position 'index' in the vector */
+    T at(ssize_t index) const
+    {
+        CCASSERT(index >= 0 && index < _size, "index out of range in at()");
+        return _data[index];
+    }
+
+    /** Returns the first element in the vector */
+    T front() const { return at(0); }
+
+    /** Returns the last element of the vector */
+    T back() const { return at(_size - 1); }
+
+    /** Returns a Boolean value that indicates whether object is present in vector */
+    bool contains(T object) const { return find(object) != end(); }
+
+    // Adds objects
+
+    /** Adds an element at the end of the vector and retains it */
+    void pushBack(T object)
+    {
+        CCASSERT(object != nullptr, "The object should not be nullptr");
+        grow();
+        _data[_size++] = object;
+        object->retain();
+    }
+
+    /** Inserts an element at a certain index and retains it */
+    void insert(ssize_t index, T object)
+    {
+        CCASSERT(index >= 0 && index <= _size, "Invalid index!");
+        CCASSERT(object != nullptr, "The object should not be nullptr");
+        grow();
+        std::copy_backward(_data + index, _data + _size, _data + _size + 1);
+        _data[index] = object;
+        _size++;
+        object->retain();
+    }
+
+    // Removes Objects
+
+    /** Removes the last element and releases it */
+    void popBack()
+    {
+        CCASSERT(_size > 0, "no objects added");
+        _data[--_size]->release();
+    }
+
+    /** @brief Removes a certain object from the vector.
+     *  @param removeAll Whether to remove all elements with the same value, or just the first one.
+     */
+    void eraseObject(T object, bool removeAll = false)
+    {
+        CCASSERT(object != nullptr, "The object should not be nullptr");
+
+        auto iter = find(object);
+        while (iter != end())
+        {
+            iter = erase(iter);
+            if (!removeAll)
+                break;
+            iter = std::find(iter, end(), object);
+        }
+    }
+
+    /** Removes the element at position and releases it. Returns the position of the element that followed it */
+    iterator erase(iterator position)
+    {
+        CCASSERT(position >= begin() && position < end(), "Invalid position!");
+        (*position)->release();
+        std::copy(position + 1, end(), position);
+        _size--;
+        return position;
+    }
+
+    /** Removes the elements in [first, last) and releases them */
+    iterator erase(iterator first, iterator last)
+    {
+        for (auto iter = first; iter != last; ++iter)
+        {
+            (*iter)->release();
+        }
+        std::copy(last, end(), first);
+        _size -= (last - first);
+        return first;
+    }
+
+    /** Removes the element at index and releases it */
+    iterator erase(ssize_t index)
+    {
+        CCASSERT(index >= 0 && index < _size, "Invalid index!");
+        return erase(begin() + index);
+    }
+
+    /** Releases and removes all the elements. The memory is kept for the next elements */
+    void clear()
+    {
+        for (auto iter = begin(); iter != end(); ++iter)
+        {
+            (*iter)->release();
+        }
+        _size = 0;
+    }
+
+    // Rearranging Content
+
+    /** Swap two elements */
+    void swap(T object1, T object2)
+    {
+        ssize_t idx1 = getIndex(object1);
+        ssize_t idx2 = getIndex(object2);
+
+        CCASSERT(idx1 >= 0 && idx2 >= 0, "invalid object index");
+
+        std::swap(_data[idx1], _data[idx2]);
+    }
+
+    /** Swap two elements with certain indexes */
+    void swap(ssize_t index1, ssize_t index2)
+    {
+        CCASSERT(index1 >= 0 && index1 < _size && index2 >= 0 && index2 < _size, "Invalid indices");
+
+        std::swap(_data[index1], _data[index2]);
+    }
+
+    /** Replace object at index with another object */
+    void replace(ssize_t index, T object)
+    {
+        CCASSERT(index >= 0 && index < _size, "Invalid index!");
+        CCASSERT(object != nullptr, "The object should not be nullptr");
+
+        object->retain();
+        _data[index]->release();
+        _data[index] = object;
+    }
+
+    /** Reverses the vector */
+    void reverse()
+    {
+        std::reverse(begin(), end());
+    }
+
+    /** Moves the elements back inside the vector when they fit, or to a buffer of the exact size */
+    void shrinkToFit()
+    {
+        if (isInline() || _size == _capacity)
+            return;
+
+        T* data = _size > N ? new T[_size] : _inline;
+        std::copy(begin(), end(), data);
+        freeStorage();
+        _data = data;
+        _capacity = _size > N ? _size : N;
+    }
+
+protected:
+    void grow()
+    {
+        if (_size == _capacity)
+            reserve(_capacity * 2);
+    }
+
+    void freeStorage()
+    {
+        if (_data != _inline)
+            delete [] _data;
+        _data = _inline;
+        _capacity = N;
+    }
+
+    /** Takes the elements of other without retaining them again. other is left empty */
+    void steal(SmallVector& other)
+    {
+        if (other.isInline())
+        {
+            std::copy(other.begin(), other.end(), _inline);
+        }
+        else
+        {
+            _data = other._data;
+            _capacity = other._capacity;
+            other._data = other._inline;
+            other._capacity = N;
+        }
+        _size = other._size;
+        other._size = 0;
+    }
+
+    /** Retains all the objects in the vector */
+    void addRefForAllObjects()
+    {
+        for (auto iter = begin(); iter != end(); ++iter)
+        {
+            (*iter)->retain();
+        }
+    }
+
+    T* _data;
+    ssize_t _size;
+    ssize_t _capacity;
+    T _inline[N];
+};
+
+// end of data_structures group
+/// @}
+
+NS_CC_END
+
+#endif // __CCSMALLVECTOR_H__
@@ -0,0 +1,262 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "base/CCTaskQueue.h"
+
+#include <chrono>
+
+NS_CC_BEGIN
+
+TaskQueue::Node::Node()
+: next(nullptr)
+, nextFree(0)
+, slot(INVALID_SLOT)
+{
+}
+
+TaskQueue::TaskQueue()
+: _head(&_stub)
+, _tail(&_stub)
+, _reservedSlots(0)
+, _freeHead(0)
+, _size(0)
+, _peakSize(0)
+, _pushedCount(0)
+, _runCount(0)
+, _lastRunCount(0)
+{
+    for (auto& block : _blocks)
+    {
+        block.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+TaskQueue::~TaskQueue()
+{
+    clear();
+
+    for (auto& block : _blocks)
+    {
+        delete [] block.load(std::memory_order_relaxed);
+    }
+}
+
+ssize_t TaskQueue::getPoolSize() const
+{
+    uint32_t reserved = _reservedSlots.load(std::memory_order_relaxed);
+    return MIN(reserved, (uint32_t)(BLOCK_SIZE * MAX_BLOCKS));
+}
+
+TaskQueue::Node* TaskQueue::nodeAt(uint32_t slot) const
+{
+    return _blocks[slot / BLOCK_SIZE].load(std::memory_order_acquire) + slot % BLOCK_SIZE;
+}
+
+TaskQueue::Node* TaskQueue::allocNode()
+{
+    // reuse a free node
+    uint64_t head = _freeHead.load(std::memory_order_acquire);
+    while ((uint32_t)head != 0)
+    {
+        Node* node = nodeAt((uint32_t)head - 1);
+        // the node may be taken by another thread meanwhile, the version then makes the exchange fail
+        uint64_t next = (head & 0xffffffff00000000ULL) + (1ULL << 32) + node->nextFree.load(std::memory_order_relaxed);
+        if (_freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return node;
+        }
+    }
+
+    // grow the pool
+    uint32_t slot = _reservedSlots.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= BLOCK_SIZE * MAX_BLOCKS)
+    {
+        // more tasks are queued than the pool can hold, the extra nodes are deleted once run
+        return new Node();
+    }
+
+    auto& block = _blocks[slot / BLOCK_SIZE];
+    Node* nodes = block.load(std::memory_order_acquire);
+    if (nodes == nullptr)
+    {
+        Node* newNodes = new Node[BLOCK_SIZE];
+        for (uint32_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            newNodes[i].slot = (slot / BLOCK_SIZE) * BLOCK_SIZE + i;
+        }
+
+        if (block.compare_exchange_strong(nodes, newNodes, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            nodes = newNodes;
+        }
+        else
+        {
+            // another thread installed the block first
+            delete [] newNodes;
+        }
+    }
+
+    return nodes + slot % BLOCK_SIZE;
+}
+
+void TaskQueue::freeNode(Node* node)
+{
+    if (node->slot == INVALID_SLOT)
+    {
+        delete node;
+        return;
+    }
+
+    uint64_t head = _freeHead.load(std::memory_order_relaxed);
+    uint64_t next;
+    do
+    {
+        node->nextFree.store((uint32_t)head, std::memory_order_relaxed);
+        next = (head & 0xffffffff00000000ULL) + (1ULL << 32) + node->slot + 1;
+    } while (!_freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void TaskQueue::pushNode(Node* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = _head.exchange(node, std::memory_order_acq_rel);
+    // between the exchange and this store the consumer sees the queue as empty
+    prev->next.store(node, std::memory_order_release);
+}
+
+TaskQueue::Node* TaskQueue::popNode()
+{
+    Node* tail = _tail;
+    Node* next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &_stub)
+    {
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+        _tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next)
+    {
+        _tail = next;
+        return tail;
+    }
+
+    if (tail != _head.load(std::memory_order_acquire))
+    {
+        // a producer is linking a node after the tail, it will be taken by the next call
+        return nullptr;
+    }
+
+    // tail is the last node, put the stub behind it so that it can be taken
+    pushNode(&_stub);
+
+    next = tail->next.load(std::memory_order_acquire);
+    if (next)
+    {
+        _tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void TaskQueue::push(const Task& task)
+{
+    push(Task(task));
+}
+
+void TaskQueue::push(Task&& task)
+{
+    Node* node = allocNode();
+    node->task = std::move(task);
+
+    ssize_t size = _size.fetch_add(1, std::memory_order_relaxed) + 1;
+    ssize_t peak = _peakSize.load(std::memory_order_relaxed);
+    while (size > peak && !_peakSize.compare_exchange_weak(peak, size, std::memory_order_relaxed))
+    {
+    }
+    _pushedCount.fetch_add(1, std::memory_order_relaxed);
+
+    pushNode(node);
+}
+
+ssize_t TaskQueue::run(ssize_t maxTasks, float timeBudget)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // tasks pushed by the tasks run below wait for the next call
+    ssize_t limit = _size.load(std::memory_order_acquire);
+    if (maxTasks >= 0 && maxTasks < limit)
+    {
+        limit = maxTasks;
+    }
+
+    ssize_t count = 0;
+    while (count < limit)
+    {
+        Node* node = popNode();
+        if (node == nullptr)
+        {
+            break;
+        }
+        _size.fetch_sub(1, std::memory_order_relaxed);
+
+        Task task = std::move(node->task);
+        node->task = nullptr;
+        freeNode(node);
+
+        task();
+        ++count;
+
+        if (timeBudget > 0)
+        {
+            std::chrono::duration<float> spent = std::chrono::steady_clock::now() - start;
+            if (spent.count() >= timeBudget)
+            {
+                break;
+            }
+        }
+    }
+
+    _runCount += count;
+    _lastRunCount = count;
+    return count;
+}
+
+void TaskQueue::clear()
+{
+    while (Node* node = popNode())
+    {
+        _size.fetch_sub(1, std::memory_order_relaxed);
+        node->task = nullptr;
+        freeNode(node);
+    }
+}
+
+NS_CC_END
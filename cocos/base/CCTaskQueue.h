@@ -0,0 +1,144 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CCTASKQUEUE_H__
+#define __CCTASKQUEUE_H__
+
+#include <atomic>
+#include <functional>
+#include <stdint.h>
+
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** @brief A lock-free queue of functions posted by any thread and run by a single thread.
+
+ Any number of threads may push() concurrently, only one thread, the owner of the queue, may call run() and
+ clear(). Pushing never takes a lock: the tasks are linked into an intrusive multi-producer single-consumer list
+ and their nodes come from a pool which recycles them once their function has run. The pool grows by blocks
+ and keeps its nodes until the queue is destroyed.
+
+ The Scheduler uses one to run the functions given to Scheduler::performFunctionInCocosThread().
+ */
+class CC_DLL TaskQueue
+{
+public:
+    typedef std::function<void()> Task;
+
+    TaskQueue();
+    ~TaskQueue();
+
+    /** Appends a task. Thread safe */
+    void push(const Task& task);
+    void push(Task&& task);
+
+    /** Runs the queued tasks in the order they were pushed. Only call it from the thread owning the queue.
+     The tasks pushed while running are left for the next call.
+     @param maxTasks Maximum number of tasks to run, -1 for no limit.
+     @param timeBudget Once this many seconds are spent, the remaining tasks are left for the next call.
+     0 or less means no budget. At least one task is run.
+     @return The number of tasks run.
+     */
+    ssize_t run(ssize_t maxTasks = -1, float timeBudget = 0);
+
+    /** Drops the queued tasks without running them. Only call it from the thread owning the queue */
+    void clear();
+
+    /** Number of queued tasks. Tasks being pushed by other threads may not be counted yet */
+    ssize_t getSize() const { return _size.load(std::memory_order_relaxed); }
+    bool isEmpty() const { return getSize() == 0; }
+
+    /** Highest number of queued tasks reached */
+    ssize_t getPeakSize() const { return _peakSize.load(std::memory_order_relaxed); }
+    /** Number of tasks pushed since the creation of the queue */
+    uint64_t getPushedCount() const { return _pushedCount.load(std::memory_order_relaxed); }
+    /** Number of tasks run since the creation of the queue */
+    uint64_t getRunCount() const { return _runCount; }
+    /** Number of tasks run by the last call to run() */
+    ssize_t getLastRunCount() const { return _lastRunCount; }
+    /** Number of nodes allocated by the pool */
+    ssize_t getPoolSize() const;
+
+protected:
+    struct Node
+    {
+        Node();
+
+        Task task;
+        /** next node of the queue */
+        std::atomic<Node*> next;
+        /** slot of the next free node, plus one, 0 ends the free list */
+        std::atomic<uint32_t> nextFree;
+        /** slot of the node in the pool, INVALID_SLOT for the nodes allocated once the pool is full */
+        uint32_t slot;
+    };
+
+    enum : uint32_t
+    {
+        BLOCK_SIZE = 256,
+        MAX_BLOCKS = 256,
+        INVALID_SLOT = 0xffffffff,
+    };
+
+    Node* allocNode();
+    void freeNode(Node* node);
+    Node* nodeAt(uint32_t slot) const;
+
+    void pushNode(Node* node);
+    Node* popNode();
+
+    // queue, producers exchange the head, the consumer owns the tail
+    std::atomic<Node*> _head;
+    Node* _tail;
+    Node _stub;
+
+    // pool. The free list head packs a version counter in its high 32 bits to guard against ABA
+    std::atomic<Node*> _blocks[MAX_BLOCKS];
+    std::atomic<uint32_t> _reservedSlots;
+    std::atomic<uint64_t> _freeHead;
+
+    // statistics
+    std::atomic<ssize_t> _size;
+    std::atomic<ssize_t> _peakSize;
+    std::atomic<uint64_t> _pushedCount;
+    uint64_t _runCount;
+    ssize_t _lastRunCount;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(TaskQueue);
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __CCTASKQUEUE_H__
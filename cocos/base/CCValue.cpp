@@ -37,6 +37,7 @@ const Value Value::Null;
 
 Value::Value()
 : _type(Type::NONE)
+, _shortString(false)
 {
     memset(&_field, 0, sizeof(_field));
 }
@@ -72,20 +73,20 @@ Value::Value(bool v)
 }
 
 Value::Value(const char* v)
-: _type(Type::STRING)
+: _type(Type::NONE)
+, _shortString(false)
 {
-    _field.strVal = new std::string();
     if (v)
-    {
-        *_field.strVal = v;
-    }
+        setString(v, strlen(v));
+    else
+        setString("", 0);
 }
 
 Value::Value(const std::string& v)
-: _type(Type::STRING)
+: _type(Type::NONE)
+, _shortString(false)
 {
-    _field.strVal = new std::string();
-    *_field.strVal = v;
+    setString(v.data(), v.size());
 }
 
 Value::Value(const ValueVector& v)
@@ -132,12 +133,14 @@ Value::Value(ValueMapIntKey&& v)
 
 Value::Value(const Value& other)
 : _type(Type::NONE)
+, _shortString(false)
 {
     *this = other;
 }
 
 Value::Value(Value&& other)
 : _type(Type::NONE)
+, _shortString(false)
 {
     *this = std::move(other);
 }
@@ -169,11 +172,7 @@ Value& Value::operator= (const Value& other)
                 _field.boolVal = other._field.boolVal;
                 break;
             case Type::STRING:
-                if (_field.strVal == nullptr)
-                {
-                    _field.strVal = new std::string();
-                }
-                *_field.strVal = *other._field.strVal;
+                setString(other.getStringData(), other.getStringLength());
                 break;
             case Type::VECTOR:
                 if (_field.vectorVal == nullptr)
@@ -226,7 +225,9 @@ Value& Value::operator= (Value&& other)
                 _field.boolVal = other._field.boolVal;
                 break;
             case Type::STRING:
-                _field.strVal = other._field.strVal;
+                // short strings are copied along with the whole buffer
+                memcpy(&_field, &other._field, sizeof(_field));
+                _shortString = other._shortString;
                 break;
             case Type::VECTOR:
                 _field.vectorVal = other._field.vectorVal;
@@ -244,6 +245,7 @@ Value& Value::operator= (Value&& other)
 
         memset(&other._field, 0, sizeof(other._field));
         other._type = Type::NONE;
+        other._shortString = false;
     }
 
     return *this;
@@ -286,15 +288,16 @@ Value& Value::operator= (bool v)
 
 Value& Value::operator= (const char* v)
 {
-    reset(Type::STRING);
-    *_field.strVal = v ? v : "";
+    if (v)
+        setString(v, strlen(v));
+    else
+        setString("", 0);
     return *this;
 }
 
 Value& Value::operator= (const std::string& v)
 {
-    reset(Type::STRING);
-    *_field.strVal = v;
+    setString(v.data(), v.size());
     return *this;
 }
 
@@ -364,7 +367,7 @@ bool Value::operator== (const Value& v) const
     case Type::BYTE:    return v._field.byteVal   == this->_field.byteVal;
     case Type::INTEGER: return v._field.intVal    == this->_field.intVal;
     case Type::BOOLEAN: return v._field.boolVal   == this->_field.boolVal;
-    case Type::STRING:  return *v._field.strVal   == *this->_field.strVal;
+    case Type::STRING:  return v.getStringLength() == this->getStringLength() && memcmp(v.getStringData(), this->getStringData(), this->getStringLength()) == 0;
     case Type::FLOAT:   return fabs(v._field.floatVal  - this->_field.floatVal)  <= FLT_EPSILON;
     case Type::DOUBLE:  return fabs(v._field.doubleVal - this->_field.doubleVal) <= FLT_EPSILON;
     case Type::VECTOR:
@@ -433,7 +436,7 @@ unsigned char Value::asByte() const
 
     if (_type == Type::STRING)
     {
-        return static_cast<unsigned char>(atoi(_field.strVal->c_str()));
+        return static_cast<unsigned char>(atoi(getStringData()));
     }
 
     if (_type == Type::FLOAT)
@@ -469,7 +472,7 @@ int Value::asInt() const
 
     if (_type == Type::STRING)
     {
-        return atoi(_field.strVal->c_str());
+        return atoi(getStringData());
     }
 
     if (_type == Type::FLOAT)
@@ -505,7 +508,7 @@ float Value::asFloat() const
 
     if (_type == Type::STRING)
     {
-        return utils::atof(_field.strVal->c_str());
+        return utils::atof(getStringData());
     }
 
     if (_type == Type::INTEGER)
@@ -541,7 +544,7 @@ double Value::asDouble() const
 
     if (_type == Type::STRING)
     {
-        return static_cast<double>(utils::atof(_field.strVal->c_str()));
+        return static_cast<double>(utils::atof(getStringData()));
     }
 
     if (_type == Type::INTEGER)
@@ -577,7 +580,7 @@ bool Value::asBool() const
 
     if (_type == Type::STRING)
     {
-        return (*_field.strVal == "0" || *_field.strVal == "false") ? false : true;
+        return (strcmp(getStringData(), "0") == 0 || strcmp(getStringData(), "false") == 0) ? false : true;
     }
 
     if (_type == Type::INTEGER)
@@ -604,7 +607,7 @@ std::string Value::asString() const
 
     if (_type == Type::STRING)
     {
-        return *_field.strVal;
+        return std::string(getStringData(), getStringLength());
     }
 
     std::stringstream ret;
@@ -784,7 +787,11 @@ void Value::clear()
             _field.boolVal = false;
             break;
         case Type::STRING:
-            CC_SAFE_DELETE(_field.strVal);
+            if (!_shortString)
+            {
+                CC_SAFE_DELETE(_field.strVal);
+            }
+            _shortString = false;
             break;
         case Type::VECTOR:
             CC_SAFE_DELETE(_field.vectorVal);
@@ -802,6 +809,33 @@ void Value::clear()
     _type = Type::NONE;
 }
 
+void Value::setString(const char* v, size_t length)
+{
+    if (length < static_cast<size_t>(SHORT_STRING_SIZE - 1))
+    {
+        // v may point into the string being replaced
+        char buffer[SHORT_STRING_SIZE];
+        memcpy(buffer, v, length);
+        clear();
+        memcpy(_field.shortStrVal, buffer, length);
+        _field.shortStrVal[length] = '\0';
+        _field.shortStrVal[SHORT_STRING_SIZE - 1] = (char)length;
+        _shortString = true;
+    }
+    else if (_type == Type::STRING && !_shortString)
+    {
+        _field.strVal->assign(v, length);
+    }
+    else
+    {
+        clear();
+        _field.strVal = new std::string(v, length);
+        _shortString = false;
+    }
+
+    _type = Type::STRING;
+}
+
 void Value::reset(Type type)
 {
     if (_type == type)
@@ -813,7 +847,10 @@ void Value::reset(Type type)
     switch (type)
     {
         case Type::STRING:
-            _field.strVal = new std::string();
+            // starts as an empty short string, nothing to allocate
+            _field.shortStrVal[0] = '\0';
+            _field.shortStrVal[SHORT_STRING_SIZE - 1] = 0;
+            _shortString = true;
             break;
         case Type::VECTOR:
             _field.vectorVal = new ValueVector();
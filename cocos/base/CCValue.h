@@ -134,9 +134,16 @@ public:
     std::string getDescription();
 
 private:
+    /** Size of the buffer holding short strings. The last byte keeps the length, so it holds up to 22 characters */
+    static const int SHORT_STRING_SIZE = 24;
+
     void clear();
     void reset(Type type);
 
+    void setString(const char* v, size_t length);
+    const char* getStringData() const { return _shortString ? _field.shortStrVal : _field.strVal->data(); }
+    size_t getStringLength() const { return _shortString ? (unsigned char)_field.shortStrVal[SHORT_STRING_SIZE - 1] : _field.strVal->size(); }
+
     union
     {
         unsigned char byteVal;
@@ -146,12 +153,17 @@ private:
         bool boolVal;
 
         std::string* strVal;
+        // most strings read from plists are short: frame names, rects, numbers. They are kept here instead of strVal
+        // to save the allocation of a std::string, and most often of its buffer
+        char shortStrVal[SHORT_STRING_SIZE];
         ValueVector* vectorVal;
         ValueMap* mapVal;
         ValueMapIntKey* intKeyMapVal;
     }_field;
 
     Type _type;
+    // whether a STRING value is kept in _field.shortStrVal
+    bool _shortString;
 };
 
 NS_CC_END
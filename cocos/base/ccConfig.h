@@ -259,6 +259,52 @@ To enable set it to a value different than 0. Disabled by default.
 #define CC_ENABLE_PROFILERS 0
 #endif
 
+/** @def CC_USE_NULL_RENDERER
+ If enabled, the renderer backend (the "-null.cpp" files that replace the "-ogl2.cpp" ones) does not talk to OpenGL.
+ Draw calls, buffer uploads and state changes are recorded into the GLCommandLog instead, and GLViewHeadless
+ can be used as the GLView. Useful to benchmark the CPU side of the renderer on machines without a GPU.
+
+ To enable set it to a value different than 0. Disabled by default.
+ */
+#ifndef CC_USE_NULL_RENDERER
+#define CC_USE_NULL_RENDERER 0
+#endif
+
+/** @def CC_ENABLE_PROGRAM_BINARY_CACHE
+ If enabled, linked GLPrograms are saved under FileUtils::getWritablePath() with glGetProgramBinary
+ and loaded back with glProgramBinary the next time the same shaders are compiled by the same driver.
+ It skips shader compilation at startup and when the GL context is recreated.
+ Only used when Configuration::supportsProgramBinary() is true.
+
+ To disable set it to 0. Enabled by default.
+ */
+#ifndef CC_ENABLE_PROGRAM_BINARY_CACHE
+#define CC_ENABLE_PROGRAM_BINARY_CACHE 1
+#endif
+
+/** @def CC_ENABLE_AUTORELEASE_TRACKING
+ If enabled, AutoreleasePool records the return address of every Ref::autorelease() call and counts the objects
+ released per call site. AutoreleasePool::dumpCallSites() logs the call sites that autorelease the most objects,
+ which finds the objects created and destroyed every frame. The addresses can be resolved with addr2line or atos.
+ Useful for debugging purposes only.
+
+ To enable set it to a value different than 0. Disabled by default.
+ */
+#ifndef CC_ENABLE_AUTORELEASE_TRACKING
+#define CC_ENABLE_AUTORELEASE_TRACKING 0
+#endif
+
+/** @def CC_JOB_SYSTEM_WORKERS
+ Number of worker threads started by the JobSystem of the Director.
+ The async loaders of TextureCache, HttpClient and DataReaderHelper run on these threads.
+
+ 0, the default, starts one worker per core but one, and at least two.
+ The count can be changed at run time with JobSystem::setWorkerCount().
+ */
+#ifndef CC_JOB_SYSTEM_WORKERS
+#define CC_JOB_SYSTEM_WORKERS 0
+#endif
+
 /** Enable Lua engine debug log */
 #ifndef CC_LUA_ENGINE_DEBUG
 #define CC_LUA_ENGINE_DEBUG 0
@@ -239,7 +239,7 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 
 #endif
 
-#if !defined(COCOS2D_DEBUG) || COCOS2D_DEBUG == 0
+#if !defined(COCOS2D_DEBUG) || COCOS2D_DEBUG == 0 || CC_USE_NULL_RENDERER
 #define CHECK_GL_ERROR_DEBUG()
 #else
 #define CHECK_GL_ERROR_DEBUG() \
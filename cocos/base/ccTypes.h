@@ -301,6 +301,23 @@ struct CC_DLL V3F_C4B_T2F_Quad
     V3F_C4B_T2F    br;
 };
 
+//! Instance of an instanced quad. The position and the texture coordinates of the corner (x, y)
+//! of the unit square are origin + x * xAxis + y * yAxis. The corners share the color.
+struct CC_DLL V3F_C4B_T2F_QuadInstance
+{
+    //! position of the bottom left corner
+    Vec3           origin;
+    //! from the bottom left corner to the bottom right one
+    Vec3           xAxis;
+    //! from the bottom left corner to the top left one
+    Vec3           yAxis;
+    //! texture coordinates of the bottom left corner
+    Tex2F          texOrigin;
+    Tex2F          texXAxis;
+    Tex2F          texYAxis;
+    Color4B        color;
+};
+
 //! 4 Vertex2FTex2FColor4F Quad
 struct CC_DLL V2F_C4F_T2F_Quad
 {
@@ -41,7 +41,9 @@ THE SOFTWARE.
 #include "base/CCRef.h"
 #include "base/CCRefPtr.h"
 #include "base/CCVector.h"
+#include "base/CCSmallVector.h"
 #include "base/CCMap.h"
+#include "base/CCFlatMap.h"
 #include "base/CCAutoreleasePool.h"
 #include "base/CCNS.h"
 #include "base/CCData.h"
@@ -52,6 +54,9 @@ THE SOFTWARE.
 #include "base/CCConfiguration.h"
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
+#include "base/CCTaskQueue.h"
+#include "base/CCJobSystem.h"
+#include "base/CCFramePacer.h"
 #include "base/base64.h"
 #include "base/ZipUtils.h"
 #include "base/CCProfiling.h"
@@ -96,6 +101,7 @@ THE SOFTWARE.
 #include "2d/CCActionCamera.h"
 #include "2d/CCActionManager.h"
 #include "2d/CCActionEase.h"
+#include "2d/CCTweenSystem.h"
 #include "2d/CCActionPageTurn3D.h"
 #include "2d/CCActionGrid.h"
 #include "2d/CCActionProgressTimer.h"
@@ -108,6 +114,9 @@ THE SOFTWARE.
 
 // 2d nodes
 #include "2d/CCNode.h"
+#include "2d/CCNodePath.h"
+#include "2d/CCNodePool.h"
+#include "2d/CCSpatialIndex.h"
 #include "2d/CCAtlasNode.h"
 #include "2d/CCDrawingPrimitives.h"
 #include "2d/CCDrawNode.h"
@@ -118,6 +127,7 @@ THE SOFTWARE.
 #include "2d/CCFontFNT.h"
 #include "2d/CCLayer.h"
 #include "2d/CCScene.h"
+#include "2d/CCTransformSystem.h"
 #include "2d/CCTransition.h"
 #include "2d/CCTransitionPageTurn.h"
 #include "2d/CCTransitionProgress.h"
@@ -128,6 +138,7 @@ THE SOFTWARE.
 #include "2d/CCProgressTimer.h"
 #include "2d/CCRenderTexture.h"
 #include "2d/CCNodeGrid.h"
+#include "2d/CCParallelVisitor.h"
 #include "2d/CCParticleBatchNode.h"
 #include "2d/CCParticleSystem.h"
 #include "2d/CCParticleExamples.h"
@@ -145,10 +156,13 @@ THE SOFTWARE.
 #include "renderer/CCGroupCommand.h"
 #include "renderer/CCQuadCommand.h"
 #include "renderer/CCRenderCommand.h"
+#include "renderer/CCRenderCommandBuffer.h"
+#include "renderer/CCRenderStats.h"
 #include "renderer/CCRenderCommandPool.h"
 #include "renderer/CCRenderer.h"
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCGLProgramCache.h"
+#include "renderer/CCGLProgramBinaryCache.h"
 #include "renderer/CCGLProgramState.h"
 #include "renderer/ccGLStateCache.h"
 #include "renderer/ccShaders.h"
@@ -242,6 +256,7 @@ THE SOFTWARE.
 #include "2d/CCAnimationCache.h"
 #include "2d/CCSprite.h"
 #include "2d/CCSpriteBatchNode.h"
+#include "2d/CCStaticBatchNode.h"
 #include "2d/CCSpriteFrame.h"
 #include "2d/CCSpriteFrameCache.h"
 
@@ -343,7 +343,7 @@ void Armature::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints = Vec2(_contentSize.width * _anchorPoint.x - _offsetPoint.x, _contentSize.height * _anchorPoint.y - _offsetPoint.y);
         _realAnchorPointInPoints = Vec2(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
-        _transformDirty = _inverseDirty = true;
+        markTransformDirty();
     }
 }
 
@@ -159,6 +159,7 @@ public:
      * @lua NA
      */
     virtual void visit(cocos2d::Renderer *renderer, const cocos2d::Mat4 &parentTransform, uint32_t parentFlags) override;
+    virtual bool isVisitThreadSafe() const override { return false; }
     virtual void draw(cocos2d::Renderer *renderer, const cocos2d::Mat4 &transform, uint32_t flags) override;
     virtual void update(float dt) override;
 
@@ -166,6 +167,7 @@ public:
     virtual void onExit() override; 
 
     virtual const cocos2d::Mat4& getNodeToParentTransform() const override;
+    virtual bool isTransformSystemSupported() const override { return false; }
     /**
      *  @js NA
      *  @lua NA
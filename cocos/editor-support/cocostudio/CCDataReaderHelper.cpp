@@ -153,67 +153,31 @@ DataReaderHelper *DataReaderHelper::_dataReaderHelper = nullptr;
 
 
 //! Async load
-void DataReaderHelper::loadData()
+void DataReaderHelper::loadData(AsyncStruct *pAsyncStruct)
 {
-    AsyncStruct *pAsyncStruct = nullptr;
+    // generate data info
+    DataInfo *pDataInfo = new DataInfo();
+    pDataInfo->asyncStruct = pAsyncStruct;
+    pDataInfo->filename = pAsyncStruct->filename;
+    pDataInfo->baseFilePath = pAsyncStruct->baseFilePath;
 
-    while (true)
+    if (pAsyncStruct->configType == DragonBone_XML)
     {
-        std::queue<AsyncStruct *> *pQueue = _asyncStructQueue;
-        _asyncStructQueueMutex.lock(); // get async struct from queue
-        if (pQueue->empty())
-        {
-            _asyncStructQueueMutex.unlock();
-            if (need_quit)
-            {
-                break;
-            }
-            else
-            {
-				std::unique_lock<std::mutex> lk(_sleepMutex);
-				_sleepCondition.wait(lk);
-                continue;
-            }
-        }
-        else
-        {
-            pAsyncStruct = pQueue->front();
-            pQueue->pop();
-            _asyncStructQueueMutex.unlock();
-        }
-
-        // generate data info
-        DataInfo *pDataInfo = new DataInfo();
-        pDataInfo->asyncStruct = pAsyncStruct;
-        pDataInfo->filename = pAsyncStruct->filename;
-        pDataInfo->baseFilePath = pAsyncStruct->baseFilePath;
-
-        if (pAsyncStruct->configType == DragonBone_XML)
-        {
-            DataReaderHelper::addDataFromCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
-        }
-        else if(pAsyncStruct->configType == CocoStudio_JSON)
-        {
-            DataReaderHelper::addDataFromJsonCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
-        }
-        else if(pAsyncStruct->configType == CocoStudio_Binary)
-        {
-            DataReaderHelper::addDataFromBinaryCache(pAsyncStruct->fileContent.c_str(),pDataInfo);
-        }
-
-        // put the image info into the queue
-        _dataInfoMutex.lock();
-        _dataQueue->push(pDataInfo);
-        _dataInfoMutex.unlock();
+        DataReaderHelper::addDataFromCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
     }
-
-    if( _asyncStructQueue != nullptr )
+    else if(pAsyncStruct->configType == CocoStudio_JSON)
     {
-        delete _asyncStructQueue;
-        _asyncStructQueue = nullptr;
-        delete _dataQueue;
-        _dataQueue = nullptr;
+        DataReaderHelper::addDataFromJsonCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
     }
+    else if(pAsyncStruct->configType == CocoStudio_Binary)
+    {
+        DataReaderHelper::addDataFromBinaryCache(pAsyncStruct->fileContent.c_str(),pDataInfo);
+    }
+
+    // put the image info into the queue
+    _dataInfoMutex.lock();
+    _dataQueue.push(pDataInfo);
+    _dataInfoMutex.unlock();
 }
 
 
@@ -246,24 +210,20 @@ void DataReaderHelper::purge()
 
 
 DataReaderHelper::DataReaderHelper()
-	: _loadingThread(nullptr)
-	, _asyncRefCount(0)
+	: _asyncRefCount(0)
 	, _asyncRefTotalCount(0)
-	, need_quit(false)
-	, _asyncStructQueue(nullptr)
-	, _dataQueue(nullptr)
 {
 
 }
 
 DataReaderHelper::~DataReaderHelper()
 {
-    need_quit = true;
-
-	_sleepCondition.notify_one();
-	if (_loadingThread) _loadingThread->join();
+    // the last job ends after all the others
+    if (_lastLoadJob && !_lastLoadJob->isDone())
+    {
+        Director::getInstance()->getJobSystem()->wait(_lastLoadJob);
+    }
 
-	CC_SAFE_DELETE(_loadingThread);
 	_dataReaderHelper = nullptr;
 }
 
@@ -372,18 +332,6 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
     }
 
 
-    // lazy init
-    if (_asyncStructQueue == nullptr)
-    {
-        _asyncStructQueue = new std::queue<AsyncStruct *>();
-        _dataQueue = new std::queue<DataInfo *>();
-
-		// create a new thread to load images
-		_loadingThread = new std::thread(&DataReaderHelper::loadData, this);
-
-        need_quit = false;
-    }
-
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->schedule(schedule_selector(DataReaderHelper::addDataAsyncCallBack), this, 0, false);
@@ -445,18 +393,14 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
     }
 
 
-    // add async struct into queue
-    _asyncStructQueueMutex.lock();
-    _asyncStructQueue->push(data);
-    _asyncStructQueueMutex.unlock();
-
-    _sleepCondition.notify_one();
+    // parsed after the files requested before
+    _lastLoadJob = Director::getInstance()->getJobSystem()->schedule(std::bind(&DataReaderHelper::loadData, this, data), _lastLoadJob);
 }
 
 void DataReaderHelper::addDataAsyncCallBack(float dt)
 {
-    // the data is generated in loading thread
-    std::queue<DataInfo *> *dataQueue = _dataQueue;
+    // the data is generated by the load jobs
+    std::queue<DataInfo *> *dataQueue = &_dataQueue;
 
     _dataInfoMutex.lock();
     if (dataQueue->empty())
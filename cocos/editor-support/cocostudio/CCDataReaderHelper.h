@@ -34,12 +34,12 @@ THE SOFTWARE.
 #include "json/document.h"
 #include "DictionaryHelper.h"
 
+#include "base/CCJobSystem.h"
+
 #include <string>
 #include <queue>
 #include <list>
 #include <mutex>
-#include <thread>
-#include <condition_variable>
 
 namespace tinyxml2
 {
@@ -196,18 +196,12 @@ public:
 	static void decodeNode(BaseData *node, CocoLoader *cocoLoader, stExpCocoNode *pCocoNode, DataInfo *dataInfo);
     
 protected:
-	void loadData();
-
-
-
+	/** Parses the file of a request, on a worker of the JobSystem */
+	void loadData(AsyncStruct *pAsyncStruct);
 
-	std::condition_variable		_sleepCondition;
+	/** The requests are parsed one after the other, each job depends on the previous one */
+	cocos2d::JobHandle _lastLoadJob;
 
-	std::thread     *_loadingThread;
-
-	std::mutex      _sleepMutex;
-
-	std::mutex      _asyncStructQueueMutex;
 	std::mutex      _dataInfoMutex;
 
 	std::mutex      _addDataMutex;
@@ -218,10 +212,7 @@ protected:
 	unsigned long _asyncRefCount;
 	unsigned long _asyncRefTotalCount;
 
-	bool need_quit;
-
-	std::queue<AsyncStruct *> *_asyncStructQueue;
-	std::queue<DataInfo *>   *_dataQueue;
+	std::queue<DataInfo *>   _dataQueue;
 
     static std::vector<std::string> _configFileList;
 
@@ -21,6 +21,21 @@ This file was modified to fit the cocos2d-x project
 #include "MathUtil.h"
 #include "base/ccMacros.h"
 
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SSE2 1
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define MATH_AVX 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define MATH_NEON 1
+#include <arm_neon.h>
+#endif
+
 NS_CC_MATH_BEGIN
 
 void MathUtil::smooth(float* x, float target, float elapsedTime, float responseTime)
@@ -44,4 +59,234 @@ void MathUtil::smooth(float* x, float target, float elapsedTime, float riseTime,
     }
 }
 
+bool MathUtil::isAffine2D(const float* m)
+{
+    return m[2] == 0.0f && m[6] == 0.0f && m[8] == 0.0f && m[9] == 0.0f && m[10] == 1.0f && m[14] == 0.0f;
+}
+
+// The kernels below add the products in the same order as transformVec4(),
+// so the results are the same as the ones of Mat4::transformPoint().
+// When dst is not src, they also copy the rest of each vertex right after its position, so that every byte
+// of dst is written once and in order.
+
+// copies the bytes of a vertex from offset to stride, the colors and texture coordinates of a V3F_C4B_T2F
+static inline void copyVertexTail(const char* src, char* dst, size_t offset, size_t stride)
+{
+    if (stride - offset == sizeof(uint64_t))
+    {
+        uint64_t tail;
+        memcpy(&tail, src + offset, sizeof(tail));
+        memcpy(dst + offset, &tail, sizeof(tail));
+    }
+    else if (stride > offset)
+    {
+        memcpy(dst + offset, src + offset, stride - offset);
+    }
+}
+
+#if MATH_SSE2
+
+static void transformVerticesSSE2(const float* m, const char* src, char* dst, size_t count, size_t stride, bool copyTail)
+{
+    const __m128 col0 = _mm_loadu_ps(m);
+    const __m128 col1 = _mm_loadu_ps(m + 4);
+    const __m128 col2 = _mm_loadu_ps(m + 8);
+    const __m128 col3 = _mm_loadu_ps(m + 12);
+    // the lane after z is not a coordinate
+    const __m128 keep = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+    for (size_t i = 0; i < count; ++i, src += stride, dst += stride)
+    {
+        __m128 p = _mm_loadu_ps((const float*)src);
+        __m128 r = _mm_mul_ps(col0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm_add_ps(r, _mm_mul_ps(col1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm_add_ps(r, _mm_mul_ps(col2, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2))));
+        r = _mm_add_ps(r, col3);
+        _mm_storeu_ps((float*)dst, _mm_or_ps(_mm_andnot_ps(keep, r), _mm_and_ps(keep, p)));
+        if (copyTail)
+            copyVertexTail(src, dst, 4 * sizeof(float), stride);
+    }
+}
+
+static void transformVerticesAffine2DSSE2(const float* m, const char* src, char* dst, size_t count, size_t stride, bool copyTail)
+{
+    const __m128 col0 = _mm_setr_ps(m[0], m[1], 0.0f, 0.0f);
+    const __m128 col1 = _mm_setr_ps(m[4], m[5], 0.0f, 0.0f);
+    const __m128 col3 = _mm_setr_ps(m[12], m[13], 0.0f, 0.0f);
+    // z and the lane after it are kept
+    const __m128 keep = _mm_castsi128_ps(_mm_set_epi32(-1, -1, 0, 0));
+
+    for (size_t i = 0; i < count; ++i, src += stride, dst += stride)
+    {
+        __m128 p = _mm_loadu_ps((const float*)src);
+        __m128 r = _mm_mul_ps(col0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm_add_ps(r, _mm_mul_ps(col1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm_add_ps(r, col3);
+        _mm_storeu_ps((float*)dst, _mm_or_ps(_mm_andnot_ps(keep, r), _mm_and_ps(keep, p)));
+        if (copyTail)
+            copyVertexTail(src, dst, 4 * sizeof(float), stride);
+    }
+}
+
+#endif // MATH_SSE2
+
+#if MATH_AVX
+
+// two vertices at a time, one in each 128 bits lane
+static inline __m256 loadColumnAVX(const float* column)
+{
+    __m128 c = _mm_loadu_ps(column);
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(c), c, 1);
+}
+
+static size_t transformVerticesAVX(const float* m, const char* src, char* dst, size_t count, size_t stride, bool copyTail)
+{
+    const __m256 col0 = loadColumnAVX(m);
+    const __m256 col1 = loadColumnAVX(m + 4);
+    const __m256 col2 = loadColumnAVX(m + 8);
+    const __m256 col3 = loadColumnAVX(m + 12);
+
+    size_t i = 0;
+    for (; i + 1 < count; i += 2, src += 2 * stride, dst += 2 * stride)
+    {
+        __m256 p = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)src)), _mm_loadu_ps((const float*)(src + stride)), 1);
+        __m256 r = _mm256_mul_ps(col0, _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(col1, _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm256_add_ps(r, _mm256_mul_ps(col2, _mm256_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2))));
+        r = _mm256_add_ps(r, col3);
+        r = _mm256_blend_ps(r, p, 0x88);
+        _mm_storeu_ps((float*)dst, _mm256_castps256_ps128(r));
+        if (copyTail)
+            copyVertexTail(src, dst, 4 * sizeof(float), stride);
+        _mm_storeu_ps((float*)(dst + stride), _mm256_extractf128_ps(r, 1));
+        if (copyTail)
+            copyVertexTail(src + stride, dst + stride, 4 * sizeof(float), stride);
+    }
+
+    // number of vertices transformed
+    return i;
+}
+
+static size_t transformVerticesAffine2DAVX(const float* m, const char* src, char* dst, size_t count, size_t stride, bool copyTail)
+{
+    const __m128 c0 = _mm_setr_ps(m[0], m[1], 0.0f, 0.0f);
+    const __m128 c1 = _mm_setr_ps(m[4], m[5], 0.0f, 0.0f);
+    const __m128 c3 = _mm_setr_ps(m[12], m[13], 0.0f, 0.0f);
+    const __m256 col0 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c0, 1);
+    const __m256 col1 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1), c1, 1);
+    const __m256 col3 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3), c3, 1);
+
+    size_t i = 0;
+    for (; i + 1 < count; i += 2, src += 2 * stride, dst += 2 * stride)
+    {
+        __m256 p = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)src)), _mm_loadu_ps((const float*)(src + stride)), 1);
+        __m256 r = _mm256_mul_ps(col0, _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(col1, _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm256_add_ps(r, col3);
+        r = _mm256_blend_ps(r, p, 0xCC);
+        _mm_storeu_ps((float*)dst, _mm256_castps256_ps128(r));
+        if (copyTail)
+            copyVertexTail(src, dst, 4 * sizeof(float), stride);
+        _mm_storeu_ps((float*)(dst + stride), _mm256_extractf128_ps(r, 1));
+        if (copyTail)
+            copyVertexTail(src + stride, dst + stride, 4 * sizeof(float), stride);
+    }
+
+    return i;
+}
+
+#endif // MATH_AVX
+
+#if MATH_NEON
+
+static void transformVerticesNEON(const float* m, const char* src, char* dst, size_t count, size_t stride, bool copyTail)
+{
+    const float32x4_t col0 = vld1q_f32(m);
+    const float32x4_t col1 = vld1q_f32(m + 4);
+    const float32x4_t col2 = vld1q_f32(m + 8);
+    const float32x4_t col3 = vld1q_f32(m + 12);
+    // the lane after z is not a coordinate
+    const uint32x4_t keep = vsetq_lane_u32(0xffffffff, vdupq_n_u32(0), 3);
+
+    for (size_t i = 0; i < count; ++i, src += stride, dst += stride)
+    {
+        float32x4_t p = vld1q_f32((const float*)src);
+        float32x4_t r = vmulq_n_f32(col0, vgetq_lane_f32(p, 0));
+        r = vaddq_f32(r, vmulq_n_f32(col1, vgetq_lane_f32(p, 1)));
+        r = vaddq_f32(r, vmulq_n_f32(col2, vgetq_lane_f32(p, 2)));
+        r = vaddq_f32(r, col3);
+        vst1q_f32((float*)dst, vbslq_f32(keep, p, r));
+        if (copyTail)
+            copyVertexTail(src, dst, 4 * sizeof(float), stride);
+    }
+}
+
+static void transformVerticesAffine2DNEON(const float* m, const char* src, char* dst, size_t count, size_t stride, bool copyTail)
+{
+    const float32x2_t col0 = vld1_f32(m);
+    const float32x2_t col1 = vld1_f32(m + 4);
+    const float32x2_t col3 = vld1_f32(m + 12);
+
+    for (size_t i = 0; i < count; ++i, src += stride, dst += stride)
+    {
+        float32x2_t p = vld1_f32((const float*)src);
+        float32x2_t r = vmul_lane_f32(col0, p, 0);
+        r = vadd_f32(r, vmul_lane_f32(col1, p, 1));
+        r = vadd_f32(r, col3);
+        vst1_f32((float*)dst, r);
+        ((float*)dst)[2] = ((const float*)src)[2];
+        if (copyTail)
+            copyVertexTail(src, dst, 3 * sizeof(float), stride);
+    }
+}
+
+#endif // MATH_NEON
+
+void MathUtil::transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride)
+{
+    GP_ASSERT(m);
+    GP_ASSERT(stride >= 4 * sizeof(float));
+
+    const char* in = (const char*)src;
+    char* out = (char*)dst;
+    bool affine2D = isAffine2D(m);
+    bool copyTail = src != dst;
+
+#if MATH_SSE2
+    size_t done = 0;
+#if MATH_AVX
+    done = affine2D ? transformVerticesAffine2DAVX(m, in, out, count, stride, copyTail) : transformVerticesAVX(m, in, out, count, stride, copyTail);
+#endif
+    if (affine2D)
+        transformVerticesAffine2DSSE2(m, in + done * stride, out + done * stride, count - done, stride, copyTail);
+    else
+        transformVerticesSSE2(m, in + done * stride, out + done * stride, count - done, stride, copyTail);
+#elif MATH_NEON
+    if (affine2D)
+        transformVerticesAffine2DNEON(m, in, out, count, stride, copyTail);
+    else
+        transformVerticesNEON(m, in, out, count, stride, copyTail);
+#else
+    for (size_t i = 0; i < count; ++i, in += stride, out += stride)
+    {
+        const float* v = (const float*)in;
+        float p[4];
+        if (affine2D)
+        {
+            p[0] = v[0] * m[0] + v[1] * m[4] + m[12];
+            p[1] = v[0] * m[1] + v[1] * m[5] + m[13];
+            p[2] = v[2];
+        }
+        else
+        {
+            transformVec4(m, v[0], v[1], v[2], 1.0f, p);
+        }
+        // w is dropped, the bytes after z are not a coordinate
+        memcpy(out, p, 3 * sizeof(float));
+        if (copyTail)
+            copyVertexTail(in, out, 3 * sizeof(float), stride);
+    }
+#endif
+}
+
 NS_CC_MATH_END
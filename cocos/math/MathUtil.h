@@ -66,6 +66,36 @@ public:
      */
     static void smooth(float* x, float target, float elapsedTime, float riseTime, float fallTime);
 
+    /**
+     * Transforms a run of points by the given matrix, like Mat4::transformPoint() does.
+     *
+     * The points are the x, y and z floats at the beginning of vertices laid out every `stride` bytes,
+     * eg: the vertices of V3F_C4B_T2F_Quad, so the stride must be at least 16 bytes.
+     * `dst` may be `src`, then only the positions are written. Otherwise the rest of each vertex, eg: colors and
+     * texture coordinates, is copied right after its position: every byte of `dst` is written once, in order, and
+     * never read, so it can be mapped GPU memory.
+     * Uses SSE2, AVX or NEON when the target supports them, with a faster path for 2D affine matrices.
+     *
+     * @param m the column major matrix.
+     * @param src the first vertex to transform.
+     * @param dst where the first transformed vertex is written.
+     * @param count the number of vertices.
+     * @param stride the distance in bytes between two vertices.
+     */
+    static void transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride);
+
+    /**
+     * Transforms a run of points in place. See transformVertices(m, src, dst, count, stride).
+     */
+    static void transformVertices(const float* m, void* vertices, size_t count, size_t stride) { transformVertices(m, vertices, vertices, count, stride); }
+
+    /**
+     * Returns whether the matrix is a 2D affine transform: z is kept as is and doesn't change x and y.
+     *
+     * @param m the column major matrix.
+     */
+    static bool isAffine2D(const float* m);
+
 private:
 
     inline static void addMatrix(const float* m, float scalar, float* dst);
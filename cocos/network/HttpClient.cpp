@@ -157,8 +157,13 @@ void HttpClient::networkThread()
         }
     }
     
-    // cleanup: if worker thread received quit signal, clean up un-completed request queue
+    // cleanup: if worker thread received quit signal, drop the un-completed request queue
     s_requestQueueMutex.lock();
+    for (auto request : *s_requestQueue)
+    {
+        // balances the retain of send()
+        request->release();
+    }
     s_requestQueue->clear();
     s_requestQueueMutex.unlock();
     
@@ -151,6 +151,7 @@ public:
      * To control the step of physics, if you want control it by yourself( fixed-timestep for example ), you can set this to false and call step by yourself.
      * Defaut value is true.
      * Note: if you set auto step to false, setSpeed and setUpdateRate won't work, you need to control the time step by yourself.
+     * When the Director runs with a fixed time step (Director::setFixedTimeStep()), the auto steps already use it.
      */
     void setAutoStep(bool autoStep){ _autoStep = autoStep; }
     /** Get the auto step */
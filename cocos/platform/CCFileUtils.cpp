@@ -102,7 +102,8 @@ public:
         parser.setDelegator(this);
 
         parser.parse(fileName);
-		return _rootDict;
+        // the maker is thrown away, don't copy the whole tree
+		return std::move(_rootDict);
     }
 
 	ValueMap dictionaryWithDataOfFile(const char* filedata, int filesize)
@@ -114,7 +115,7 @@ public:
 		parser.setDelegator(this);
 
 		parser.parse(filedata, filesize);
-		return _rootDict;
+		return std::move(_rootDict);
 	}
 
     ValueVector arrayWithContentsOfFile(const std::string& fileName)
@@ -126,7 +127,7 @@ public:
         parser.setDelegator(this);
 
         parser.parse(fileName);
-		return _rootArray;
+		return std::move(_rootArray);
     }
 
     void startElement(void *ctx, const char *name, const char **atts)
@@ -160,8 +161,9 @@ public:
                 // add a new dictionary into the pre dictionary
                 CCASSERT(! _dictStack.empty(), "The state is wrong!");
                 ValueMap* preDict = _dictStack.top();
-                (*preDict)[_curKey] = Value(ValueMap());
-				_curDict = &(*preDict)[_curKey].asValueMap();
+                Value& dict = (*preDict)[_curKey];
+                dict = Value(ValueMap());
+				_curDict = &dict.asValueMap();
             }
 
             // record the dict state
@@ -200,8 +202,9 @@ public:
 
             if (preState == SAX_DICT)
             {
-                (*_curDict)[_curKey] = Value(ValueVector());
-				_curArray = &(*_curDict)[_curKey].asValueVector();
+                Value& array = (*_curDict)[_curKey];
+                array = Value(ValueVector());
+				_curArray = &array.asValueVector();
             }
             else if (preState == SAX_ARRAY)
             {
@@ -301,12 +304,11 @@ public:
         }
 
         SAXState curState = _stateStack.empty() ? SAX_DICT : _stateStack.top();
-        const std::string text = std::string((char*)ch,0,len);
 
         switch(_state)
         {
         case SAX_KEY:
-            _curKey = text;
+            _curKey.assign(ch, len);
             break;
         case SAX_INT:
         case SAX_REAL:
@@ -317,7 +319,7 @@ public:
                     CCASSERT(!_curKey.empty(), "key not found : <integer/real>");
                 }
                 
-                _curValue.append(text);
+                _curValue.append(ch, len);
             }
             break;
         default:
@@ -125,6 +125,9 @@ public:
 	/** Draw vertices using indices */
 	virtual void drawElements(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset) = 0;
 
+	/** Draw `instanceCount` instances of the vertices using indices. Only available when Configuration::supportsInstancing() */
+	virtual void drawElementsInstanced(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset, GLsizei instanceCount) = 0;
+
 
     /** Open or close IME keyboard , subclass must implement this method. */
     virtual void setIMEKeyboardState(bool open) = 0;
@@ -65,6 +65,13 @@ extern PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT;
 #define glBindVertexArrayOES glBindVertexArrayOESEXT
 #define glDeleteVertexArraysOES glDeleteVertexArraysOESEXT
 
+#ifdef GL_OES_get_program_binary
+#define glGetProgramBinary				glGetProgramBinaryOES
+#define glProgramBinary					glProgramBinaryOES
+#define GL_PROGRAM_BINARY_LENGTH		GL_PROGRAM_BINARY_LENGTH_OES
+#define GL_NUM_PROGRAM_BINARY_FORMATS	GL_NUM_PROGRAM_BINARY_FORMATS_OES
+#endif
+
 
 #endif // CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
 
@@ -0,0 +1,161 @@
+/****************************************************************************
+Copyright (c) 2014 Fourth Sky Interactive
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCGLViewHeadless.h"
+#include "renderer/ccGLStateCache.h"
+#include "renderer/CCGLCommandLog.h"
+#include "renderer/CCVertexIndexBuffer.h"
+
+NS_CC_BEGIN
+
+GLViewHeadless* GLViewHeadless::create(const std::string& viewName)
+{
+    return createWithSize(viewName, Size(960, 640));
+}
+
+GLViewHeadless* GLViewHeadless::createWithSize(const std::string& viewName, const Size& size)
+{
+    auto ret = new (std::nothrow) GLViewHeadless;
+    if(ret && ret->initWithSize(viewName, size)) {
+        ret->autorelease();
+        return ret;
+    }
+
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+GLViewHeadless::GLViewHeadless()
+: _shouldClose(false)
+, _scissorEnabled(false)
+, _clearColor(Color4F::BLACK)
+, _depthClear(1.0f)
+, _stencilClear(0)
+{
+}
+
+GLViewHeadless::~GLViewHeadless()
+{
+    CCLOGINFO("deallocing GLViewHeadless: %p", this);
+}
+
+bool GLViewHeadless::initWithSize(const std::string& viewName, const Size& size)
+{
+    setViewName(viewName);
+    setFrameSize(size.width, size.height);
+
+    return true;
+}
+
+void GLViewHeadless::end()
+{
+    GL::invalidateStateCache();
+
+    _shouldClose = true;
+    // Release self, same as the windowed views
+    release();
+}
+
+void GLViewHeadless::swapBuffers()
+{
+    GLCommandLog::getInstance()->endFrame();
+}
+
+void GLViewHeadless::setViewPortInPoints(float x , float y , float w , float h)
+{
+    // nothing is rasterized, the viewport only matters to the projection which GLView already tracks
+}
+
+void GLViewHeadless::setScissorInPoints(float x , float y , float w , float h)
+{
+    _scissorRect.setRect(x * _scaleX + _viewPortRect.origin.x,
+                         y * _scaleY + _viewPortRect.origin.y,
+                         w * _scaleX,
+                         h * _scaleY);
+}
+
+bool GLViewHeadless::isScissorEnabled()
+{
+    return _scissorEnabled;
+}
+
+Rect GLViewHeadless::getScissorRect() const
+{
+    float x = (_scissorRect.origin.x - _viewPortRect.origin.x) / _scaleX;
+    float y = (_scissorRect.origin.y - _viewPortRect.origin.y) / _scaleY;
+    float w = _scissorRect.size.width / _scaleX;
+    float h = _scissorRect.size.height / _scaleY;
+    return Rect(x, y, w, h);
+}
+
+void GLViewHeadless::clearView(bool depth, bool stencil)
+{
+    GLbitfield flags = GL_COLOR_BUFFER_BIT;
+    if (depth)
+        flags |= GL_DEPTH_BUFFER_BIT;
+    if (stencil)
+        flags |= GL_STENCIL_BUFFER_BIT;
+
+    GLCommandLog::getInstance()->record(GLCommandLog::Type::CLEAR, 0, flags);
+}
+
+void GLViewHeadless::setAlphaBlending(bool on)
+{
+    if (on)
+    {
+        GL::blendFunc(CC_BLEND_SRC, CC_BLEND_DST);
+    }
+    else
+    {
+        GL::blendFunc(GL_ONE, GL_ZERO);
+    }
+}
+
+void GLViewHeadless::setBlendFunc(const BlendFunc& func)
+{
+    // same as GLViewImpl, it bypasses the state cache
+    GLCommandLog::getInstance()->record(GLCommandLog::Type::BLEND_FUNC, func.src, func.dst);
+}
+
+void GLViewHeadless::setDepthTest(bool on)
+{
+    GLCommandLog::getInstance()->record(GLCommandLog::Type::DEPTH_TEST, on ? 1 : 0);
+}
+
+void GLViewHeadless::draw(GLenum primitive, GLint first, GLsizei count)
+{
+    GLCommandLog::getInstance()->record(GLCommandLog::Type::DRAW_ARRAYS, 0, primitive, count);
+}
+
+void GLViewHeadless::drawElements(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset)
+{
+    GLCommandLog::getInstance()->record(GLCommandLog::Type::DRAW_ELEMENTS, indices->getVBO(), primitive, count);
+}
+
+void GLViewHeadless::drawElementsInstanced(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset, GLsizei instanceCount)
+{
+    GLCommandLog::getInstance()->record(GLCommandLog::Type::DRAW_ELEMENTS_INSTANCED, indices->getVBO(), primitive, count * instanceCount);
+}
+
+NS_CC_END
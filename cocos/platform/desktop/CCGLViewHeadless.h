@@ -0,0 +1,104 @@
+/****************************************************************************
+Copyright (c) 2014 Fourth Sky Interactive
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_GLVIEW_HEADLESS_DESKTOP_H__
+#define __CC_GLVIEW_HEADLESS_DESKTOP_H__
+
+#include "base/CCRef.h"
+#include "platform/CCCommon.h"
+#include "platform/CCGLView.h"
+
+NS_CC_BEGIN
+
+/** GLView without a window nor a GL context.
+
+ Every draw, clear and state change is recorded into the GLCommandLog and swapBuffers() closes
+ the log frame, so that batch counts can be asserted on after each Director::mainLoop().
+ Meant to be used together with the null renderer backend (CC_USE_NULL_RENDERER).
+ */
+class CC_DLL GLViewHeadless : public GLView
+{
+public:
+    static GLViewHeadless* create(const std::string& viewName);
+    static GLViewHeadless* createWithSize(const std::string& viewName, const Size& size);
+
+    virtual void setViewPortInPoints(float x , float y , float w , float h) override;
+    virtual void setScissorInPoints(float x , float y , float w , float h) override;
+    virtual bool isScissorEnabled() override;
+    virtual Rect getScissorRect() const override;
+
+    /** Enables or disables the scissor test bookkeeping. The GL backend does it with glEnable/glDisable */
+    void setScissorEnabled(bool enabled) { _scissorEnabled = enabled; }
+
+    virtual bool windowShouldClose() override { return _shouldClose; }
+    virtual void pollEvents() override {}
+
+    /* override functions */
+    virtual bool isOpenGLReady() override { return true; }
+    virtual void end() override;
+    virtual void swapBuffers() override;
+    virtual void clearView(bool depth, bool stencil) override;
+    virtual void setAlphaBlending(bool on) override;
+    virtual void setBlendFunc(const BlendFunc& func) override;
+    virtual void setDepthTest(bool on) override;
+    virtual void setClearColor(const Color4F& color) override { _clearColor = color; }
+    virtual Color4F getClearColor() override { return _clearColor; }
+    virtual void setDepthClear(float value) override { _depthClear = value; }
+    virtual float getDepthClear() override { return _depthClear; }
+    virtual void setStencilClear(int value) override { _stencilClear = value; }
+    virtual int getStencilClear() override { return _stencilClear; }
+    virtual void draw(GLenum primitive, GLint first, GLsizei count) override;
+    virtual void drawElements(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset) override;
+    virtual void drawElementsInstanced(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset, GLsizei instanceCount) override;
+    virtual void setIMEKeyboardState(bool bOpen) override {}
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    HWND getWin32Window() override { return nullptr; }
+#endif /* (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) */
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+    id getCocoaWindow() override { return nullptr; }
+#endif // #if (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+
+protected:
+    GLViewHeadless();
+    virtual ~GLViewHeadless();
+
+    bool initWithSize(const std::string& viewName, const Size& size);
+
+    bool _shouldClose;
+    bool _scissorEnabled;
+    Rect _scissorRect;
+
+    Color4F _clearColor;
+    float _depthClear;
+    int _stencilClear;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(GLViewHeadless);
+};
+
+NS_CC_END   // end of namespace   cocos2d
+
+#endif  // end of __CC_GLVIEW_HEADLESS_DESKTOP_H__
@@ -566,6 +566,29 @@ void GLViewImpl::drawElements(GLenum primitive, GLsizei count, IndexBuffer* indi
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+void GLViewImpl::drawElementsInstanced(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset, GLsizei instanceCount)
+{
+#ifdef GL_VERTEX_ATTRIB_ARRAY_DIVISOR
+	GLenum type = indices->getType() == IndexBuffer::IndexType::INDEX_TYPE_SHORT_16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	GLuint realOffset = offset * (indices->getType() == IndexBuffer::IndexType::INDEX_TYPE_SHORT_16 ? 2 : 4);
+
+	// Bind index buffer
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices->getVBO());
+
+	// Draw
+	glDrawElementsInstanced(primitive, count, type, (GLvoid*)realOffset, instanceCount);
+
+	// Check error after draw
+	CHECK_GL_ERROR_DEBUG();
+
+	// Just for safety, unbind all buffers
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+#else
+	CCASSERT(false, "Instancing is not supported on this platform");
+#endif
+}
+
 bool GLViewImpl::windowShouldClose()
 {
     if(_mainWindow)
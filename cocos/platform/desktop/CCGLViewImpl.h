@@ -94,6 +94,7 @@ public:
 	virtual int getStencilClear() override;
 	virtual void draw(GLenum primitive, GLint first, GLsizei count) override;
 	virtual void drawElements(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset) override;
+	virtual void drawElementsInstanced(GLenum primitive, GLsizei count, IndexBuffer* indices, GLuint offset, GLsizei instanceCount) override;
     virtual void setFrameSize(float width, float height) override;
     virtual void setIMEKeyboardState(bool bOpen) override;
 
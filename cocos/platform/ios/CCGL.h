@@ -42,6 +42,12 @@ THE SOFTWARE.
 #include <OpenGLES/ES2/gl.h>
 #include <OpenGLES/ES2/glext.h>
 
+#ifdef GL_EXT_instanced_arrays
+#define glDrawElementsInstanced			glDrawElementsInstancedEXT
+#define glVertexAttribDivisor			glVertexAttribDivisorEXT
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR	GL_VERTEX_ATTRIB_ARRAY_DIVISOR_EXT
+#endif
+
 #endif // CC_PLATFORM_IOS
 
 #endif // __PLATFORM_IOS_CCGL_H__
@@ -28,9 +28,9 @@ THE SOFTWARE.
 
 #include "CCApplication.h"
 #include <unistd.h>
-#include <sys/time.h>
 #include <string>
 #include "base/CCDirector.h"
+#include "base/CCEventDispatcher.h"
 #include "platform/CCFileUtils.h"
 
 NS_CC_BEGIN
@@ -39,15 +39,6 @@ NS_CC_BEGIN
 // sharedApplication pointer
 Application * Application::sm_pSharedApplication = 0;
 
-static long getCurrentMillSecond() {
-    long lLastTime;
-    struct timeval stCurrentTime;
-
-    gettimeofday(&stCurrentTime,NULL);
-    lLastTime = stCurrentTime.tv_sec*1000+stCurrentTime.tv_usec*0.001; //millseconds
-    return lLastTime;
-}
-
 Application::Application()
 : _animationInterval(1.0f/60.0f*1000.0f)
 {
@@ -69,27 +60,26 @@ int Application::run()
         return 0;
     }
 
-    long lastTime = 0L;
-    long curTime = 0L;
-
     auto director = Director::getInstance();
     auto glview = director->getOpenGLView();
+    auto framePacer = director->getFramePacer();
 
     // Retain glview to avoid glview being released in the while loop
     glview->retain();
 
+    // while the scene is idle, the events are polled during the wait so that input starts the next frame at once
+    auto wakeUp = [director, glview]() -> bool {
+        auto inputEventCount = director->getEventDispatcher()->getInputEventCount();
+        glview->pollEvents();
+        return director->getEventDispatcher()->getInputEventCount() != inputEventCount;
+    };
+
     while (!glview->windowShouldClose())
     {
-        lastTime = getCurrentMillSecond();
-
         director->mainLoop();
         glview->pollEvents();
 
-        curTime = getCurrentMillSecond();
-        if (curTime - lastTime < _animationInterval)
-        {
-            usleep((_animationInterval - curTime + lastTime)*1000);
-        }
+        framePacer->waitForNextFrame(wakeUp);
     }
     /* Only work on Desktop
     *  Director::mainLoop is really one frame logic
@@ -108,7 +98,7 @@ int Application::run()
 
 void Application::setAnimationInterval(double interval)
 {
-    //TODO do something else
+    // run() waits with the FramePacer of the Director, which gets the interval from the Director itself
     _animationInterval = interval*1000.0f;
 }
 
@@ -43,6 +43,12 @@ THE SOFTWARE.
 #define glDepthRangef                   glDepthRange
 #define glReleaseShaderCompiler(xxx)
 
+#ifdef GL_ARB_instanced_arrays
+#define glDrawElementsInstanced         glDrawElementsInstancedARB
+#define glVertexAttribDivisor           glVertexAttribDivisorARB
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR  GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB
+#endif
+
 
 #endif // __PLATFORM_MAC_CCGL_H__
 
@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/CCGLCommandLog.h"
+
+#include <string.h>
+
+NS_CC_BEGIN
+
+static GLCommandLog* s_sharedCommandLog = nullptr;
+
+GLCommandLog* GLCommandLog::getInstance()
+{
+    if (!s_sharedCommandLog)
+    {
+        s_sharedCommandLog = new (std::nothrow) GLCommandLog();
+    }
+
+    return s_sharedCommandLog;
+}
+
+void GLCommandLog::destroyInstance()
+{
+    CC_SAFE_DELETE(s_sharedCommandLog);
+}
+
+GLCommandLog::GLCommandLog()
+: _keepEntries(true)
+, _bytesUploaded(0)
+, _lastFrameBytesUploaded(0)
+, _frameCount(0)
+, _lastName(0)
+{
+    memset(_counts, 0, sizeof(_counts));
+    memset(_lastFrameCounts, 0, sizeof(_lastFrameCounts));
+}
+
+void GLCommandLog::record(Type type, GLuint object, GLenum mode, int count, int bytes)
+{
+    _counts[(int)type]++;
+    _bytesUploaded += bytes;
+
+    if (_keepEntries)
+    {
+        Entry entry = { type, object, mode, count, bytes };
+        _entries.push_back(entry);
+    }
+}
+
+void GLCommandLog::endFrame()
+{
+    memcpy(_lastFrameCounts, _counts, sizeof(_counts));
+    _lastFrameBytesUploaded = _bytesUploaded;
+
+    memset(_counts, 0, sizeof(_counts));
+    _bytesUploaded = 0;
+    // keep the capacity, the next frame will most likely record as many entries
+    _entries.clear();
+
+    _frameCount++;
+}
+
+void GLCommandLog::reset()
+{
+    memset(_counts, 0, sizeof(_counts));
+    memset(_lastFrameCounts, 0, sizeof(_lastFrameCounts));
+    _bytesUploaded = _lastFrameBytesUploaded = 0;
+    _entries.clear();
+    _frameCount = 0;
+}
+
+NS_CC_END
@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_GL_COMMAND_LOG_H__
+#define __CC_GL_COMMAND_LOG_H__
+
+#include <vector>
+
+#include "base/ccMacros.h"
+#include "CCGL.h"
+
+NS_CC_BEGIN
+
+/** In-memory log of the GL work issued by the null renderer backend.
+
+ When CC_USE_NULL_RENDERER is enabled, buffers, programs, textures, the GL state cache and
+ GLViewHeadless record what they would have sent to OpenGL here instead.
+ The counters of the frame being built are moved to the "last frame" counters by endFrame(),
+ which GLViewHeadless calls from swapBuffers().
+ */
+class CC_DLL GLCommandLog
+{
+public:
+    enum class Type
+    {
+        DRAW_ARRAYS,
+        DRAW_ELEMENTS,
+        DRAW_ELEMENTS_INSTANCED,
+        CLEAR,
+        BUFFER_CREATE,
+        BUFFER_UPLOAD,
+        TEXTURE_CREATE,
+        TEXTURE_UPLOAD,
+        USE_PROGRAM,
+        SET_UNIFORM,
+        BIND_TEXTURE,
+        BLEND_FUNC,
+        DEPTH_TEST,
+        VERTEX_ATTRIBS,
+        BIND_VAO,
+
+        TYPE_MAX
+    };
+
+    struct Entry
+    {
+        Type type;
+        /** buffer, texture or program name, source factor for blending, 0 when not relevant */
+        GLuint object;
+        /** primitive for draws, destination factor for blending, texture unit for binds... */
+        GLenum mode;
+        /** number of vertices or indices for draws, times the number of instances for instanced draws */
+        int count;
+        /** number of bytes sent to the "GPU" */
+        int bytes;
+    };
+
+    static GLCommandLog* getInstance();
+    static void destroyInstance();
+
+    /** Appends an entry to the log of the current frame */
+    void record(Type type, GLuint object = 0, GLenum mode = 0, int count = 0, int bytes = 0);
+
+    /** Closes the current frame. Its counters become the last frame counters and the log is cleared */
+    void endFrame();
+
+    /** Clears the log and every counter */
+    void reset();
+
+    /** Generates a fake GL object name. Names are never reused */
+    GLuint genName() { return ++_lastName; }
+
+    /** Entries recorded since the last endFrame(). Empty if entries are not kept */
+    const std::vector<Entry>& getEntries() const { return _entries; }
+
+    /** When disabled only the counters are updated, which keeps long soak runs at constant memory. Enabled by default */
+    void setKeepEntries(bool keep) { _keepEntries = keep; }
+    bool isKeepingEntries() const { return _keepEntries; }
+
+    /** Number of commands of a type recorded in the current frame */
+    ssize_t getCount(Type type) const { return _counts[(int)type]; }
+    /** Number of bytes uploaded in the current frame */
+    ssize_t getBytesUploaded() const { return _bytesUploaded; }
+
+    /** Number of commands of a type recorded in the last finished frame */
+    ssize_t getLastFrameCount(Type type) const { return _lastFrameCounts[(int)type]; }
+    /** Number of bytes uploaded in the last finished frame */
+    ssize_t getLastFrameBytesUploaded() const { return _lastFrameBytesUploaded; }
+
+    /** Number of frames finished since the last reset() */
+    unsigned int getFrameCount() const { return _frameCount; }
+
+protected:
+    GLCommandLog();
+
+    std::vector<Entry> _entries;
+    bool _keepEntries;
+
+    ssize_t _counts[(int)Type::TYPE_MAX];
+    ssize_t _bytesUploaded;
+    ssize_t _lastFrameCounts[(int)Type::TYPE_MAX];
+    ssize_t _lastFrameBytesUploaded;
+    unsigned int _frameCount;
+
+    GLuint _lastName;
+};
+
+NS_CC_END
+
+#endif /* __CC_GL_COMMAND_LOG_H__ */
@@ -0,0 +1,385 @@
+/****************************************************************************
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+Copyright (c) 2014 Fourth Sky Interactive
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/CCGLProgram.h"
+#include "base/ccConfig.h"
+
+#if CC_USE_NULL_RENDERER
+
+#include <sstream>
+
+#include "base/ccMacros.h"
+#include "renderer/CCGLCommandLog.h"
+
+NS_CC_BEGIN
+
+// There is no GLSL compiler behind the null backend. Shaders are "compiled" by collecting their
+// attribute and uniform declarations, so programs keep reporting the same attributes and uniforms
+// as with the GL backend and GLProgramState keeps working the same way.
+
+static const char* s_builtInUniformNames[GLProgram::UNIFORM_MAX] =
+{
+	GLProgram::UNIFORM_NAME_P_MATRIX,
+	GLProgram::UNIFORM_NAME_MV_MATRIX,
+	GLProgram::UNIFORM_NAME_MVP_MATRIX,
+	GLProgram::UNIFORM_NAME_TIME,
+	GLProgram::UNIFORM_NAME_SIN_TIME,
+	GLProgram::UNIFORM_NAME_COS_TIME,
+	GLProgram::UNIFORM_NAME_RANDOM01,
+	GLProgram::UNIFORM_NAME_SAMPLER0,
+	GLProgram::UNIFORM_NAME_SAMPLER1,
+	GLProgram::UNIFORM_NAME_SAMPLER2,
+	GLProgram::UNIFORM_NAME_SAMPLER3,
+};
+
+static GLenum typeFromGLSL(const std::string& type)
+{
+	static const struct {
+		const char* name;
+		GLenum type;
+	} types[] =
+	{
+		{ "float", GL_FLOAT }, { "vec2", GL_FLOAT_VEC2 }, { "vec3", GL_FLOAT_VEC3 }, { "vec4", GL_FLOAT_VEC4 },
+		{ "int", GL_INT }, { "ivec2", GL_INT_VEC2 }, { "ivec3", GL_INT_VEC3 }, { "ivec4", GL_INT_VEC4 },
+		{ "bool", GL_BOOL }, { "mat2", GL_FLOAT_MAT2 }, { "mat3", GL_FLOAT_MAT3 }, { "mat4", GL_FLOAT_MAT4 },
+		{ "sampler2D", GL_SAMPLER_2D }, { "samplerCube", GL_SAMPLER_CUBE },
+	};
+
+	for (const auto& entry : types)
+	{
+		if (type == entry.name)
+			return entry.type;
+	}
+	return GL_FLOAT;
+}
+
+void GLProgram::releaseGLProgram()
+{
+	_vertShader = _fragShader = 0;
+	_program = 0;
+}
+
+bool GLProgram::initWithByteArrays(const GLchar* vShaderByteArray, const GLchar* fShaderByteArray)
+{
+	_program = GLCommandLog::getInstance()->genName();
+
+	_vertShader = _fragShader = 0;
+
+	_userUniforms.clear();
+	_vertexAttribs.clear();
+
+	if (vShaderByteArray)
+	{
+		if (!compileShader(&_vertShader, GL_VERTEX_SHADER, vShaderByteArray))
+		{
+			CCLOG("cocos2d: ERROR: Failed to compile vertex shader");
+			return false;
+		}
+	}
+
+	if (fShaderByteArray)
+	{
+		if (!compileShader(&_fragShader, GL_FRAGMENT_SHADER, fShaderByteArray))
+		{
+			CCLOG("cocos2d: ERROR: Failed to compile fragment shader");
+			return false;
+		}
+	}
+
+	clearUniformShadows();
+
+	return true;
+}
+
+void GLProgram::bindPredefinedVertexAttribs()
+{
+	static const struct {
+		const char *attributeName;
+		int location;
+	} attribute_locations[] =
+	{
+		{ GLProgram::ATTRIBUTE_NAME_POSITION, GLProgram::VERTEX_ATTRIB_POSITION },
+		{ GLProgram::ATTRIBUTE_NAME_COLOR, GLProgram::VERTEX_ATTRIB_COLOR },
+		{ GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORD },
+		{ GLProgram::ATTRIBUTE_NAME_NORMAL, GLProgram::VERTEX_ATTRIB_NORMAL },
+	};
+
+	for (const auto& attribute : attribute_locations)
+	{
+		auto iter = _vertexAttribs.find(attribute.attributeName);
+		if (iter != _vertexAttribs.end())
+		{
+			iter->second.index = attribute.location;
+		}
+	}
+}
+
+void GLProgram::parseVertexAttribs()
+{
+	// collected by compileShader()
+}
+
+void GLProgram::parseUniforms()
+{
+	// collected by compileShader()
+}
+
+bool GLProgram::compileShader(GLuint * shader, GLenum type, const GLchar* source)
+{
+	if (!source)
+	{
+		return false;
+	}
+
+	*shader = GLCommandLog::getInstance()->genName();
+
+	std::istringstream lines(source);
+	std::string line;
+	while (std::getline(lines, line))
+	{
+		std::istringstream tokens(line);
+		std::string qualifier, glslType, name;
+		tokens >> qualifier;
+
+		bool isUniform = (qualifier == "uniform");
+		bool isAttribute = (qualifier == "attribute" && type == GL_VERTEX_SHADER);
+		if (!isUniform && !isAttribute)
+			continue;
+
+		tokens >> glslType;
+		if (glslType == "lowp" || glslType == "mediump" || glslType == "highp")
+			tokens >> glslType;
+		tokens >> name;
+
+		// strip the trailing ';' and a possible array size
+		GLint size = 1;
+		auto end = name.find_first_of("[;");
+		if (end != std::string::npos)
+		{
+			if (name[end] == '[')
+				size = std::max(1, atoi(name.c_str() + end + 1));
+			name.erase(end);
+		}
+		if (name.empty())
+			continue;
+
+		if (isUniform)
+		{
+			// Only add uniforms that are not built-in, same as the GL backend
+			if (strncmp("CC_", name.c_str(), 3) == 0 || _userUniforms.find(name) != _userUniforms.end())
+				continue;
+
+			Uniform uniform;
+			uniform.name = name;
+			uniform.size = size;
+			uniform.type = typeFromGLSL(glslType);
+			uniform.location = UNIFORM_MAX + (GLint)_userUniforms.size();
+			_userUniforms[name] = uniform;
+		}
+		else if (_vertexAttribs.find(name) == _vertexAttribs.end())
+		{
+			VertexAttrib attribute;
+			attribute.name = name;
+			attribute.size = size;
+			attribute.type = typeFromGLSL(glslType);
+			attribute.index = VERTEX_ATTRIB_MAX + (GLuint)_vertexAttribs.size();
+			_vertexAttribs[name] = attribute;
+		}
+	}
+
+	return true;
+}
+
+GLint GLProgram::getAttribLocation(const std::string &attributeName) const
+{
+	auto iter = _vertexAttribs.find(attributeName);
+	if (iter == _vertexAttribs.end())
+		return -1;
+	return iter->second.index;
+}
+
+GLint GLProgram::getUniformLocation(const std::string &attributeName) const
+{
+	return getUniformLocationForName(attributeName.c_str());
+}
+
+void GLProgram::bindAttribLocation(const std::string &attributeName, GLuint index) const
+{
+	// custom attributes keep the index they got in compileShader()
+}
+
+bool GLProgram::link()
+{
+	CCASSERT(_program != 0, "Cannot link invalid program");
+
+	bindPredefinedVertexAttribs();
+
+	parseVertexAttribs();
+	parseUniforms();
+
+	_vertShader = _fragShader = 0;
+
+	return true;
+}
+
+void GLProgram::use()
+{
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::USE_PROGRAM, _program);
+}
+
+GLint GLProgram::getUniformLocationForName(const char* name) const
+{
+	CCASSERT(name != nullptr, "Invalid uniform name");
+	CCASSERT(_program != 0, "Invalid operation. Cannot get uniform location when program is not initialized");
+
+	// the built-ins are always declared, see the GL backend compileShader()
+	for (int i = 0; i < UNIFORM_MAX; ++i)
+	{
+		if (strcmp(name, s_builtInUniformNames[i]) == 0)
+			return i;
+	}
+
+	auto iter = _userUniforms.find(name);
+	if (iter == _userUniforms.end())
+		return -1;
+	return iter->second.location;
+}
+
+static void recordUniform(GLuint program, GLint location, unsigned int bytes)
+{
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::SET_UNIFORM, program, (GLenum)location, 1, bytes);
+}
+
+void GLProgram::setUniformLocationWith1i(GLint location, GLint i1)
+{
+	if (updateUniformLocation(location, &i1, sizeof(i1) * 1))
+		recordUniform(_program, location, sizeof(i1) * 1);
+}
+
+void GLProgram::setUniformLocationWith2i(GLint location, GLint i1, GLint i2)
+{
+	GLint ints[2] = { i1, i2 };
+	if (updateUniformLocation(location, ints, sizeof(ints)))
+		recordUniform(_program, location, sizeof(ints));
+}
+
+void GLProgram::setUniformLocationWith3i(GLint location, GLint i1, GLint i2, GLint i3)
+{
+	GLint ints[3] = { i1, i2, i3 };
+	if (updateUniformLocation(location, ints, sizeof(ints)))
+		recordUniform(_program, location, sizeof(ints));
+}
+
+void GLProgram::setUniformLocationWith4i(GLint location, GLint i1, GLint i2, GLint i3, GLint i4)
+{
+	GLint ints[4] = { i1, i2, i3, i4 };
+	if (updateUniformLocation(location, ints, sizeof(ints)))
+		recordUniform(_program, location, sizeof(ints));
+}
+
+void GLProgram::setUniformLocationWith2iv(GLint location, GLint* ints, unsigned int numberOfArrays)
+{
+	if (updateUniformLocation(location, ints, sizeof(int) * 2 * numberOfArrays))
+		recordUniform(_program, location, sizeof(int) * 2 * numberOfArrays);
+}
+
+void GLProgram::setUniformLocationWith3iv(GLint location, GLint* ints, unsigned int numberOfArrays)
+{
+	if (updateUniformLocation(location, ints, sizeof(int) * 3 * numberOfArrays))
+		recordUniform(_program, location, sizeof(int) * 3 * numberOfArrays);
+}
+
+void GLProgram::setUniformLocationWith4iv(GLint location, GLint* ints, unsigned int numberOfArrays)
+{
+	if (updateUniformLocation(location, ints, sizeof(int) * 4 * numberOfArrays))
+		recordUniform(_program, location, sizeof(int) * 4 * numberOfArrays);
+}
+
+void GLProgram::setUniformLocationWith1f(GLint location, GLfloat f1)
+{
+	if (updateUniformLocation(location, &f1, sizeof(f1) * 1))
+		recordUniform(_program, location, sizeof(f1) * 1);
+}
+
+void GLProgram::setUniformLocationWith2f(GLint location, GLfloat f1, GLfloat f2)
+{
+	GLfloat floats[2] = { f1, f2 };
+	if (updateUniformLocation(location, floats, sizeof(floats)))
+		recordUniform(_program, location, sizeof(floats));
+}
+
+void GLProgram::setUniformLocationWith3f(GLint location, GLfloat f1, GLfloat f2, GLfloat f3)
+{
+	GLfloat floats[3] = { f1, f2, f3 };
+	if (updateUniformLocation(location, floats, sizeof(floats)))
+		recordUniform(_program, location, sizeof(floats));
+}
+
+void GLProgram::setUniformLocationWith4f(GLint location, GLfloat f1, GLfloat f2, GLfloat f3, GLfloat f4)
+{
+	GLfloat floats[4] = { f1, f2, f3, f4 };
+	if (updateUniformLocation(location, floats, sizeof(floats)))
+		recordUniform(_program, location, sizeof(floats));
+}
+
+void GLProgram::setUniformLocationWith2fv(GLint location, const GLfloat* floats, unsigned int numberOfArrays)
+{
+	if (updateUniformLocation(location, floats, sizeof(float) * 2 * numberOfArrays))
+		recordUniform(_program, location, sizeof(float) * 2 * numberOfArrays);
+}
+
+void GLProgram::setUniformLocationWith3fv(GLint location, const GLfloat* floats, unsigned int numberOfArrays)
+{
+	if (updateUniformLocation(location, floats, sizeof(float) * 3 * numberOfArrays))
+		recordUniform(_program, location, sizeof(float) * 3 * numberOfArrays);
+}
+
+void GLProgram::setUniformLocationWith4fv(GLint location, const GLfloat* floats, unsigned int numberOfArrays)
+{
+	if (updateUniformLocation(location, floats, sizeof(float) * 4 * numberOfArrays))
+		recordUniform(_program, location, sizeof(float) * 4 * numberOfArrays);
+}
+
+void GLProgram::setUniformLocationWithMatrix2fv(GLint location, const GLfloat* matrixArray, unsigned int numberOfMatrices)
+{
+	if (updateUniformLocation(location, matrixArray, sizeof(float) * 4 * numberOfMatrices))
+		recordUniform(_program, location, sizeof(float) * 4 * numberOfMatrices);
+}
+
+void GLProgram::setUniformLocationWithMatrix3fv(GLint location, const GLfloat* matrixArray, unsigned int numberOfMatrices)
+{
+	if (updateUniformLocation(location, matrixArray, sizeof(float) * 9 * numberOfMatrices))
+		recordUniform(_program, location, sizeof(float) * 9 * numberOfMatrices);
+}
+
+void GLProgram::setUniformLocationWithMatrix4fv(GLint location, const GLfloat* matrixArray, unsigned int numberOfMatrices)
+{
+	if (updateUniformLocation(location, matrixArray, sizeof(float) * 16 * numberOfMatrices))
+		recordUniform(_program, location, sizeof(float) * 16 * numberOfMatrices);
+}
+
+NS_CC_END
+
+#endif // CC_USE_NULL_RENDERER
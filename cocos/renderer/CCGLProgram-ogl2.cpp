@@ -28,6 +28,9 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "renderer/CCGLProgram.h"
+#include "base/ccConfig.h"
+
+#if !CC_USE_NULL_RENDERER
 
 #ifndef WIN32
 #include <alloca.h>
@@ -35,8 +38,8 @@ THE SOFTWARE.
 
 #include "base/CCDirector.h"
 #include "base/ccMacros.h"
-#include "base/uthash.h"
 #include "renderer/ccGLStateCache.h"
+#include "renderer/CCGLProgramBinaryCache.h"
 #include "CCGL.h"
 
 #include "deprecated/CCString.h"
@@ -47,6 +50,37 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+// prepended to every shader by compileShader(), part of the program binary cache key
+static const GLchar* getShaderHeader(GLenum type)
+{
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_LINUX && CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
+#define CC_SHADER_PRECISION(p) "precision " p " float;\n"
+#else
+#define CC_SHADER_PRECISION(p) ""
+#endif
+#define CC_SHADER_BUILTINS \
+		"uniform mat4 CC_PMatrix;\n" \
+		"uniform mat4 CC_MVMatrix;\n" \
+		"uniform mat4 CC_MVPMatrix;\n" \
+		"uniform vec4 CC_Time;\n" \
+		"uniform vec4 CC_SinTime;\n" \
+		"uniform vec4 CC_CosTime;\n" \
+		"uniform vec4 CC_Random01;\n" \
+		"uniform sampler2D CC_Texture0;\n" \
+		"uniform sampler2D CC_Texture1;\n" \
+		"uniform sampler2D CC_Texture2;\n" \
+		"uniform sampler2D CC_Texture3;\n" \
+		"//CC INCLUDES END\n\n"
+
+	static const GLchar* vertexHeader = CC_SHADER_PRECISION("highp") CC_SHADER_BUILTINS;
+	static const GLchar* fragmentHeader = CC_SHADER_PRECISION("mediump") CC_SHADER_BUILTINS;
+
+#undef CC_SHADER_BUILTINS
+#undef CC_SHADER_PRECISION
+
+	return type == GL_VERTEX_SHADER ? vertexHeader : fragmentHeader;
+}
+
 void GLProgram::releaseGLProgram()
 {
 	if (_vertShader)
@@ -87,6 +121,20 @@ bool GLProgram::initWithByteArrays(const GLchar* vShaderByteArray, const GLchar*
 	CHECK_GL_ERROR_DEBUG();
 
 	_vertShader = _fragShader = 0;
+	clearUniformShadows();
+	_loadedFromBinary = false;
+	_binaryKey.clear();
+
+	auto binaryCache = GLProgramBinaryCache::getInstance();
+	if (binaryCache->isEnabled() && vShaderByteArray && fShaderByteArray)
+	{
+		_binaryKey = binaryCache->getKey(std::string(getShaderHeader(GL_VERTEX_SHADER)) + vShaderByteArray,
+										 std::string(getShaderHeader(GL_FRAGMENT_SHADER)) + fShaderByteArray);
+		if (loadProgramBinary())
+		{
+			return true;
+		}
+	}
 
 	if (vShaderByteArray)
 	{
@@ -117,7 +165,6 @@ bool GLProgram::initWithByteArrays(const GLchar* vShaderByteArray, const GLchar*
 	{
 		glAttachShader(_program, _fragShader);
 	}
-	_hashForUniforms = nullptr;
 
 	CHECK_GL_ERROR_DEBUG();
 
@@ -128,6 +175,63 @@ bool GLProgram::initWithByteArrays(const GLchar* vShaderByteArray, const GLchar*
 	return true;
 }
 
+bool GLProgram::loadProgramBinary()
+{
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	auto binaryCache = GLProgramBinaryCache::getInstance();
+
+	GLenum format;
+	Data binary;
+	if (!binaryCache->load(_binaryKey, &format, &binary))
+	{
+		return false;
+	}
+
+	glProgramBinary(_program, format, binary.getBytes(), (GLsizei)binary.getSize());
+
+	GLint status = GL_FALSE;
+	glGetProgramiv(_program, GL_LINK_STATUS, &status);
+	if (status == GL_TRUE)
+	{
+		_loadedFromBinary = true;
+		return true;
+	}
+
+	// the driver rejects binaries of another driver version or of a different GPU: compile the sources again
+	CCLOG("cocos2d: program binary %s rejected by the driver, compiling from source", _binaryKey.c_str());
+	binaryCache->remove(_binaryKey);
+
+	// start over with a fresh program, a failed glProgramBinary leaves the program unlinked
+	glDeleteProgram(_program);
+	_program = glCreateProgram();
+	glGetError();
+#endif
+	return false;
+}
+
+void GLProgram::saveProgramBinary()
+{
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	GLint length = 0;
+	glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+	{
+		return;
+	}
+
+	Data binary;
+	binary.fastSet((unsigned char*)malloc(length), length);
+
+	GLenum format = 0;
+	GLsizei written = 0;
+	glGetProgramBinary(_program, length, &written, &format, binary.getBytes());
+	if (written == length)
+	{
+		GLProgramBinaryCache::getInstance()->save(_binaryKey, format, binary);
+	}
+#endif
+}
+
 void GLProgram::bindPredefinedVertexAttribs()
 {
 	static const struct {
@@ -242,21 +346,7 @@ bool GLProgram::compileShader(GLuint * shader, GLenum type, const GLchar* source
 	}
 
 	const GLchar *sources[] = {
-#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_LINUX && CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
-		(type == GL_VERTEX_SHADER ? "precision highp float;\n" : "precision mediump float;\n"),
-#endif
-		"uniform mat4 CC_PMatrix;\n"
-		"uniform mat4 CC_MVMatrix;\n"
-		"uniform mat4 CC_MVPMatrix;\n"
-		"uniform vec4 CC_Time;\n"
-		"uniform vec4 CC_SinTime;\n"
-		"uniform vec4 CC_CosTime;\n"
-		"uniform vec4 CC_Random01;\n"
-		"uniform sampler2D CC_Texture0;\n"
-		"uniform sampler2D CC_Texture1;\n"
-		"uniform sampler2D CC_Texture2;\n"
-		"uniform sampler2D CC_Texture3;\n"
-		"//CC INCLUDES END\n\n",
+		getShaderHeader(type),
 		source,
 	};
 
@@ -321,10 +411,26 @@ bool GLProgram::link()
 	}
 #endif
 
+	if (_loadedFromBinary)
+	{
+		// already linked by glProgramBinary, with the attribute locations of the first link
+		parseVertexAttribs();
+		parseUniforms();
+		return true;
+	}
+
 	GLint status = GL_TRUE;
 
 	bindPredefinedVertexAttribs();
 
+#if defined(__glew_h__) && defined(GL_PROGRAM_BINARY_RETRIEVABLE_HINT)
+	// desktop drivers may only keep the binary of programs that asked for it before linking
+	if (!_binaryKey.empty() && glProgramParameteri)
+	{
+		glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+#endif
+
 	glLinkProgram(_program);
 
 	parseVertexAttribs();
@@ -342,6 +448,17 @@ bool GLProgram::link()
 
 	_vertShader = _fragShader = 0;
 
+	if (!_binaryKey.empty())
+	{
+		// only store programs that linked, a failed link would fail again when loaded
+		GLint linked = GL_FALSE;
+		glGetProgramiv(_program, GL_LINK_STATUS, &linked);
+		if (linked == GL_TRUE)
+		{
+			saveProgramBinary();
+		}
+	}
+
 #if DEBUG || (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8)
 	glGetProgramiv(_program, GL_LINK_STATUS, &status);
 
@@ -551,4 +668,6 @@ void GLProgram::setUniformLocationWithMatrix4fv(GLint location, const GLfloat* m
 	}
 }
 
-NS_CC_END
\ No newline at end of file
+NS_CC_END
+
+#endif // !CC_USE_NULL_RENDERER
@@ -35,7 +35,6 @@ THE SOFTWARE.
 
 #include "base/CCDirector.h"
 #include "base/ccMacros.h"
-#include "base/uthash.h"
 #include "renderer/ccGLStateCache.h"
 #include "platform/CCFileUtils.h"
 #include "CCGL.h"
@@ -48,15 +47,12 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
-typedef struct _hashUniformEntry
-{
-    GLvoid*         value;       // value
-    unsigned int    location;    // Key
-    UT_hash_handle  hh;          // hash entry
-} tHashUniformEntry;
+// drivers hand out small uniform locations, values set to higher ones are always sent
+static const GLint MAX_SHADOWED_UNIFORM_LOCATION = 4096;
 
 const char* GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR = "ShaderPositionTextureColor";
 const char* GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP = "ShaderPositionTextureColor_noMVP";
+const char* GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_INSTANCED = "ShaderPositionTextureColor_instanced";
 const char* GLProgram::SHADER_NAME_POSITION_TEXTURE_ALPHA_TEST = "ShaderPositionTextureColorAlphaTest";
 const char* GLProgram::SHADER_NAME_POSITION_TEXTURE_ALPHA_TEST_NO_MV = "ShaderPositionTextureColorAlphaTest_NoMV";
 const char* GLProgram::SHADER_NAME_POSITION_COLOR = "ShaderPositionColor";
@@ -131,7 +127,7 @@ GLProgram::GLProgram()
 : _program(0)
 , _vertShader(0)
 , _fragShader(0)
-, _hashForUniforms(nullptr)
+, _loadedFromBinary(false)
 , _flags()
 {
     memset(_builtInUniforms, 0, sizeof(_builtInUniforms));
@@ -142,16 +138,6 @@ GLProgram::~GLProgram()
     CCLOGINFO("%s %d deallocing GLProgram: %p", __FUNCTION__, __LINE__, this);
 
 	releaseGLProgram();
-
-    tHashUniformEntry *current_element, *tmp;
-
-    // Purge uniform hash
-    HASH_ITER(hh, _hashForUniforms, current_element, tmp)
-    {
-        HASH_DEL(_hashForUniforms, current_element);
-        free(current_element->value);
-        free(current_element);
-    }
 }
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8)
@@ -181,7 +167,7 @@ bool GLProgram::initWithPrecompiledProgramByteArray(const GLchar* vShaderByteArr
     haveProgram = CCPrecompiledShaders::getInstance()->loadProgram(_program, vShaderByteArray, fShaderByteArray);
 
     CHECK_GL_ERROR_DEBUG();
-    _hashForUniforms = nullptr;
+    clearUniformShadows();
 
     CHECK_GL_ERROR_DEBUG();  
 
@@ -304,36 +290,41 @@ bool GLProgram::updateUniformLocation(GLint location, const GLvoid* data, unsign
         return false;
     }
 
-    bool updated = true;
-    tHashUniformEntry *element = nullptr;
-    HASH_FIND_INT(_hashForUniforms, &location, element);
-
-    if (! element)
+    if (location >= MAX_SHADOWED_UNIFORM_LOCATION)
     {
-        element = (tHashUniformEntry*)malloc( sizeof(*element) );
-
-        // key
-        element->location = location;
+        return true;
+    }
 
-        // value
-        element->value = malloc( bytes );
-        memcpy(element->value, data, bytes );
+    if (location >= (GLint)_uniformShadows.size())
+    {
+        UniformShadow unset = { 0, 0, 0 };
+        _uniformShadows.resize(location + 1, unset);
+    }
 
-        HASH_ADD_INT(_hashForUniforms, location, element);
+    UniformShadow& shadow = _uniformShadows[location];
+    if (shadow.bytes == bytes && memcmp(_uniformShadowData.data() + shadow.offset, data, bytes) == 0)
+    {
+        return false;
     }
-    else
+
+    if (bytes > shadow.capacity)
     {
-        if (memcmp(element->value, data, bytes) == 0)
-        {
-            updated = false;
-        }
-        else
-        {
-            memcpy(element->value, data, bytes);
-        }
+        // arrays may be set with more elements than the first time, move the value to the end of the block
+        shadow.offset = (unsigned int)_uniformShadowData.size();
+        shadow.capacity = bytes;
+        _uniformShadowData.resize(shadow.offset + bytes);
     }
 
-    return updated;
+    memcpy(_uniformShadowData.data() + shadow.offset, data, bytes);
+    shadow.bytes = bytes;
+
+    return true;
+}
+
+void GLProgram::clearUniformShadows()
+{
+    _uniformShadows.clear();
+    _uniformShadowData.clear();
 }
 
 void GLProgram::setUniformsForBuiltins()
@@ -385,18 +376,10 @@ void GLProgram::reset()
     
     // it is already deallocated by android
     _program = 0;
+    _loadedFromBinary = false;
 
-    
-    tHashUniformEntry *current_element, *tmp;
-    
-    // Purge uniform hash
-    HASH_ITER(hh, _hashForUniforms, current_element, tmp) 
-    {
-        HASH_DEL(_hashForUniforms, current_element);
-        free(current_element->value);
-        free(current_element);
-    }
-    _hashForUniforms = nullptr;
+    // the uniforms of the new program are not set yet
+    clearUniformShadows();
 }
 
 NS_CC_END
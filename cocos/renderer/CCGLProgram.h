@@ -32,6 +32,7 @@ THE SOFTWARE.
 #define __CCGLPROGRAM_H__
 
 #include <unordered_map>
+#include <vector>
 
 #include "base/ccMacros.h"
 #include "base/CCRef.h"
@@ -46,7 +47,6 @@ NS_CC_BEGIN
  * @{
  */
 
-struct _hashUniformEntry;
 class GLProgram;
 
 typedef void (*GLInfoFunction)(GLuint program, GLenum pname, GLint* params);
@@ -94,6 +94,19 @@ public:
         // backward compatibility
         VERTEX_ATTRIB_TEX_COORDS = VERTEX_ATTRIB_TEX_COORD,
     };
+
+    /** Attributes of the SHADER_NAME_POSITION_TEXTURE_COLOR_INSTANCED shader. The corner of the unit quad uses
+     VERTEX_ATTRIB_POSITION, the color VERTEX_ATTRIB_COLOR and the texture origin VERTEX_ATTRIB_TEX_COORD,
+     so that the shader fits in the 8 attributes GL ES 2.0 guarantees.
+     */
+    enum
+    {
+        VERTEX_ATTRIB_INSTANCE_ORIGIN = VERTEX_ATTRIB_NORMAL,
+        VERTEX_ATTRIB_INSTANCE_X_AXIS,
+        VERTEX_ATTRIB_INSTANCE_Y_AXIS,
+        VERTEX_ATTRIB_INSTANCE_TEX_X_AXIS,
+        VERTEX_ATTRIB_INSTANCE_TEX_Y_AXIS,
+    };
     
     enum
     {
@@ -114,6 +127,7 @@ public:
     
     static const char* SHADER_NAME_POSITION_TEXTURE_COLOR;
     static const char* SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP;
+    static const char* SHADER_NAME_POSITION_TEXTURE_COLOR_INSTANCED;
     static const char* SHADER_NAME_POSITION_TEXTURE_ALPHA_TEST;
     static const char* SHADER_NAME_POSITION_TEXTURE_ALPHA_TEST_NO_MV;
     static const char* SHADER_NAME_POSITION_COLOR;
@@ -314,7 +328,10 @@ public:
 
 
 protected:
+    /** Stores the value in the shadow of the uniform at location. Returns false when it is the value already set */
     bool updateUniformLocation(GLint location, const GLvoid* data, unsigned int bytes);
+    /** Forgets the values of every uniform, they are all sent again by the next setUniformLocation* calls */
+    void clearUniformShadows();
     virtual std::string getDescription() const;
 
     void bindPredefinedVertexAttribs();
@@ -322,14 +339,32 @@ protected:
     void parseUniforms();
 
     bool compileShader(GLuint * shader, GLenum type, const GLchar* source);
+    /** links _program from the GLProgramBinaryCache entry of _binaryKey, if the driver accepts it */
+    bool loadProgramBinary();
+    /** stores the linked _program in the GLProgramBinaryCache under _binaryKey */
+    void saveProgramBinary();
     std::string logForOpenGLObject(GLuint object, GLInfoFunction infoFunc, GLLogFunction logFunc) const;
 
     GLuint            _program;
     GLuint            _vertShader;
     GLuint            _fragShader;
     GLint             _builtInUniforms[UNIFORM_MAX];
-    struct _hashUniformEntry* _hashForUniforms;
+
+    /** Last value set to a uniform location, in _uniformShadowData */
+    struct UniformShadow
+    {
+        unsigned int offset;
+        unsigned int capacity;
+        // 0 until the location is first set
+        unsigned int bytes;
+    };
+    // indexed by location. Locations are small in practice, the ones above MAX_SHADOWED_UNIFORM_LOCATION are not shadowed
+    std::vector<UniformShadow> _uniformShadows;
+    std::vector<unsigned char> _uniformShadowData;
 	bool              _hasShaderCompiler;
+    /** GLProgramBinaryCache key of the sources, empty when the cache is not used */
+    std::string       _binaryKey;
+    bool              _loadedFromBinary;
         
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8)
     std::string       _shaderId;
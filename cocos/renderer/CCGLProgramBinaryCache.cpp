@@ -0,0 +1,194 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/CCGLProgramBinaryCache.h"
+
+#include <stdio.h>
+
+#include "base/CCConfiguration.h"
+#include "base/ccConfig.h"
+#include "platform/CCFileUtils.h"
+#include "xxhash.h"
+
+NS_CC_BEGIN
+
+namespace
+{
+    // "CCPB", bump the version when the header changes
+    const uint32_t BINARY_MAGIC = 0x43435042;
+    const uint32_t BINARY_VERSION = 1;
+
+    struct BinaryHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t length;
+        // detects files truncated by a crash or a full disk while saving
+        uint32_t checksum;
+    };
+}
+
+static GLProgramBinaryCache* s_sharedProgramBinaryCache = nullptr;
+
+GLProgramBinaryCache* GLProgramBinaryCache::getInstance()
+{
+    if (!s_sharedProgramBinaryCache)
+    {
+        s_sharedProgramBinaryCache = new (std::nothrow) GLProgramBinaryCache();
+    }
+
+    return s_sharedProgramBinaryCache;
+}
+
+void GLProgramBinaryCache::destroyInstance()
+{
+    CC_SAFE_DELETE(s_sharedProgramBinaryCache);
+}
+
+GLProgramBinaryCache::GLProgramBinaryCache()
+: _enabled(CC_ENABLE_PROGRAM_BINARY_CACHE != 0)
+{
+    _directory = FileUtils::getInstance()->getWritablePath() + "program_binaries/";
+}
+
+bool GLProgramBinaryCache::isEnabled() const
+{
+    return _enabled && Configuration::getInstance()->supportsProgramBinary();
+}
+
+std::string GLProgramBinaryCache::getKey(const std::string& vertexSource, const std::string& fragmentSource)
+{
+    if (_driver.empty())
+    {
+        auto conf = Configuration::getInstance();
+        _driver = conf->getValue("gl.vendor").asString() + '\n'
+                + conf->getValue("gl.renderer").asString() + '\n'
+                + conf->getValue("gl.version").asString() + '\n';
+    }
+
+    std::string text;
+    text.reserve(_driver.size() + vertexSource.size() + fragmentSource.size() + 1);
+    text += _driver;
+    text += vertexSource;
+    // keeps "ab" + "c" and "a" + "bc" apart
+    text += '\0';
+    text += fragmentSource;
+
+    // two 32 bit hashes with different seeds, collisions between the few hundred programs of a game are unlikely
+    char key[17];
+    snprintf(key, sizeof(key), "%08x%08x",
+             (unsigned)XXH32(text.data(), (int)text.size(), 0),
+             (unsigned)XXH32(text.data(), (int)text.size(), 0x9e3779b1));
+    return key;
+}
+
+bool GLProgramBinaryCache::load(const std::string& key, GLenum* format, Data* binary) const
+{
+    auto fileUtils = FileUtils::getInstance();
+    std::string path = getPath(key);
+    if (!fileUtils->isFileExist(path))
+    {
+        return false;
+    }
+
+    Data data = fileUtils->getDataFromFile(path);
+    if (data.getSize() < (ssize_t)sizeof(BinaryHeader))
+    {
+        return false;
+    }
+
+    BinaryHeader header;
+    memcpy(&header, data.getBytes(), sizeof(header));
+
+    const unsigned char* bytes = data.getBytes() + sizeof(header);
+    ssize_t length = data.getSize() - sizeof(header);
+    if (header.magic != BINARY_MAGIC || header.version != BINARY_VERSION
+        || header.length != (uint32_t)length || header.checksum != XXH32(bytes, (int)length, 0))
+    {
+        CCLOG("cocos2d: GLProgramBinaryCache: ignoring corrupted program binary %s", path.c_str());
+        return false;
+    }
+
+    *format = header.format;
+    binary->copy(bytes, length);
+    return true;
+}
+
+bool GLProgramBinaryCache::save(const std::string& key, GLenum format, const Data& binary)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isDirectoryExist(_directory) && !fileUtils->createDirectory(_directory))
+    {
+        CCLOG("cocos2d: GLProgramBinaryCache: cannot create %s", _directory.c_str());
+        return false;
+    }
+
+    BinaryHeader header;
+    header.magic = BINARY_MAGIC;
+    header.version = BINARY_VERSION;
+    header.format = format;
+    header.length = (uint32_t)binary.getSize();
+    header.checksum = XXH32(binary.getBytes(), (int)binary.getSize(), 0);
+
+    std::string path = getPath(key);
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (!fp)
+    {
+        CCLOG("cocos2d: GLProgramBinaryCache: cannot write %s", path.c_str());
+        return false;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, fp) == 1
+                && fwrite(binary.getBytes(), binary.getSize(), 1, fp) == 1;
+    written = (fclose(fp) == 0) && written;
+    if (!written)
+    {
+        // don't leave a partial file behind, load() would reject it anyway
+        fileUtils->removeFile(path);
+    }
+
+    return written;
+}
+
+void GLProgramBinaryCache::remove(const std::string& key)
+{
+    auto fileUtils = FileUtils::getInstance();
+    std::string path = getPath(key);
+    if (fileUtils->isFileExist(path))
+    {
+        fileUtils->removeFile(path);
+    }
+}
+
+void GLProgramBinaryCache::removeAll()
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (fileUtils->isDirectoryExist(_directory))
+    {
+        fileUtils->removeDirectory(_directory);
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_GL_PROGRAM_BINARY_CACHE_H__
+#define __CC_GL_PROGRAM_BINARY_CACHE_H__
+
+#include <string>
+
+#include "base/ccMacros.h"
+#include "base/CCData.h"
+#include "CCGL.h"
+
+NS_CC_BEGIN
+
+/** On-disk cache of linked GL program binaries.
+
+ GLProgram::initWithByteArrays() looks the program up here before compiling its shaders, and GLProgram::link()
+ stores the result of a successful link. Each program is a file under FileUtils::getWritablePath()
+ named after its key, a hash of both shader sources (with the header GLProgram prepends to them) and of the
+ GL vendor, renderer and version strings. A driver update changes the key, and stale files are simply never read again.
+
+ The attribute locations bound between initWithByteArrays() and link() are baked in the binary, so a program
+ loaded from the cache keeps the bindings it was first linked with. Programs built from the same sources
+ are expected to bind the same locations.
+
+ The cache only stores bytes; GLProgram checks the link status after glProgramBinary() and falls back to
+ compiling the sources, removing the file, when the driver rejects a binary.
+ */
+class CC_DLL GLProgramBinaryCache
+{
+public:
+    static GLProgramBinaryCache* getInstance();
+    static void destroyInstance();
+
+    /** Whether programs are looked up and stored. True by default when CC_ENABLE_PROGRAM_BINARY_CACHE is set
+     and Configuration::supportsProgramBinary() is true, which requires a GL context */
+    bool isEnabled() const;
+    void setEnabled(bool enabled) { _enabled = enabled; }
+
+    /** Key of the program built from these sources with the current driver */
+    std::string getKey(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /** Reads the binary stored for `key`. Returns false when there is none or the file is truncated or corrupted */
+    bool load(const std::string& key, GLenum* format, Data* binary) const;
+    /** Stores `binary` for `key`, replacing the previous one */
+    bool save(const std::string& key, GLenum format, const Data& binary);
+    /** Removes the binary of `key`, used when the driver rejects it */
+    void remove(const std::string& key);
+    /** Removes every stored binary */
+    void removeAll();
+
+    /** Directory holding the binaries */
+    const std::string& getDirectory() const { return _directory; }
+
+protected:
+    GLProgramBinaryCache();
+
+    std::string getPath(const std::string& key) const { return _directory + key + ".bin"; }
+
+    std::string _directory;
+    std::string _driver;
+    bool _enabled;
+};
+
+NS_CC_END
+
+#endif /* __CC_GL_PROGRAM_BINARY_CACHE_H__ */
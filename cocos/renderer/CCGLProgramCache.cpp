@@ -36,6 +36,7 @@ NS_CC_BEGIN
 enum {
     kShaderType_PositionTextureColor,
     kShaderType_PositionTextureColor_noMVP,
+    kShaderType_PositionTextureColor_instanced,
     kShaderType_PositionTextureColorAlphaTest,
     kShaderType_PositionTextureColorAlphaTestNoMV,
     kShaderType_PositionColor,
@@ -119,6 +120,11 @@ void GLProgramCache::loadDefaultGLPrograms()
     loadDefaultGLProgram(p, kShaderType_PositionTextureColor_noMVP);
     _programs.insert( std::make_pair( GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP, p ) );
 
+    // Position Texture Color of instanced quads, used by the Renderer when instancing is enabled
+    p = new GLProgram();
+    loadDefaultGLProgram(p, kShaderType_PositionTextureColor_instanced);
+    _programs.insert( std::make_pair( GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_INSTANCED, p ) );
+
     // Position Texture Color alpha test
     p = new GLProgram();
     loadDefaultGLProgram(p, kShaderType_PositionTextureColorAlphaTest);
@@ -220,6 +226,11 @@ void GLProgramCache::reloadDefaultGLPrograms()
     p->reset();    
     loadDefaultGLProgram(p, kShaderType_PositionTextureColor_noMVP);
 
+    // Position Texture Color of instanced quads
+    p = getGLProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_INSTANCED);
+    p->reset();
+    loadDefaultGLProgram(p, kShaderType_PositionTextureColor_instanced);
+
     // Position Texture Color alpha test
     p = getGLProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_ALPHA_TEST);
     p->reset();    
@@ -315,6 +326,17 @@ void GLProgramCache::loadDefaultGLProgram(GLProgram *p, int type)
         case kShaderType_PositionTextureColor_noMVP:
             p->initWithByteArrays(ccPositionTextureColor_noMVP_vert, ccPositionTextureColor_noMVP_frag);
             break;
+        case kShaderType_PositionTextureColor_instanced:
+            p->initWithByteArrays(ccPositionTextureColor_instanced_vert, ccPositionTextureColor_noMVP_frag);
+            p->bindAttribLocation("a_corner", GLProgram::VERTEX_ATTRIB_POSITION);
+            p->bindAttribLocation("a_color", GLProgram::VERTEX_ATTRIB_COLOR);
+            p->bindAttribLocation("a_texOrigin", GLProgram::VERTEX_ATTRIB_TEX_COORD);
+            p->bindAttribLocation("a_origin", GLProgram::VERTEX_ATTRIB_INSTANCE_ORIGIN);
+            p->bindAttribLocation("a_xAxis", GLProgram::VERTEX_ATTRIB_INSTANCE_X_AXIS);
+            p->bindAttribLocation("a_yAxis", GLProgram::VERTEX_ATTRIB_INSTANCE_Y_AXIS);
+            p->bindAttribLocation("a_texXAxis", GLProgram::VERTEX_ATTRIB_INSTANCE_TEX_X_AXIS);
+            p->bindAttribLocation("a_texYAxis", GLProgram::VERTEX_ATTRIB_INSTANCE_TEX_Y_AXIS);
+            break;
 
         case kShaderType_PositionTextureColorAlphaTest:
             p->initWithByteArrays(ccPositionTextureColor_vert, ccPositionTextureColorAlphaTest_frag);
@@ -28,6 +28,8 @@ THE SOFTWARE.
 
 #include "renderer/CCGLProgramState.h"
 
+#include <algorithm>
+
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCGLProgramStateCache.h"
 #include "renderer/CCGLProgramCache.h"
@@ -60,12 +62,47 @@ UniformValue::UniformValue(Uniform *uniform, GLProgram* glprogram)
 {
 }
 
+UniformValue::UniformValue(const UniformValue& other)
+: _uniform(other._uniform)
+, _glprogram(other._glprogram)
+, _useCallback(other._useCallback)
+{
+    _value = other._value;
+    if (_useCallback)
+        _value.callback = new std::function<void(GLProgram*, Uniform*)>(*other._value.callback);
+}
+
 UniformValue::~UniformValue()
 {
 	if (_useCallback)
 		delete _value.callback;
 }
 
+UniformValue& UniformValue::operator=(const UniformValue& other)
+{
+    if (this != &other)
+    {
+        releaseCallback();
+
+        _uniform = other._uniform;
+        _glprogram = other._glprogram;
+        _useCallback = other._useCallback;
+        _value = other._value;
+        if (_useCallback)
+            _value.callback = new std::function<void(GLProgram*, Uniform*)>(*other._value.callback);
+    }
+    return *this;
+}
+
+void UniformValue::releaseCallback()
+{
+    if (_useCallback)
+    {
+        delete _value.callback;
+        _useCallback = false;
+    }
+}
+
 void UniformValue::apply()
 {
     if(_useCallback) {
@@ -113,24 +150,23 @@ void UniformValue::apply()
 
 void UniformValue::setCallback(const std::function<void(GLProgram*, Uniform*)> &callback)
 {
-	// delete previously set callback
-	// XXX TODO: memory will leak if the user does:
-	//    value->setCallback();
-	//    value->setFloat();
-	if (_useCallback)
-		delete _value.callback;
-
-    _value.callback = new std::function<void(GLProgram*, Uniform*)>();
-	*_value.callback = callback;
-
-    _useCallback = true;
+    // commands setting their callback before every draw reuse the previous one
+    if (_useCallback)
+    {
+        *_value.callback = callback;
+    }
+    else
+    {
+        _value.callback = new std::function<void(GLProgram*, Uniform*)>(callback);
+        _useCallback = true;
+    }
 }
 
 void UniformValue::setFloat(float value)
 {
     CCASSERT (_uniform->type == GL_FLOAT, "");
+    releaseCallback();
     _value.floatValue = value;
-    _useCallback = false;
 }
 /*
 void UniformValue::setTexture(GLuint textureId, GLuint textureUnit)
@@ -144,43 +180,43 @@ void UniformValue::setTexture(GLuint textureId, GLuint textureUnit)
 void UniformValue::setTexture(Texture2D* texture, GLuint textureUnit)
 {
 	CCASSERT(_uniform->type == GL_SAMPLER_2D, "Wrong type. expecting GL_SAMPLER_2D");
+	releaseCallback();
 	_value.tex.texture = texture;
 	_value.tex.textureUnit = textureUnit;
-	_useCallback = false;
 }
 void UniformValue::setInt(int value)
 {
     CCASSERT(_uniform->type == GL_INT, "Wrong type: expecting GL_INT");
+    releaseCallback();
     _value.intValue = value;
-    _useCallback = false;
 }
 
 void UniformValue::setVec2(const Vec2& value)
 {
     CCASSERT (_uniform->type == GL_FLOAT_VEC2, "");
+	releaseCallback();
 	memcpy(_value.v2Value, &value, sizeof(_value.v2Value));
-    _useCallback = false;
 }
 
 void UniformValue::setVec3(const Vec3& value)
 {
     CCASSERT (_uniform->type == GL_FLOAT_VEC3, "");
+	releaseCallback();
 	memcpy(_value.v3Value, &value, sizeof(_value.v3Value));
-	_useCallback = false;
 }
 
 void UniformValue::setVec4(const Vec4& value)
 {
     CCASSERT (_uniform->type == GL_FLOAT_VEC4, "");
+	releaseCallback();
 	memcpy(_value.v4Value, &value, sizeof(_value.v4Value));
-	_useCallback = false;
 }
 
 void UniformValue::setMat4(const Mat4& value)
 {
     CCASSERT(_uniform->type == GL_FLOAT_MAT4, "");
+	releaseCallback();
 	memcpy(_value.matrixValue, &value, sizeof(_value.matrixValue));
-	_useCallback = false;
 }
 
 //
@@ -316,19 +352,33 @@ bool GLProgramState::init(GLProgram* glprogram)
         _attributes[attrib.first] = value;
     }
 
+    _uniforms.reserve(_glprogram->_userUniforms.size());
     for(auto &uniform : _glprogram->_userUniforms) {
-        UniformValue value(&uniform.second, _glprogram);
-        _uniforms[uniform.second.location] = value;
-        _uniformsByName[uniform.first] = uniform.second.location;
+        _uniforms.push_back(UniformValue(&uniform.second, _glprogram));
     }
+    indexUniforms();
 
     return true;
 }
 
+void GLProgramState::indexUniforms()
+{
+    std::sort(_uniforms.begin(), _uniforms.end(), [](const UniformValue& a, const UniformValue& b) {
+        return a._uniform->location < b._uniform->location;
+    });
+
+    _uniformsByName.clear();
+    for (int i = 0; i < (int)_uniforms.size(); ++i)
+    {
+        _uniformsByName[_uniforms[i]._uniform->name] = i;
+    }
+}
+
 void GLProgramState::resetGLProgram()
 {
     CC_SAFE_RELEASE(_glprogram);
     _uniforms.clear();
+    _uniformsByName.clear();
     _attributes.clear();
     // first texture is GL_TEXTURE1
     _textureUnitIndex = 1;
@@ -348,10 +398,12 @@ void GLProgramState::applyGLProgram(const Mat4& modelView)
     CCASSERT(_glprogram, "invalid glprogram");
     if(_uniformAttributeValueDirty)
     {
-        for(auto& uniformLocation : _uniformsByName)
+        // the program was linked again, its uniforms may have moved
+        for(auto& uniformIndex : _uniformsByName)
         {
-            _uniforms[uniformLocation.second]._uniform = _glprogram->getUniform(uniformLocation.first);
+            _uniforms[uniformIndex.second]._uniform = _glprogram->getUniform(uniformIndex.first);
         }
+        indexUniforms();
         
         _vertexAttribsFlags = 0;
         for(auto& attributeValue : _attributes)
@@ -387,7 +439,7 @@ void GLProgramState::applyUniforms()
 {
     // set uniforms
     for(auto& uniform : _uniforms) {
-        uniform.second.apply();
+        uniform.apply();
     }
 }
 
@@ -403,9 +455,11 @@ void GLProgramState::setGLProgram(GLProgram *glprogram)
 
 UniformValue* GLProgramState::getUniformValue(GLint uniformLocation)
 {
-    const auto itr = _uniforms.find(uniformLocation);
-    if (itr != _uniforms.end())
-        return &itr->second;
+    const auto itr = std::lower_bound(_uniforms.begin(), _uniforms.end(), uniformLocation, [](const UniformValue& value, GLint location) {
+        return value._uniform->location < location;
+    });
+    if (itr != _uniforms.end() && itr->_uniform->location == uniformLocation)
+        return &(*itr);
     return nullptr;
 }
 
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #define __CCGLPROGRAMSTATE_H__
 
 #include <unordered_map>
+#include <vector>
 
 #include "base/ccTypes.h"
 #include "base/CCVector.h"
@@ -54,8 +55,11 @@ class CC_DLL UniformValue
 public:
     UniformValue();
     UniformValue(Uniform *uniform, GLProgram* glprogram);
+    UniformValue(const UniformValue& other);
     ~UniformValue();
 
+    UniformValue& operator=(const UniformValue& other);
+
     void setFloat(float value);
     void setInt(int value);
     void setVec2(const Vec2& value);
@@ -69,6 +73,9 @@ public:
     void apply();
 
 protected:
+    // frees the callback before the value is replaced by a plain one
+    void releaseCallback();
+
 	Uniform* _uniform;  // weak ref
     GLProgram* _glprogram; // weak ref
     bool _useCallback;
@@ -168,6 +175,7 @@ public:
      * @param applyAttribFlags Call GL::enableVertexAttribs(_vertexAttribsFlags) or not
      */
     void applyAttributes(bool applyAttribFlags = true);
+    /** sets the uniforms of the program. Values equal to the ones the program already has are not sent to GL */
     void applyUniforms();
 
     void setGLProgram(GLProgram* glprogram);
@@ -180,6 +188,9 @@ public:
     void setVertexAttribPointer(const std::string &name, GLint size, GLenum type, GLboolean normalized, GLsizei stride, GLvoid *pointer);
 
     // user defined uniforms
+    /** The setters taking a location avoid looking the uniform up by name.
+     Resolve the location once with getGLProgram()->getUniformLocation() and keep it while the GLProgram does not change.
+     */
     ssize_t getUniformCount() const { return _uniforms.size(); }
     void setUniformInt(const std::string &uniformName, int value);
     void setUniformFloat(const std::string &uniformName, float value);
@@ -209,10 +220,14 @@ protected:
     VertexAttribValue* getVertexAttribValue(const std::string &attributeName);
     UniformValue* getUniformValue(const std::string &uniformName);
     UniformValue* getUniformValue(GLint uniformLocation);
+    // sorts _uniforms by location and indexes them by name
+    void indexUniforms();
     
     bool _uniformAttributeValueDirty;
-    std::unordered_map<std::string, GLint> _uniformsByName;
-    std::unordered_map<GLint, UniformValue> _uniforms;
+    // index in _uniforms
+    std::unordered_map<std::string, int> _uniformsByName;
+    // sorted by location, applied in one pass over contiguous memory
+    std::vector<UniformValue> _uniforms;
     std::unordered_map<std::string, VertexAttribValue> _attributes;
     std::unordered_map<std::string, int> _boundTextureUnits;
 
@@ -51,6 +51,9 @@ MeshCommand::MeshCommand()
 : _textureID(0)
 , _blendType(BlendFunc::DISABLE)
 , _glProgramState(nullptr)
+, _uniformsProgram(nullptr)
+, _colorLocation(-1)
+, _matrixPaletteLocation(-1)
 , _cullFaceEnabled(false)
 , _cullFace(GL_BACK)
 , _depthTestEnabled(false)
@@ -189,7 +192,19 @@ void MeshCommand::genMaterialID(GLuint texID, void* glProgramState, void* mesh,
 
 void MeshCommand::MatrixPalleteCallBack( GLProgram* glProgram, Uniform* uniform)
 {
-    glUniform4fv( uniform->location, (GLsizei)_matrixPaletteSize, (const float*)_matrixPalette );
+    // goes through the program so an unchanged pose is not uploaded again
+    glProgram->setUniformLocationWith4fv(uniform->location, (const float*)_matrixPalette, _matrixPaletteSize);
+}
+
+void MeshCommand::resolveUniformLocations()
+{
+    GLProgram* glProgram = _glProgramState->getGLProgram();
+    if (glProgram != _uniformsProgram)
+    {
+        _uniformsProgram = glProgram;
+        _colorLocation = glProgram->getUniformLocation("u_color");
+        _matrixPaletteLocation = glProgram->getUniformLocation("u_matrixPalette");
+    }
 }
 
 void MeshCommand::preBatchDraw()
@@ -216,11 +231,12 @@ void MeshCommand::batchDraw()
     // set render state
     applyRenderState();
     
-    _glProgramState->setUniformVec4("u_color", _displayColor);
+    resolveUniformLocations();
+    _glProgramState->setUniformVec4(_colorLocation, _displayColor);
     
     if (_matrixPaletteSize && _matrixPalette)
     {
-        _glProgramState->setUniformCallback("u_matrixPalette", CC_CALLBACK_2(MeshCommand::MatrixPalleteCallBack, this));
+        _glProgramState->setUniformCallback(_matrixPaletteLocation, CC_CALLBACK_2(MeshCommand::MatrixPalleteCallBack, this));
         
     }
     
@@ -256,11 +272,12 @@ void MeshCommand::execute()
     GL::blendFunc(_blendType.src, _blendType.dst);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
-    _glProgramState->setUniformVec4("u_color", _displayColor);
+    resolveUniformLocations();
+    _glProgramState->setUniformVec4(_colorLocation, _displayColor);
     
     if (_matrixPaletteSize && _matrixPalette)
     {
-        _glProgramState->setUniformCallback("u_matrixPalette", CC_CALLBACK_2(MeshCommand::MatrixPalleteCallBack, this));
+        _glProgramState->setUniformCallback(_matrixPaletteLocation, CC_CALLBACK_2(MeshCommand::MatrixPalleteCallBack, this));
         
     }
     
@@ -314,6 +331,8 @@ void MeshCommand::releaseVAO()
 void MeshCommand::listenRendererRecreated(EventCustom* event)
 {
     _vao = 0;
+    // the programs are linked again, their uniforms may have moved
+    _uniformsProgram = nullptr;
 }
 #endif
 
@@ -91,8 +91,15 @@ protected:
     
     void MatrixPalleteCallBack( GLProgram* glProgram, Uniform* uniform);
 
+    // looks the uniforms set before every draw up once per program. Called when drawing: init() may run on a visit worker without GL context
+    void resolveUniformLocations();
+
     GLuint _textureID;
     GLProgramState* _glProgramState;
+    // program of the locations below
+    GLProgram* _uniformsProgram;
+    GLint _colorLocation;
+    GLint _matrixPaletteLocation;
     BlendFunc _blendType;
 
     GLuint _textrueID;
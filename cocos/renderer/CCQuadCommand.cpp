@@ -87,6 +87,9 @@ void QuadCommand::generateMaterialID()
 
         _materialID = XXH32((const void*)intArray, sizeof(intArray), 0);
     }
+
+    bool translucent = _blendType.src != BlendFunc::DISABLE.src || _blendType.dst != BlendFunc::DISABLE.dst;
+    _sortMaterial = (translucent ? 0x80000000 : 0) | (_materialID >> 1);
 }
 
 void QuadCommand::useMaterial() const
@@ -58,6 +58,20 @@ public:
     /** Returns the Command type */
     inline Type getType() const { return _type; }
 
+    /** Returns a 64 bits key that sorts the commands by global order, then opaque before translucent, then by material.
+     The global order is in the high 32 bits, the material part is 0 for commands that can't be batched.
+     */
+    inline uint64_t getSortKey() const { return ((uint64_t)orderToBits(_globalOrder) << 32) | _sortMaterial; }
+
+    /** Maps a global order to an unsigned integer that compares the same way (-0 and 0 excepted) */
+    static inline uint32_t orderToBits(float order)
+    {
+        union { float f; uint32_t u; } bits;
+        bits.f = order;
+        // negative floats compare in reverse order of their bits, positive ones are moved above them
+        return (bits.u & 0x80000000) ? ~bits.u : (bits.u | 0x80000000);
+    }
+
 protected:
     RenderCommand();
     virtual ~RenderCommand();
@@ -69,6 +83,9 @@ protected:
 
     // commands are sort by depth
     float _globalOrder;
+
+    // low 32 bits of the sort key: translucency in the highest bit, material in the others
+    uint32_t _sortMaterial;
 };
 
 NS_CC_END
@@ -0,0 +1,84 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/CCRenderCommandBuffer.h"
+
+NS_CC_BEGIN
+
+RenderCommandBuffer::RenderCommandBuffer()
+{
+}
+
+void RenderCommandBuffer::addCommand(RenderCommand* command)
+{
+    Op op = { OpType::ADD_COMMAND, -1, command };
+    _ops.push_back(op);
+}
+
+void RenderCommandBuffer::addCommand(RenderCommand* command, int renderQueue)
+{
+    CCASSERT(renderQueue >= 0, "Invalid render queue");
+    Op op = { OpType::ADD_COMMAND, renderQueue, command };
+    _ops.push_back(op);
+}
+
+void RenderCommandBuffer::pushGroup(int renderQueueID)
+{
+    Op op = { OpType::PUSH_GROUP, renderQueueID, nullptr };
+    _ops.push_back(op);
+}
+
+void RenderCommandBuffer::popGroup()
+{
+    Op op = { OpType::POP_GROUP, 0, nullptr };
+    _ops.push_back(op);
+}
+
+void RenderCommandBuffer::defer(const std::function<void()>& func)
+{
+    Op op = { OpType::DEFERRED, (int)_deferred.size(), nullptr };
+    _deferred.push_back(func);
+    _ops.push_back(op);
+}
+
+void RenderCommandBuffer::clear()
+{
+    _ops.clear();
+    _deferred.clear();
+}
+
+bool RenderCommandBuffer::getCommands(std::vector<RenderCommand*>* commands) const
+{
+    for (const auto& op : _ops)
+    {
+        if (op.type != OpType::ADD_COMMAND || op.arg >= 0)
+        {
+            return false;
+        }
+        commands->push_back(op.command);
+    }
+    return true;
+}
+
+NS_CC_END
@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_RENDER_COMMAND_BUFFER_H__
+#define __CC_RENDER_COMMAND_BUFFER_H__
+
+#include <vector>
+#include <functional>
+
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+class RenderCommand;
+class Renderer;
+
+/** Records the calls a node visit makes on the Renderer so they can be replayed later, in order.
+
+ While the scene is visited in parallel, every worker thread fills its own buffers instead of
+ touching the render queues. The main thread then replays the buffers in scene order with
+ Renderer::replay(), so the render queues end up exactly as after a serial visit.
+ */
+class CC_DLL RenderCommandBuffer
+{
+public:
+    RenderCommandBuffer();
+
+    /** Records Renderer::addCommand(command). The render queue is resolved when replaying */
+    void addCommand(RenderCommand* command);
+    /** Records Renderer::addCommand(command, renderQueue) */
+    void addCommand(RenderCommand* command, int renderQueue);
+    /** Records Renderer::pushGroup(renderQueueID) */
+    void pushGroup(int renderQueueID);
+    /** Records Renderer::popGroup() */
+    void popGroup();
+    /** Records a function that is run on the main thread when replaying, eg: the visit of a node that can't be visited in parallel */
+    void defer(const std::function<void()>& func);
+
+    /** Removes every recorded call. The memory is kept for the next frame */
+    void clear();
+    bool empty() const { return _ops.empty(); }
+
+    /** Appends the recorded commands to `commands`, in order.
+     Returns false if anything else than addCommand(command) calls to the current render queue was recorded
+     */
+    bool getCommands(std::vector<RenderCommand*>* commands) const;
+    ssize_t size() const { return _ops.size(); }
+
+protected:
+    friend class Renderer;
+
+    enum class OpType
+    {
+        ADD_COMMAND,
+        PUSH_GROUP,
+        POP_GROUP,
+        DEFERRED,
+    };
+
+    struct Op
+    {
+        OpType type;
+        /** render queue ID, -1 means the top of the group stack. Index in _deferred for DEFERRED ops */
+        int arg;
+        RenderCommand* command;
+    };
+
+    std::vector<Op> _ops;
+    std::vector<std::function<void()>> _deferred;
+};
+
+NS_CC_END
+
+#endif /* __CC_RENDER_COMMAND_BUFFER_H__ */
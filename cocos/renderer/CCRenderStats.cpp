@@ -0,0 +1,189 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/CCRenderStats.h"
+
+#include <string.h>
+#include <algorithm>
+
+NS_CC_BEGIN
+
+ssize_t RenderStats::s_textureBinds = 0;
+ssize_t RenderStats::s_programSwitches = 0;
+ssize_t RenderStats::s_bytesUploaded = 0;
+
+RenderFrameStats::RenderFrameStats()
+{
+    reset();
+}
+
+void RenderFrameStats::reset()
+{
+    frame = 0;
+    memset(commands, 0, sizeof(commands));
+    quadsBatched = quadsInstanced = 0;
+    memset(flushes, 0, sizeof(flushes));
+    materialSwitches = 0;
+    drawnBatches = drawnVertices = 0;
+    bytesUploaded = textureBinds = programSwitches = 0;
+    visitTime = sortTime = renderTime = 0;
+}
+
+RenderStats::RenderStats()
+: _head(0)
+, _count(0)
+, _frameNumber(0)
+{
+    _history.resize(DEFAULT_HISTORY_SIZE);
+    beginFrame();
+}
+
+const RenderFrameStats* RenderStats::getFrame(int age) const
+{
+    if (age < 0 || age >= _count)
+        return nullptr;
+
+    int size = (int)_history.size();
+    return &_history[(_head - 1 - age + size) % size];
+}
+
+void RenderStats::setHistorySize(int frames)
+{
+    CCASSERT(frames > 0, "The history must keep at least one frame");
+    _history.assign(frames, RenderFrameStats());
+    _head = _count = 0;
+}
+
+void RenderStats::beginFrame()
+{
+    _current.reset();
+    _current.frame = _frameNumber;
+
+    _textureBindsBase = s_textureBinds;
+    _programSwitchesBase = s_programSwitches;
+    _bytesUploadedBase = s_bytesUploaded;
+}
+
+void RenderStats::endFrame()
+{
+    _current.textureBinds = s_textureBinds - _textureBindsBase;
+    _current.programSwitches = s_programSwitches - _programSwitchesBase;
+    _current.bytesUploaded = s_bytesUploaded - _bytesUploadedBase;
+
+    _history[_head] = _current;
+    _head = (_head + 1) % (int)_history.size();
+    if (_count < (int)_history.size())
+        ++_count;
+
+    ++_frameNumber;
+    beginFrame();
+}
+
+void RenderStats::reset()
+{
+    _head = _count = 0;
+    beginFrame();
+}
+
+static void appendFrame(std::string& out, const char* label, const RenderFrameStats& stats)
+{
+    typedef RenderFrameStats::FlushCause FlushCause;
+    typedef RenderCommand::Type Type;
+
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+        "%s: draws %ld, verts %ld | commands quad %ld, custom %ld, batch %ld, group %ld, mesh %ld, primitive %ld"
+        " | quads %ld, instanced %ld | flushes vbo full %ld, material %ld, command %ld, end %ld"
+        " | switches material %ld, texture %ld, program %ld | uploaded %ld bytes | visit %.2f ms, sort %.2f ms, render %.2f ms\n",
+        label, (long)stats.drawnBatches, (long)stats.drawnVertices,
+        (long)stats.commands[(int)Type::QUAD_COMMAND], (long)stats.commands[(int)Type::CUSTOM_COMMAND],
+        (long)stats.commands[(int)Type::BATCH_COMMAND], (long)stats.commands[(int)Type::GROUP_COMMAND],
+        (long)stats.commands[(int)Type::MESH_COMMAND], (long)stats.commands[(int)Type::PRIMITIVE_COMMAND],
+        (long)stats.quadsBatched, (long)stats.quadsInstanced,
+        (long)stats.flushes[(int)FlushCause::VBO_FULL], (long)stats.flushes[(int)FlushCause::MATERIAL_CHANGE],
+        (long)stats.flushes[(int)FlushCause::NON_QUAD_COMMAND], (long)stats.flushes[(int)FlushCause::END_OF_QUEUE],
+        (long)stats.materialSwitches, (long)stats.textureBinds, (long)stats.programSwitches,
+        (long)stats.bytesUploaded,
+        stats.visitTime, stats.sortTime, stats.renderTime);
+    out += buffer;
+}
+
+std::string RenderStats::getDescription(int frames) const
+{
+    std::string out;
+    frames = std::min(frames, _count);
+    if (frames <= 0)
+        return "no frame rendered yet\n";
+
+    RenderFrameStats sum;
+    for (int age = 0; age < frames; ++age)
+    {
+        const RenderFrameStats& stats = *getFrame(age);
+
+        char label[32];
+        snprintf(label, sizeof(label), "frame %u", stats.frame);
+        appendFrame(out, label, stats);
+
+        for (int i = 0; i < RenderFrameStats::COMMAND_TYPES; ++i)
+            sum.commands[i] += stats.commands[i];
+        for (int i = 0; i < (int)RenderFrameStats::FlushCause::MAX; ++i)
+            sum.flushes[i] += stats.flushes[i];
+        sum.quadsBatched += stats.quadsBatched;
+        sum.quadsInstanced += stats.quadsInstanced;
+        sum.materialSwitches += stats.materialSwitches;
+        sum.drawnBatches += stats.drawnBatches;
+        sum.drawnVertices += stats.drawnVertices;
+        sum.bytesUploaded += stats.bytesUploaded;
+        sum.textureBinds += stats.textureBinds;
+        sum.programSwitches += stats.programSwitches;
+        sum.visitTime += stats.visitTime;
+        sum.sortTime += stats.sortTime;
+        sum.renderTime += stats.renderTime;
+    }
+
+    // averages, rounded down
+    for (int i = 0; i < RenderFrameStats::COMMAND_TYPES; ++i)
+        sum.commands[i] /= frames;
+    for (int i = 0; i < (int)RenderFrameStats::FlushCause::MAX; ++i)
+        sum.flushes[i] /= frames;
+    sum.quadsBatched /= frames;
+    sum.quadsInstanced /= frames;
+    sum.materialSwitches /= frames;
+    sum.drawnBatches /= frames;
+    sum.drawnVertices /= frames;
+    sum.bytesUploaded /= frames;
+    sum.textureBinds /= frames;
+    sum.programSwitches /= frames;
+    sum.visitTime /= frames;
+    sum.sortTime /= frames;
+    sum.renderTime /= frames;
+
+    char label[32];
+    snprintf(label, sizeof(label), "average of %d", frames);
+    appendFrame(out, label, sum);
+
+    return out;
+}
+
+NS_CC_END
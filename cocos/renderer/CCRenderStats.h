@@ -0,0 +1,153 @@
+/****************************************************************************
+ Copyright (c) 2014 Fourth Sky Interactive
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_RENDER_STATS_H__
+#define __CC_RENDER_STATS_H__
+
+#include <vector>
+#include <string>
+#include <chrono>
+
+#include "base/ccMacros.h"
+#include "renderer/CCRenderCommand.h"
+
+NS_CC_BEGIN
+
+/** Counters of one frame, see RenderStats */
+struct CC_DLL RenderFrameStats
+{
+    /** Why the quads batched so far were drawn */
+    enum class FlushCause
+    {
+        /** the streaming buffer is full, the next quads start at its beginning */
+        VBO_FULL,
+        /** the next quads use another texture, shader or blending function */
+        MATERIAL_CHANGE,
+        /** a command that is not a QuadCommand must be executed */
+        NON_QUAD_COMMAND,
+        /** end of a Renderer::render() call */
+        END_OF_QUEUE,
+
+        MAX
+    };
+
+    static const int COMMAND_TYPES = (int)RenderCommand::Type::PRIMITIVE_COMMAND + 1;
+
+    RenderFrameStats();
+    void reset();
+
+    unsigned int frame;
+
+    /** executed commands, by RenderCommand::Type */
+    ssize_t commands[COMMAND_TYPES];
+    /** quads written to the streaming buffers, instanced ones included */
+    ssize_t quadsBatched;
+    ssize_t quadsInstanced;
+    /** draw calls of batched quads, by cause */
+    ssize_t flushes[(int)FlushCause::MAX];
+    ssize_t materialSwitches;
+    ssize_t drawnBatches;
+    ssize_t drawnVertices;
+
+    /** bytes sent to vertex and index buffers */
+    ssize_t bytesUploaded;
+    /** texture binds and glUseProgram calls that got past the GL state cache */
+    ssize_t textureBinds;
+    ssize_t programSwitches;
+
+    /** milliseconds spent visiting the scene, sorting the render queues and executing the commands */
+    float visitTime;
+    float sortTime;
+    float renderTime;
+};
+
+/** Render statistics of the last frames.
+
+ The Renderer fills the current frame while it renders, the Director closes it once the buffers are swapped.
+ The closed frames are kept in a ring of the last getHistorySize() frames, cheap enough to stay on in release builds.
+ The console prints them with the `renderstats` command.
+ */
+class CC_DLL RenderStats
+{
+public:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    static const int DEFAULT_HISTORY_SIZE = 120;
+
+    RenderStats();
+
+    /** Frame being rendered */
+    RenderFrameStats& getCurrentFrame() { return _current; }
+
+    /** A finished frame, 0 is the last one. nullptr if `age` is not in the history */
+    const RenderFrameStats* getFrame(int age) const;
+    /** Number of finished frames in the history */
+    int getFrameCount() const { return _count; }
+
+    /** Number of frames kept. Changing it clears the history */
+    void setHistorySize(int frames);
+    int getHistorySize() const { return (int)_history.size(); }
+
+    /** Moves the current frame to the history and starts a new one */
+    void endFrame();
+    /** Clears the history and the current frame */
+    void reset();
+
+    /** Text dump of the last `frames` frames, the most recent first, and of their average */
+    std::string getDescription(int frames) const;
+
+    /** Milliseconds elapsed since `start` */
+    static float millisecondsSince(const Clock::time_point& start)
+    {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+
+    // Incremented where the work happens: the GL state cache and the vertex and index buffers.
+    // They only grow, every frame stores how much they grew during it
+    static void addTextureBind() { ++s_textureBinds; }
+    static void addProgramSwitch() { ++s_programSwitches; }
+    static void addBytesUploaded(ssize_t bytes) { s_bytesUploaded += bytes; }
+
+protected:
+    void beginFrame();
+
+    RenderFrameStats _current;
+    std::vector<RenderFrameStats> _history;
+    int _head;
+    int _count;
+    unsigned int _frameNumber;
+
+    // values of the global counters when the current frame began
+    ssize_t _textureBindsBase;
+    ssize_t _programSwitchesBase;
+    ssize_t _bytesUploadedBase;
+
+    static ssize_t s_textureBinds;
+    static ssize_t s_programSwitches;
+    static ssize_t s_bytesUploaded;
+};
+
+NS_CC_END
+
+#endif /* __CC_RENDER_STATS_H__ */
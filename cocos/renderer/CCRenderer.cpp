@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include "renderer/CCRenderer.h"
 
 #include <algorithm>
+#include <string.h>
 
 #include "renderer/CCQuadCommand.h"
 #include "renderer/CCBatchCommand.h"
@@ -32,6 +33,7 @@ THE SOFTWARE.
 #include "renderer/CCGroupCommand.h"
 #include "renderer/CCPrimitiveCommand.h"
 #include "renderer/CCGLProgramCache.h"
+#include "renderer/CCTexture2D.h"
 #include "renderer/ccGLStateCache.h"
 #include "renderer/CCMeshCommand.h"
 #include "base/CCConfiguration.h"
@@ -41,26 +43,43 @@ THE SOFTWARE.
 #include "base/CCEventType.h"
 #include "renderer/CCVertexIndexBuffer.h"
 #include "renderer/CCVertexIndexData.h"
+#include "math/MathUtil.h"
 
 NS_CC_BEGIN
 
-// helper
-static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
+// queue
+
+// below this size std::stable_sort beats the 4 to 8 passes of the radix sort
+static const size_t RADIX_SORT_THRESHOLD = 64;
+// the number of barriers is stored in 16 bits of the keys
+static const uint32_t MAX_BARRIERS = 0xFFFF;
+
+RenderQueue::RenderQueue()
+: _barriers(0)
 {
-	return a->getGlobalOrder() < b->getGlobalOrder();
 }
 
-// queue
-
 void RenderQueue::push_back(RenderCommand* command)
 {
+	if (command->getType() != RenderCommand::Type::QUAD_COMMAND)
+	{
+		++_barriers;
+	}
+
+	uint64_t sortKey = command->getSortKey();
+	uint64_t key = (sortKey & 0xFFFFFFFF00000000ull)
+		| ((uint64_t)std::min(_barriers, MAX_BARRIERS) << 16)
+		| ((sortKey >> 16) & 0xFFFF);
+
+	Element element = { key, command };
+
 	float z = command->getGlobalOrder();
 	if (z < 0)
-		_queueNegZ.push_back(command);
+		_queueNegZ.push_back(element);
 	else if (z > 0)
-		_queuePosZ.push_back(command);
+		_queuePosZ.push_back(element);
 	else
-		_queue0.push_back(command);
+		_queue0.push_back(element);
 }
 
 ssize_t RenderQueue::size() const
@@ -68,27 +87,91 @@ ssize_t RenderQueue::size() const
 	return _queueNegZ.size() + _queue0.size() + _queuePosZ.size();
 }
 
-void RenderQueue::sort()
+void RenderQueue::sort(bool byMaterial)
 {
-	// Don't sort _queue0, it already comes sorted
-	std::sort(std::begin(_queueNegZ), std::end(_queueNegZ), compareRenderCommand);
-	std::sort(std::begin(_queuePosZ), std::end(_queuePosZ), compareRenderCommand);
+	if (byMaterial && _barriers <= MAX_BARRIERS)
+	{
+		radixSort(_queueNegZ, 0);
+		radixSort(_queue0, 0);
+		radixSort(_queuePosZ, 0);
+	}
+	else
+	{
+		// Only sort on the global order, the 32 high bits. Don't sort _queue0, it already comes sorted
+		radixSort(_queueNegZ, 4);
+		radixSort(_queuePosZ, 4);
+	}
+}
+
+void RenderQueue::radixSort(std::vector<Element>& elements, int firstByte)
+{
+	const size_t count = elements.size();
+	if (count < 2)
+		return;
+
+	if (count < RADIX_SORT_THRESHOLD)
+	{
+		const int shift = firstByte * 8;
+		std::stable_sort(std::begin(elements), std::end(elements), [shift](const Element& a, const Element& b) {
+			return (a.key >> shift) < (b.key >> shift);
+		});
+		return;
+	}
+
+	// least significant byte first, every pass is stable
+	uint32_t histograms[8][256];
+	memset(histograms, 0, sizeof(histograms));
+	for (const auto& element : elements)
+	{
+		for (int byte = firstByte; byte < 8; ++byte)
+			histograms[byte][(element.key >> (byte * 8)) & 0xFF]++;
+	}
+
+	_sortBuffer.resize(count);
+	Element* src = elements.data();
+	Element* dst = _sortBuffer.data();
+
+	for (int byte = firstByte; byte < 8; ++byte)
+	{
+		const int shift = byte * 8;
+		uint32_t* histogram = histograms[byte];
+
+		// skip the pass when every key has the same byte, it happens a lot with the global orders
+		if (histogram[(src[0].key >> shift) & 0xFF] == count)
+			continue;
+
+		uint32_t offset = 0;
+		for (int i = 0; i < 256; ++i)
+		{
+			uint32_t n = histogram[i];
+			histogram[i] = offset;
+			offset += n;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+			dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+		std::swap(src, dst);
+	}
+
+	if (src != elements.data())
+		memcpy(elements.data(), src, count * sizeof(Element));
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
 {
 	if (index < static_cast<ssize_t>(_queueNegZ.size()))
-		return _queueNegZ[index];
+		return _queueNegZ[index].command;
 
 	index -= _queueNegZ.size();
 
 	if (index < static_cast<ssize_t>(_queue0.size()))
-		return _queue0[index];
+		return _queue0[index].command;
 
 	index -= _queue0.size();
 
 	if (index < static_cast<ssize_t>(_queuePosZ.size()))
-		return _queuePosZ[index];
+		return _queuePosZ[index].command;
 
 	CCASSERT(false, "invalid index");
 	return nullptr;
@@ -99,6 +182,7 @@ void RenderQueue::clear()
 	_queueNegZ.clear();
 	_queue0.clear();
 	_queuePosZ.clear();
+	_barriers = 0;
 }
 
 //
@@ -110,14 +194,30 @@ static const int DEFAULT_RENDER_QUEUE = 0;
 // constructors, destructors, init
 //
 Renderer::Renderer()
-	: _lastMaterialID(0)
+	: _vertexBuffer(nullptr)
+	, _indexBuffer(nullptr)
+	, _vertexData(nullptr)
+	, _lastMaterialID(0)
 	, _lastBatchedMeshCommand(nullptr)
+	, _streamQuads(nullptr)
+	, _streamFirstQuad(0)
+	, _streamQuadCapacity(0)
 	, _numQuads(0)
+	, _instancingEnabled(false)
+	, _instanceBuffer(nullptr)
+	, _cornerBuffer(nullptr)
+	, _instanceData(nullptr)
+	, _spriteProgram(nullptr)
+	, _instancedProgram(nullptr)
+	, _streamInstances(nullptr)
+	, _streamFirstInstance(0)
+	, _streamInstanceCapacity(0)
+	, _numInstances(0)
 	, _glViewAssigned(false)
 	, _isRendering(false)
-	, _vertexBuffer(nullptr)
-	, _indexBuffer(nullptr)
-	, _vertexData(nullptr)
+	, _isRecording(false)
+	, _materialSortEnabled(false)
+	, _cullingEnabled(true)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
 	, _cacheTextureListener(nullptr)
 #endif
@@ -128,7 +228,7 @@ Renderer::Renderer()
 
 	RenderQueue defaultRenderQueue;
 	_renderGroups.push_back(defaultRenderQueue);
-	_batchedQuadCommands.reserve(BATCH_QUADCOMMAND_RESEVER_SIZE);
+	_batchedQuads.reserve(BATCH_QUADCOMMAND_RESEVER_SIZE);
 }
 
 Renderer::~Renderer()
@@ -139,6 +239,9 @@ Renderer::~Renderer()
 	CC_SAFE_RELEASE(_vertexBuffer);
 	CC_SAFE_RELEASE(_indexBuffer);
 	CC_SAFE_RELEASE(_vertexData);
+	CC_SAFE_RELEASE(_instanceBuffer);
+	CC_SAFE_RELEASE(_cornerBuffer);
+	CC_SAFE_RELEASE(_instanceData);
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
 	Director::getInstance()->getEventDispatcher()->removeEventListener(_cacheTextureListener);
@@ -165,7 +268,8 @@ void Renderer::initGLView()
 
 void Renderer::setupIndices()
 {
-	for (int i = 0; i < VBO_SIZE; i++)
+	_indices.resize(6 * STREAM_QUADS);
+	for (int i = 0; i < STREAM_QUADS; i++)
 	{
 		_indices[i * 6 + 0] = (GLushort)(i * 4 + 0);
 		_indices[i * 6 + 1] = (GLushort)(i * 4 + 1);
@@ -179,8 +283,8 @@ void Renderer::setupIndices()
 void Renderer::setupVBOAndVAO()
 {
 	// Create buffers
-	_vertexBuffer = VertexBuffer::create(sizeof(V3F_C4B_T2F), 4 * VBO_SIZE, true);
-	_indexBuffer = IndexBuffer::create(IndexBuffer::IndexType::INDEX_TYPE_SHORT_16, 6 * VBO_SIZE, false);
+	_vertexBuffer = VertexBuffer::createStreaming(sizeof(V3F_C4B_T2F), 4 * STREAM_QUADS);
+	_indexBuffer = IndexBuffer::create(IndexBuffer::IndexType::INDEX_TYPE_SHORT_16, 6 * STREAM_QUADS, false);
 	_vertexBuffer->retain();
 	_indexBuffer->retain();
 
@@ -198,22 +302,75 @@ void Renderer::setupVBOAndVAO()
 
 	// tex coords
 	_vertexData->setStream(_vertexBuffer, VertexStreamAttribute(offsetof(V3F_C4B_T2F, texCoords), GLProgram::VERTEX_ATTRIB_TEX_COORD, GL_FLOAT, 2));
+
+	// the instanced path is set up again on first use
+	CC_SAFE_RELEASE_NULL(_instanceBuffer);
+	CC_SAFE_RELEASE_NULL(_cornerBuffer);
+	CC_SAFE_RELEASE_NULL(_instanceData);
+}
+
+static VertexStreamAttribute instanceAttribute(int offset, int semantic, int type, int size, bool normalize = false)
+{
+	VertexStreamAttribute attribute(offset, semantic, type, size, normalize);
+	attribute._divisor = 1;
+	return attribute;
+}
+
+void Renderer::setupInstancing()
+{
+	auto programCache = GLProgramCache::getInstance();
+	_spriteProgram = programCache->getGLProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP);
+	_instancedProgram = programCache->getGLProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_INSTANCED);
+
+	// corners of the unit quad, in the order of V3F_C4B_T2F_Quad so that the first 6 indices draw it
+	static const Vec2 corners[4] = { Vec2(0, 1), Vec2(0, 0), Vec2(1, 1), Vec2(1, 0) };
+	_cornerBuffer = VertexBuffer::create(sizeof(Vec2), 4);
+	_cornerBuffer->retain();
+	_cornerBuffer->updateVertices(corners, 4, 0);
+
+	_instanceBuffer = VertexBuffer::createStreaming(sizeof(V3F_C4B_T2F_QuadInstance), STREAM_INSTANCES);
+	_instanceBuffer->retain();
+
+	_instanceData = VertexData::create();
+	_instanceData->retain();
+
+	_instanceData->setStream(_cornerBuffer, VertexStreamAttribute(0, GLProgram::VERTEX_ATTRIB_POSITION, GL_FLOAT, 2));
+
+	_instanceData->setStream(_instanceBuffer, instanceAttribute(offsetof(V3F_C4B_T2F_QuadInstance, origin), GLProgram::VERTEX_ATTRIB_INSTANCE_ORIGIN, GL_FLOAT, 3));
+	_instanceData->setStream(_instanceBuffer, instanceAttribute(offsetof(V3F_C4B_T2F_QuadInstance, xAxis), GLProgram::VERTEX_ATTRIB_INSTANCE_X_AXIS, GL_FLOAT, 3));
+	_instanceData->setStream(_instanceBuffer, instanceAttribute(offsetof(V3F_C4B_T2F_QuadInstance, yAxis), GLProgram::VERTEX_ATTRIB_INSTANCE_Y_AXIS, GL_FLOAT, 3));
+	_instanceData->setStream(_instanceBuffer, instanceAttribute(offsetof(V3F_C4B_T2F_QuadInstance, texOrigin), GLProgram::VERTEX_ATTRIB_TEX_COORD, GL_FLOAT, 2));
+	_instanceData->setStream(_instanceBuffer, instanceAttribute(offsetof(V3F_C4B_T2F_QuadInstance, texXAxis), GLProgram::VERTEX_ATTRIB_INSTANCE_TEX_X_AXIS, GL_FLOAT, 2));
+	_instanceData->setStream(_instanceBuffer, instanceAttribute(offsetof(V3F_C4B_T2F_QuadInstance, texYAxis), GLProgram::VERTEX_ATTRIB_INSTANCE_TEX_Y_AXIS, GL_FLOAT, 2));
+	_instanceData->setStream(_instanceBuffer, instanceAttribute(offsetof(V3F_C4B_T2F_QuadInstance, color), GLProgram::VERTEX_ATTRIB_COLOR, GL_UNSIGNED_BYTE, 4, true));
 }
 
 void Renderer::mapBuffers()
 {
-	_vertexBuffer->updateVertices(_quads, 4 * VBO_SIZE, 0);
-	_indexBuffer->updateIndices(_indices, 6 * VBO_SIZE, 0);
+	// the vertices are streamed, see batchQuads()
+	_indexBuffer->updateIndices(_indices.data(), 6 * STREAM_QUADS, 0);
 }
 
 void Renderer::addCommand(RenderCommand* command)
 {
+	if (_isRecording)
+	{
+		getRecordingBuffer()->addCommand(command);
+		return;
+	}
+
 	int renderQueue = _commandGroupStack.top();
 	addCommand(command, renderQueue);
 }
 
 void Renderer::addCommand(RenderCommand* command, int renderQueue)
 {
+	if (_isRecording)
+	{
+		getRecordingBuffer()->addCommand(command, renderQueue);
+		return;
+	}
+
 	CCASSERT(!_isRendering, "Cannot add command while rendering");
 	CCASSERT(renderQueue >= 0, "Invalid render queue");
 	CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
@@ -222,18 +379,102 @@ void Renderer::addCommand(RenderCommand* command, int renderQueue)
 
 void Renderer::pushGroup(int renderQueueID)
 {
+	if (_isRecording)
+	{
+		getRecordingBuffer()->pushGroup(renderQueueID);
+		return;
+	}
+
 	CCASSERT(!_isRendering, "Cannot change render queue while rendering");
 	_commandGroupStack.push(renderQueueID);
 }
 
 void Renderer::popGroup()
 {
+	if (_isRecording)
+	{
+		getRecordingBuffer()->popGroup();
+		return;
+	}
+
 	CCASSERT(!_isRendering, "Cannot change render queue while rendering");
 	_commandGroupStack.pop();
 }
 
+void Renderer::beginRecording(const std::vector<std::thread::id>& threads)
+{
+	CCASSERT(!_isRendering, "Cannot record commands while rendering");
+	CCASSERT(!_isRecording, "Already recording");
+
+	_recordingSlots.resize(threads.size());
+	for (size_t i = 0; i < threads.size(); ++i)
+	{
+		_recordingSlots[i].thread = threads[i];
+		_recordingSlots[i].buffer = nullptr;
+	}
+	_isRecording = true;
+}
+
+void Renderer::endRecording()
+{
+	_isRecording = false;
+}
+
+RenderCommandBuffer* Renderer::getRecordingBuffer() const
+{
+	// a handful of threads at most, a linear search is faster than any map
+	auto threadID = std::this_thread::get_id();
+	for (const auto& slot : _recordingSlots)
+	{
+		if (slot.thread == threadID)
+		{
+			CCASSERT(slot.buffer, "No command buffer assigned to this thread");
+			return slot.buffer;
+		}
+	}
+
+	CCASSERT(false, "This thread is not recording commands");
+	return nullptr;
+}
+
+void Renderer::defer(const std::function<void()>& func)
+{
+	if (_isRecording)
+		getRecordingBuffer()->defer(func);
+	else
+		func();
+}
+
+void Renderer::replay(const RenderCommandBuffer& buffer)
+{
+	CCASSERT(!_isRecording, "Cannot replay commands while recording");
+
+	for (const auto& op : buffer._ops)
+	{
+		switch (op.type)
+		{
+		case RenderCommandBuffer::OpType::ADD_COMMAND:
+			if (op.arg < 0)
+				addCommand(op.command);
+			else
+				addCommand(op.command, op.arg);
+			break;
+		case RenderCommandBuffer::OpType::PUSH_GROUP:
+			pushGroup(op.arg);
+			break;
+		case RenderCommandBuffer::OpType::POP_GROUP:
+			popGroup();
+			break;
+		case RenderCommandBuffer::OpType::DEFERRED:
+			buffer._deferred[op.arg]();
+			break;
+		}
+	}
+}
+
 int Renderer::createRenderQueue()
 {
+	CCASSERT(!_isRecording, "Cannot create a render queue while recording, GroupCommands must be created on the main thread");
 	RenderQueue newRenderQueue;
 	_renderGroups.push_back(newRenderQueue);
 	return (int)_renderGroups.size() - 1;
@@ -242,59 +483,57 @@ int Renderer::createRenderQueue()
 void Renderer::visitRenderQueue(const RenderQueue& queue)
 {
 	ssize_t size = queue.size();
+	bool useInstancing = _instancingEnabled && Configuration::getInstance()->supportsInstancing();
+
+	if (useInstancing && !_instanceData)
+	{
+		setupInstancing();
+	}
+
+	RenderFrameStats& stats = _stats.getCurrentFrame();
 
 	for (ssize_t index = 0; index < size; ++index)
 	{
 		auto command = queue[index];
 		auto commandType = command->getType();
+		stats.commands[(int)commandType]++;
 		if (RenderCommand::Type::QUAD_COMMAND == commandType)
 		{
 			flush3D();
 			auto cmd = static_cast<QuadCommand*>(command);
-			//Batch quads
-			if (_numQuads + cmd->getQuadCount() > VBO_SIZE)
+			//Batch quads, as instances when possible
+			if (!(useInstancing && isInstanceable(cmd) && batchInstances(cmd)))
 			{
-				CCASSERT(cmd->getQuadCount() >= 0 && cmd->getQuadCount() < VBO_SIZE, "VBO is not big enough for quad data, please break the quad data down or use customized render command");
-
-				//Draw batched quads if VBO is full
-				drawBatchedQuads();
+				batchQuads(cmd);
 			}
-
-			_batchedQuadCommands.push_back(cmd);
-
-			memcpy(_quads + _numQuads, cmd->getQuads(), sizeof(V3F_C4B_T2F_Quad) * cmd->getQuadCount());
-			convertToWorldCoordinates(_quads + _numQuads, cmd->getQuadCount(), cmd->getModelView());
-
-			_numQuads += cmd->getQuadCount();
-
 		}
 		else if (RenderCommand::Type::GROUP_COMMAND == commandType)
 		{
-			flush();
+			flush(RenderFrameStats::FlushCause::NON_QUAD_COMMAND);
 			int renderQueueID = ((GroupCommand*)command)->getRenderQueueID();
 			visitRenderQueue(_renderGroups[renderQueueID]);
 		}
 		else if (RenderCommand::Type::CUSTOM_COMMAND == commandType)
 		{
-			flush();
+			flush(RenderFrameStats::FlushCause::NON_QUAD_COMMAND);
 			auto cmd = static_cast<CustomCommand*>(command);
 			cmd->execute();
 		}
 		else if (RenderCommand::Type::BATCH_COMMAND == commandType)
 		{
-			flush();
+			flush(RenderFrameStats::FlushCause::NON_QUAD_COMMAND);
 			auto cmd = static_cast<BatchCommand*>(command);
 			cmd->execute();
 		}
 		else if (RenderCommand::Type::PRIMITIVE_COMMAND == commandType)
 		{
-			flush();
+			flush(RenderFrameStats::FlushCause::NON_QUAD_COMMAND);
 			auto cmd = static_cast<PrimitiveCommand*>(command);
 			cmd->execute();
 		}
 		else if (RenderCommand::Type::MESH_COMMAND == commandType)
 		{
-			flush2D();
+			flush2D(RenderFrameStats::FlushCause::NON_QUAD_COMMAND);
 			auto cmd = static_cast<MeshCommand*>(command);
 			if (_lastBatchedMeshCommand == nullptr || _lastBatchedMeshCommand->getMaterialID() != cmd->getMaterialID())
 			{
@@ -328,14 +567,32 @@ void Renderer::render()
 		// cleanup
 		_drawnBatches = _drawnVertices = 0;
 
+		RenderFrameStats& stats = _stats.getCurrentFrame();
+		auto start = RenderStats::Clock::now();
+
 		//Process render commands
 		//1. Sort render commands based on ID
 		for (auto &renderqueue : _renderGroups)
 		{
-			renderqueue.sort();
+			renderqueue.sort(_materialSortEnabled);
 		}
+		stats.sortTime += RenderStats::millisecondsSince(start);
+
+		start = RenderStats::Clock::now();
 		visitRenderQueue(_renderGroups[0]);
-		flush();
+		flush(RenderFrameStats::FlushCause::END_OF_QUEUE);
+		stats.renderTime += RenderStats::millisecondsSince(start);
+
+		// render() runs once per camera, the frame gets the sum
+		stats.drawnBatches += _drawnBatches;
+		stats.drawnVertices += _drawnVertices;
+
+		// the quads of this frame can't be overwritten until the GPU is done with them
+		_vertexBuffer->fenceStream();
+		if (_instanceBuffer)
+		{
+			_instanceBuffer->fenceStream();
+		}
 	}
 	clean();
 	_isRendering = false;
@@ -355,60 +612,99 @@ void Renderer::clean()
 	}
 
 	// Clear batch quad commands
-	_batchedQuadCommands.clear();
+	_batchedQuads.clear();
 	_numQuads = 0;
+	_batchedInstances.clear();
+	_numInstances = 0;
 
 	_lastMaterialID = 0;
 	_lastBatchedMeshCommand = nullptr;
 }
 
-void Renderer::convertToWorldCoordinates(V3F_C4B_T2F_Quad* quads, ssize_t quantity, const Mat4& modelView)
+void Renderer::convertToWorldCoordinates(const V3F_C4B_T2F_Quad* quads, V3F_C4B_T2F_Quad* dst, ssize_t quantity, const Mat4& modelView)
 {
-	//    kmMat4 matrixP, mvp;
-	//    kmGLGetMatrix(KM_GL_PROJECTION, &matrixP);
-	//    kmMat4Multiply(&mvp, &matrixP, &modelView);
-	for (ssize_t i = 0; i<quantity; ++i)
+	// the vertices of consecutive quads are contiguous, the whole run is transformed in one pass.
+	// dst is only written, once, it is mapped GPU memory: the colors and texture coordinates are copied along
+	MathUtil::transformVertices(modelView.m, quads, dst, quantity * 4, sizeof(V3F_C4B_T2F));
+}
+
+void Renderer::batchQuads(QuadCommand* cmd)
+{
+	ssize_t quadCount = cmd->getQuadCount();
+	ssize_t written = 0;
+
+	// keep the draw order with the instances batched before
+	if (_numInstances > 0)
+	{
+		drawBatchedInstances(RenderFrameStats::FlushCause::MATERIAL_CHANGE);
+		_lastMaterialID = 0;
+	}
+
+	while (written < quadCount)
 	{
-		V3F_C4B_T2F_Quad *q = &quads[i];
-		Vec3 *vec1 = (Vec3*)&q->bl.vertices;
-		modelView.transformPoint(vec1);
+		if (!_streamQuads)
+		{
+			int firstVertex, vertexCount;
+			_streamQuads = (V3F_C4B_T2F_Quad*)_vertexBuffer->mapStream(&firstVertex, &vertexCount);
+			_streamFirstQuad = firstVertex / 4;
+			_streamQuadCapacity = vertexCount / 4;
+		}
+
+		if (_numQuads == _streamQuadCapacity)
+		{
+			//End of the ring, draw the batched quads. The next ones go to the beginning of the buffer
+			drawBatchedQuads(RenderFrameStats::FlushCause::VBO_FULL);
+			continue;
+		}
+
+		int count = (int)std::min<ssize_t>(quadCount - written, _streamQuadCapacity - _numQuads);
+		const V3F_C4B_T2F_Quad* src = cmd->getQuads() + written;
+		V3F_C4B_T2F_Quad* dst = _streamQuads + _numQuads;
 
-		Vec3 *vec2 = (Vec3*)&q->br.vertices;
-		modelView.transformPoint(vec2);
+		convertToWorldCoordinates(src, dst, count, cmd->getModelView());
 
-		Vec3 *vec3 = (Vec3*)&q->tr.vertices;
-		modelView.transformPoint(vec3);
+		BatchedQuads batched = { cmd, count };
+		_batchedQuads.push_back(batched);
+		_stats.getCurrentFrame().quadsBatched += count;
 
-		Vec3 *vec4 = (Vec3*)&q->tl.vertices;
-		modelView.transformPoint(vec4);
+		_numQuads += count;
+		written += count;
 	}
 }
 
-void Renderer::drawBatchedQuads()
+void Renderer::drawBatchedQuads(RenderFrameStats::FlushCause cause)
 {
 	//TODO we can improve the draw performance by insert material switching command before hand.
 
 	int quadsToDraw = 0;
 	int startQuad = 0;
 
-	//Upload buffer to VBO
-	if (_numQuads <= 0 || _batchedQuadCommands.empty())
+	if (!_streamQuads)
+	{
+		return;
+	}
+
+	// The quads were written straight to the mapped buffer
+	_vertexBuffer->unmapStream(_numQuads * 4);
+	_streamQuads = nullptr;
+
+	if (_numQuads <= 0 || _batchedQuads.empty())
 	{
 		return;
 	}
 
-	// Update vertices
-	void* buf = _vertexBuffer->map();
-	memcpy(buf, _quads, sizeof(_quads[0]) * _numQuads);
-	_vertexBuffer->unmap();
+	// The indices of the ring are absolute
+	startQuad = _streamFirstQuad;
 
 	_vertexData->use();
 
 	GLView* glView = Director::getInstance()->getOpenGLView();
+	RenderFrameStats& stats = _stats.getCurrentFrame();
 
 	//Start drawing verties in batch
-	for (const auto& cmd : _batchedQuadCommands)
+	for (const auto& batched : _batchedQuads)
 	{
+		auto cmd = batched.command;
 		auto newMaterialID = cmd->getMaterialID();
 		if (_lastMaterialID != newMaterialID || newMaterialID == QuadCommand::MATERIAL_ID_DO_NOT_BATCH)
 		{
@@ -418,6 +714,7 @@ void Renderer::drawBatchedQuads()
 				glView->drawElements(GL_TRIANGLES, (GLsizei)quadsToDraw * 6, _indexBuffer, startQuad * 6);
 				_drawnBatches++;
 				_drawnVertices += quadsToDraw * 6;
+				stats.flushes[(int)RenderFrameStats::FlushCause::MATERIAL_CHANGE]++;
 
 				startQuad += quadsToDraw;
 				quadsToDraw = 0;
@@ -426,9 +723,10 @@ void Renderer::drawBatchedQuads()
 			//Use new material
 			cmd->useMaterial();
 			_lastMaterialID = newMaterialID;
+			stats.materialSwitches++;
 		}
 
-		quadsToDraw += cmd->getQuadCount();
+		quadsToDraw += batched.quadCount;
 	}
 
 	//Draw any remaining quad
@@ -437,23 +735,181 @@ void Renderer::drawBatchedQuads()
 		glView->drawElements(GL_TRIANGLES, (GLsizei)quadsToDraw * 6, _indexBuffer, startQuad * 6);
 		_drawnBatches++;
 		_drawnVertices += quadsToDraw * 6;
+		stats.flushes[(int)cause]++;
 	}
 
 	_vertexData->disable();
 
-	_batchedQuadCommands.clear();
+	_batchedQuads.clear();
 	_numQuads = 0;
 }
 
-void Renderer::flush()
+bool Renderer::isInstanceable(QuadCommand* cmd) const
+{
+	// commands with uniforms of their own are never batched, the others only need the builtins of the instanced shader
+	return cmd->getMaterialID() != QuadCommand::MATERIAL_ID_DO_NOT_BATCH
+		&& cmd->getGLProgramState()->getGLProgram() == _spriteProgram;
+}
+
+// A quad can be drawn as an instance when its corners are a parallelogram, in positions and in texture coordinates, with a single color
+static bool isParallelogram(const V3F_C4B_T2F_Quad& quad)
 {
-	flush2D();
+	return quad.tr.vertices - quad.br.vertices == quad.tl.vertices - quad.bl.vertices
+		&& quad.tr.texCoords.u - quad.br.texCoords.u == quad.tl.texCoords.u - quad.bl.texCoords.u
+		&& quad.tr.texCoords.v - quad.br.texCoords.v == quad.tl.texCoords.v - quad.bl.texCoords.v
+		&& quad.tl.colors == quad.bl.colors && quad.tr.colors == quad.bl.colors && quad.br.colors == quad.bl.colors;
+}
+
+bool Renderer::batchInstances(QuadCommand* cmd)
+{
+	const V3F_C4B_T2F_Quad* quads = cmd->getQuads();
+	ssize_t quadCount = cmd->getQuadCount();
+
+	// checked before anything is written, the command falls back to batchQuads() as a whole
+	for (ssize_t i = 0; i < quadCount; ++i)
+	{
+		if (!isParallelogram(quads[i]))
+			return false;
+	}
+
+	// keep the draw order with the quads batched before
+	if (_numQuads > 0)
+	{
+		drawBatchedQuads(RenderFrameStats::FlushCause::MATERIAL_CHANGE);
+		_lastMaterialID = 0;
+	}
+
+	const Mat4& mv = cmd->getModelView();
+	ssize_t written = 0;
+
+	while (written < quadCount)
+	{
+		if (!_streamInstances)
+		{
+			int firstInstance, instanceCount;
+			_streamInstances = (V3F_C4B_T2F_QuadInstance*)_instanceBuffer->mapStream(&firstInstance, &instanceCount);
+			_streamFirstInstance = firstInstance;
+			_streamInstanceCapacity = instanceCount;
+		}
+
+		if (_numInstances == _streamInstanceCapacity)
+		{
+			//End of the ring, draw the batched instances. The next ones go to the beginning of the buffer
+			drawBatchedInstances(RenderFrameStats::FlushCause::VBO_FULL);
+			continue;
+		}
+
+		int count = (int)std::min<ssize_t>(quadCount - written, _streamInstanceCapacity - _numInstances);
+		V3F_C4B_T2F_QuadInstance* dst = _streamInstances + _numInstances;
+
+		for (int i = 0; i < count; ++i)
+		{
+			const V3F_C4B_T2F_Quad& quad = quads[written + i];
+			V3F_C4B_T2F_QuadInstance instance;
+
+			mv.transformPoint(quad.bl.vertices, &instance.origin);
+			mv.transformVector(quad.br.vertices - quad.bl.vertices, &instance.xAxis);
+			mv.transformVector(quad.tl.vertices - quad.bl.vertices, &instance.yAxis);
+
+			instance.texOrigin = quad.bl.texCoords;
+			instance.texXAxis = Tex2F(quad.br.texCoords.u - quad.bl.texCoords.u, quad.br.texCoords.v - quad.bl.texCoords.v);
+			instance.texYAxis = Tex2F(quad.tl.texCoords.u - quad.bl.texCoords.u, quad.tl.texCoords.v - quad.bl.texCoords.v);
+			instance.color = quad.bl.colors;
+
+			// dst is mapped GPU memory, written once
+			dst[i] = instance;
+		}
+
+		BatchedQuads batched = { cmd, count };
+		_batchedInstances.push_back(batched);
+		_stats.getCurrentFrame().quadsBatched += count;
+		_stats.getCurrentFrame().quadsInstanced += count;
+
+		_numInstances += count;
+		written += count;
+	}
+
+	return true;
+}
+
+void Renderer::drawBatchedInstances(RenderFrameStats::FlushCause cause)
+{
+	if (!_streamInstances)
+	{
+		return;
+	}
+
+	_instanceBuffer->unmapStream(_numInstances);
+	_streamInstances = nullptr;
+
+	if (_numInstances <= 0 || _batchedInstances.empty())
+	{
+		return;
+	}
+
+	int instancesToDraw = 0;
+	int startInstance = _streamFirstInstance;
+
+	GLView* glView = Director::getInstance()->getOpenGLView();
+	RenderFrameStats& stats = _stats.getCurrentFrame();
+
+	for (const auto& batched : _batchedInstances)
+	{
+		auto cmd = batched.command;
+		auto newMaterialID = cmd->getMaterialID();
+		if (_lastMaterialID != newMaterialID)
+		{
+			if (instancesToDraw > 0)
+			{
+				drawInstances(startInstance, instancesToDraw);
+				startInstance += instancesToDraw;
+				instancesToDraw = 0;
+				stats.flushes[(int)RenderFrameStats::FlushCause::MATERIAL_CHANGE]++;
+			}
+
+			//Use the material of the command, with the instanced shader
+			cmd->getTexture()->bind();
+			glView->setBlendFunc(cmd->getBlendType());
+			_instancedProgram->use();
+			_instancedProgram->setUniformsForBuiltins(cmd->getModelView());
+			_lastMaterialID = newMaterialID;
+			stats.materialSwitches++;
+		}
+
+		instancesToDraw += batched.quadCount;
+	}
+
+	if (instancesToDraw > 0)
+	{
+		drawInstances(startInstance, instancesToDraw);
+		stats.flushes[(int)cause]++;
+	}
+
+	_batchedInstances.clear();
+	_numInstances = 0;
+}
+
+void Renderer::drawInstances(int firstInstance, int count)
+{
+	// no base instance in GL ES 2.0, the instance attributes are pointed to the first one instead
+	_instanceData->use(firstInstance);
+	Director::getInstance()->getOpenGLView()->drawElementsInstanced(GL_TRIANGLES, 6, _indexBuffer, 0, count);
+	_instanceData->disable();
+
+	_drawnBatches++;
+	_drawnVertices += count * 6;
+}
+
+void Renderer::flush(RenderFrameStats::FlushCause cause)
+{
+	flush2D(cause);
 	flush3D();
 }
 
-void Renderer::flush2D()
+void Renderer::flush2D(RenderFrameStats::FlushCause cause)
 {
-	drawBatchedQuads();
+	drawBatchedQuads(cause);
+	drawBatchedInstances(cause);
 	_lastMaterialID = 0;
 }
 
@@ -470,6 +926,11 @@ void Renderer::flush3D()
 
 bool Renderer::checkVisibility(const Mat4 &transform, const Size &size)
 {
+	if (!_cullingEnabled)
+	{
+		return true;
+	}
+
 	// half size of the screen
 	Size screen_half = Director::getInstance()->getWinSize();
 	screen_half.width /= 2;
@@ -28,10 +28,14 @@ THE SOFTWARE.
 
 #include <vector>
 #include <stack>
+#include <thread>
+#include <functional>
 
 #include "base/CCPlatformMacros.h"
 #include "renderer/CCRenderCommand.h"
 #include "renderer/CCGLProgram.h"
+#include "renderer/CCRenderCommandBuffer.h"
+#include "renderer/CCRenderStats.h"
 #include "CCGL.h"
 
 NS_CC_BEGIN
@@ -52,16 +56,38 @@ are the ones that have `z < 0` and `z > 0`.
 class RenderQueue {
 
 public:
+	RenderQueue();
+
 	void push_back(RenderCommand* command);
 	ssize_t size() const;
-	void sort();
+	/** Sorts the commands by global order, keeping the submission order of commands with the same global order.
+	When `byMaterial` is true, the QuadCommands of the same global order are also grouped by material, but never
+	moved across the other commands of the queue.
+	*/
+	void sort(bool byMaterial = false);
 	RenderCommand* operator[](ssize_t index) const;
 	void clear();
 
 protected:
-	std::vector<RenderCommand*> _queueNegZ;
-	std::vector<RenderCommand*> _queue0;
-	std::vector<RenderCommand*> _queuePosZ;
+	/* The key of an element holds the global order of its command in the 32 high bits, then the number of
+	non quad commands pushed before it in 16 bits, then the 16 high bits of the material part of its sort key.
+	Non quad commands can't be reordered, the quads between two of them share the same number and
+	can be grouped by material.
+	*/
+	struct Element
+	{
+		uint64_t key;
+		RenderCommand* command;
+	};
+
+	void radixSort(std::vector<Element>& elements, int firstByte);
+
+	std::vector<Element> _queueNegZ;
+	std::vector<Element> _queue0;
+	std::vector<Element> _queuePosZ;
+
+	std::vector<Element> _sortBuffer;
+	uint32_t _barriers;
 };
 
 struct RenderStackElement
@@ -79,7 +105,12 @@ Whenever possible prefer to use `QuadCommand` objects since the renderer will au
 class CC_DLL Renderer
 {
 public:
-	static const int VBO_SIZE = 65536 / 6;
+	/** Number of quads in the ring of the streaming vertex buffer, as many as 16 bits indices can address.
+	Bigger batches and QuadCommands are split, there is no limit to the number of quads of a command.
+	*/
+	static const int STREAM_QUADS = 65536 / 4;
+	/** Number of instances in the ring of the streaming instance buffer, see setInstancingEnabled() */
+	static const int STREAM_INSTANCES = 16384;
 	static const int BATCH_QUADCOMMAND_RESEVER_SIZE = 64;
 
 	Renderer();
@@ -103,12 +134,54 @@ public:
 	/** Creates a render queue and returns its Id */
 	int createRenderQueue();
 
+	/** Starts recording the addCommand(), pushGroup() and popGroup() calls made by the given threads.
+	Every thread records into the buffer assigned to its slot with setRecordingBuffer(), the render queues are not touched.
+	Only the listed threads may call the Renderer until endRecording().
+	*/
+	void beginRecording(const std::vector<std::thread::id>& threads);
+
+	/** Sets the buffer the thread of a slot records into. Must be called from the thread of that slot */
+	void setRecordingBuffer(ssize_t slot, RenderCommandBuffer* buffer) { _recordingSlots[slot].buffer = buffer; }
+
+	/** Stops recording, the calls go to the render queues again */
+	void endRecording();
+
+	/** returns whether the calls are recorded into command buffers */
+	bool isRecording() const { return _isRecording; }
+
+	/** Runs `func` on the main thread once the recorded buffers are replayed, or right away if not recording.
+	Used to delay the visit of nodes that are not safe to visit from a worker thread.
+	*/
+	void defer(const std::function<void()>& func);
+
+	/** Replays the calls recorded into a buffer, in order */
+	void replay(const RenderCommandBuffer& buffer);
+
+	/** When enabled, the QuadCommands that share a global order are reordered by material before rendering,
+	so that sprites from different textures interleaved in the scene graph end up in fewer batches.
+	Only use it when the draw order of the sprites of a same global order doesn't matter, overlapping
+	sprites may be drawn in a different order. Disabled by default.
+	*/
+	void setMaterialSortEnabled(bool enabled) { _materialSortEnabled = enabled; }
+	bool isMaterialSortEnabled() const { return _materialSortEnabled; }
+
+	/** When enabled, the QuadCommands using the default sprite shader are drawn with instancing where the GPU supports it:
+	every quad is sent as one V3F_C4B_T2F_QuadInstance (position, texture coordinates and color of a parallelogram)
+	instead of four vertices. Commands with quads that are not parallelograms with a single color, or with other shaders,
+	keep using the regular path. Disabled by default.
+	*/
+	void setInstancingEnabled(bool enabled) { _instancingEnabled = enabled; }
+	bool isInstancingEnabled() const { return _instancingEnabled; }
+
 	/** Renders into the GLView all the queued `RenderCommand` objects */
 	void render();
 
 	/** Cleans all `RenderCommand`s in the queue */
 	void clean();
 
+	/** Statistics of the current and of the last frames */
+	RenderStats& getStats() { return _stats; }
+
 	/* returns the number of drawn batches in the last frame */
 	ssize_t getDrawnBatches() const { return _drawnBatches; }
 	/* RenderCommands (except) QuadCommand should update this value */
@@ -123,6 +196,13 @@ public:
 	/** returns whether or not a rectangle is visible or not */
 	bool checkVisibility(const Mat4& transform, const Size& size);
 
+	/** When disabled, checkVisibility() reports every rectangle as visible.
+	StaticBatchNode disables it while it records its children, whose transforms are not relative to the screen then.
+	Enabled by default.
+	*/
+	void setCullingEnabled(bool enabled) { _cullingEnabled = enabled; }
+	bool isCullingEnabled() const { return _cullingEnabled; }
+
 protected:
 	// Release gl objects contained
 	void releaseGLObjects();
@@ -132,18 +212,31 @@ protected:
 	void setupVBOAndVAO();
 	void mapBuffers();
 
-	void drawBatchedQuads();
+	void drawBatchedQuads(RenderFrameStats::FlushCause cause);
+
+	//Writes the quads of a command into the streaming buffer
+	void batchQuads(QuadCommand* cmd);
+
+	//Creates the buffers of the instanced path on first use
+	void setupInstancing();
+	bool isInstanceable(QuadCommand* cmd) const;
+	//Writes the quads of a command as instances, returns false and writes nothing if a quad can't be instanced
+	bool batchInstances(QuadCommand* cmd);
+	void drawBatchedInstances(RenderFrameStats::FlushCause cause);
+	void drawInstances(int firstInstance, int count);
 
 	//Draw the previews queued quads and flush previous context
-	void flush();
+	void flush(RenderFrameStats::FlushCause cause);
 
-	void flush2D();
+	void flush2D(RenderFrameStats::FlushCause cause);
 
 	void flush3D();
 
 	void visitRenderQueue(const RenderQueue& queue);
 
-	void convertToWorldCoordinates(V3F_C4B_T2F_Quad* quads, ssize_t quantity, const Mat4& modelView);
+	void convertToWorldCoordinates(const V3F_C4B_T2F_Quad* quads, V3F_C4B_T2F_Quad* dst, ssize_t quantity, const Mat4& modelView);
+
+	RenderCommandBuffer* getRecordingBuffer() const;
 
 	VertexBuffer* _vertexBuffer;
 	IndexBuffer* _indexBuffer;
@@ -156,13 +249,38 @@ protected:
 	uint32_t _lastMaterialID;
 
 	MeshCommand*              _lastBatchedMeshCommand;
-	std::vector<QuadCommand*> _batchedQuadCommands;
 
-	V3F_C4B_T2F_Quad _quads[VBO_SIZE];
-	GLushort _indices[6 * VBO_SIZE];
+	// a QuadCommand is split in several entries when it doesn't fit in the end of the ring
+	struct BatchedQuads
+	{
+		QuadCommand* command;
+		int quadCount;
+	};
+	std::vector<BatchedQuads> _batchedQuads;
 
+	std::vector<GLushort> _indices;
+
+	// mapped range of the streaming buffer, nullptr when not mapped
+	V3F_C4B_T2F_Quad* _streamQuads;
+	int _streamFirstQuad;
+	int _streamQuadCapacity;
+
+	// quads written in the mapped range
 	int _numQuads;
 
+	// instanced path, same ring as the quads
+	bool _instancingEnabled;
+	VertexBuffer* _instanceBuffer;
+	VertexBuffer* _cornerBuffer;
+	VertexData* _instanceData;
+	GLProgram* _spriteProgram;
+	GLProgram* _instancedProgram;
+	std::vector<BatchedQuads> _batchedInstances;
+	V3F_C4B_T2F_QuadInstance* _streamInstances;
+	int _streamFirstInstance;
+	int _streamInstanceCapacity;
+	int _numInstances;
+
 	bool _glViewAssigned;
 
 	// stats
@@ -171,6 +289,19 @@ protected:
 	//the flag for checking whether renderer is rendering
 	bool _isRendering;
 
+	struct RecordingSlot
+	{
+		std::thread::id thread;
+		RenderCommandBuffer* buffer;
+	};
+	std::vector<RecordingSlot> _recordingSlots;
+	bool _isRecording;
+
+	bool _materialSortEnabled;
+	bool _cullingEnabled;
+
+	RenderStats _stats;
+
 	GroupCommandManager* _groupCommandManager;
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
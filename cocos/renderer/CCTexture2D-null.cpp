@@ -0,0 +1,125 @@
+/****************************************************************************
+Copyright (c) 2008      Apple Inc. All Rights Reserved.
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+Copyright (c) 2014 Fourth Sky Interactive
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/CCTexture2D.h"
+#include "base/ccConfig.h"
+
+#if CC_USE_NULL_RENDERER
+
+#include "platform/CCImage.h"
+#include "base/ccUtils.h"
+#include "base/ccMacros.h"
+#include "base/CCConfiguration.h"
+#include "renderer/CCGLCommandLog.h"
+
+NS_CC_BEGIN
+
+void Texture2D::releaseGLTexture()
+{
+	_name = 0;
+}
+
+bool Texture2D::_initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, Texture2D::PixelFormat pixelFormat, int pixelsWide, int pixelsHigh)
+{
+	const PixelFormatInfo& info = _pixelFormatInfoTables.at(pixelFormat);
+
+	if (info.compressed && !Configuration::getInstance()->supportsPVRTC()
+		&& !Configuration::getInstance()->supportsETC()
+		&& !Configuration::getInstance()->supportsS3TC()
+		&& !Configuration::getInstance()->supportsATITC())
+	{
+		CCLOG("cocos2d: WARNING: PVRTC/ETC images are not supported");
+		return false;
+	}
+
+	auto log = GLCommandLog::getInstance();
+	_name = log->genName();
+	log->record(GLCommandLog::Type::TEXTURE_CREATE, _name, (GLenum)info.internalFormat, mipmapsNum, 0);
+
+	int width = pixelsWide;
+	int height = pixelsHigh;
+
+	for (int i = 0; i < mipmapsNum; ++i)
+	{
+		log->record(GLCommandLog::Type::TEXTURE_UPLOAD, _name, (GLenum)info.internalFormat, width * height, mipmaps[i].len);
+
+		width = MAX(width >> 1, 1);
+		height = MAX(height >> 1, 1);
+	}
+
+	return true;
+}
+
+bool Texture2D::updateWithData(const void *data, int offsetX, int offsetY, int width, int height)
+{
+	if (_name)
+	{
+		bind();
+		const PixelFormatInfo& info = _pixelFormatInfoTables.at(_pixelFormat);
+		GLCommandLog::getInstance()->record(GLCommandLog::Type::TEXTURE_UPLOAD, _name, (GLenum)info.internalFormat, width * height, width * height * info.bpp / 8);
+
+		return true;
+	}
+	return false;
+}
+
+void Texture2D::generateMipmap()
+{
+	CCASSERT(_pixelsWide == ccNextPOT(_pixelsWide) && _pixelsHigh == ccNextPOT(_pixelsHigh), "Mipmap texture only works in POT textures");
+	_hasMipmaps = true;
+}
+
+void Texture2D::bind(GLint slot)
+{
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BIND_TEXTURE, _name, GL_TEXTURE0 + slot);
+}
+
+void Texture2D::unbind(GLint slot)
+{
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BIND_TEXTURE, 0, GL_TEXTURE0 + slot);
+}
+
+void Texture2D::setTexParameters(const TexParams &texParams)
+{
+	CCASSERT((_pixelsWide == ccNextPOT(_pixelsWide) || texParams.wrapS == GL_CLAMP_TO_EDGE) &&
+		(_pixelsHigh == ccNextPOT(_pixelsHigh) || texParams.wrapT == GL_CLAMP_TO_EDGE),
+		"GL_CLAMP_TO_EDGE should be used in NPOT dimensions");
+}
+
+void Texture2D::setAliasTexParameters()
+{
+	_antialiasEnabled = false;
+}
+
+void Texture2D::setAntiAliasTexParameters()
+{
+	_antialiasEnabled = true;
+}
+
+NS_CC_END
+
+#endif // CC_USE_NULL_RENDERER
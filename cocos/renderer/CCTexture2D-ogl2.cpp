@@ -26,6 +26,9 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "renderer/CCTexture2D.h"
+#include "base/ccConfig.h"
+
+#if !CC_USE_NULL_RENDERER
 
 #include "CCGL.h"
 #include "platform/CCImage.h"
@@ -285,4 +288,6 @@ void Texture2D::setAntiAliasTexParameters()
 #endif
 }
 
-NS_CC_END
\ No newline at end of file
+NS_CC_END
+
+#endif // !CC_USE_NULL_RENDERER
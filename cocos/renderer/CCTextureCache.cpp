@@ -59,11 +59,6 @@ TextureCache * TextureCache::getInstance()
 }
 
 TextureCache::TextureCache()
-: _loadingThread(nullptr)
-, _asyncStructQueue(nullptr)
-, _imageInfoQueue(nullptr)
-, _needQuit(false)
-, _asyncRefCount(0)
 {
 }
 
@@ -74,7 +69,7 @@ TextureCache::~TextureCache()
     for( auto it=_textures.begin(); it!=_textures.end(); ++it)
         (it->second)->release();
 
-    CC_SAFE_DELETE(_loadingThread);
+    waitForQuit();
 }
 
 void TextureCache::destroyInstance()
@@ -111,205 +106,118 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
         return;
     }
 
-    // lazy init
-    if (_asyncStructQueue == nullptr)
-    {             
-        _asyncStructQueue = new queue<AsyncStruct*>();
-        _imageInfoQueue   = new deque<ImageInfo*>();        
-
-        // create a new thread to load images
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
-
-        _needQuit = false;
-    }
-
-    if (0 == _asyncRefCount)
+    if (_asyncStructQueue.empty())
     {
         Director::getInstance()->getScheduler()->schedule(schedule_selector(TextureCache::addImageAsyncCallBack), this, 0, false);
     }
 
-    ++_asyncRefCount;
-
     // generate async struct
     AsyncStruct *data = new AsyncStruct(fullpath, callback);
 
-    // add async struct into queue
-    _asyncStructQueueMutex.lock();
-    _asyncStructQueue->push(data);
-    _asyncStructQueueMutex.unlock();
+    // a file already being loaded is loaded once, the texture is created by the first request
+    auto found = std::find_if(_asyncStructQueue.begin(), _asyncStructQueue.end(), [&fullpath](AsyncStruct* ptr)->bool{ return ptr->filename == fullpath; });
+    if (found != _asyncStructQueue.end())
+    {
+        data->loaded = true;
+    }
+    else
+    {
+        data->job = Director::getInstance()->getJobSystem()->schedule(std::bind(&TextureCache::loadImage, data));
+    }
 
-    _sleepCondition.notify_one();
+    _asyncStructQueue.push_back(data);
 }
 
 void TextureCache::unbindImageAsync(const std::string& filename)
 {
-    _imageInfoMutex.lock();
-    if (_imageInfoQueue && !_imageInfoQueue->empty())
+    if (!_asyncStructQueue.empty())
     {
         std::string fullpath = FileUtils::getInstance()->fullPathForFilename(filename);
-        auto found = std::find_if(_imageInfoQueue->begin(), _imageInfoQueue->end(), [&fullpath](ImageInfo* ptr)->bool{ return ptr->asyncStruct->filename == fullpath; });
-        if (found != _imageInfoQueue->end())
+        for (auto asyncStruct : _asyncStructQueue)
         {
-            (*found)->asyncStruct->callback = nullptr;
+            if (asyncStruct->filename == fullpath)
+            {
+                asyncStruct->callback = nullptr;
+            }
         }
     }
-    _imageInfoMutex.unlock();
 }
 
 void TextureCache::unbindAllImageAsync()
 {
-    _imageInfoMutex.lock();
-    if (_imageInfoQueue && !_imageInfoQueue->empty())
-    {
-        std::for_each(_imageInfoQueue->begin(), _imageInfoQueue->end(), [](ImageInfo* ptr) { ptr->asyncStruct->callback = nullptr; });
-    }
-    _imageInfoMutex.unlock();
+    std::for_each(_asyncStructQueue.begin(), _asyncStructQueue.end(), [](AsyncStruct* ptr) { ptr->callback = nullptr; });
 }
 
-void TextureCache::loadImage()
+void TextureCache::loadImage(AsyncStruct* asyncStruct)
 {
-    AsyncStruct *asyncStruct = nullptr;
-
-    while (true)
+    const std::string& filename = asyncStruct->filename;
+    // generate image
+    Image *image = new Image();
+    if (image && !image->initWithImageFileThreadSafe(filename))
     {
-        std::queue<AsyncStruct*> *pQueue = _asyncStructQueue;
-        _asyncStructQueueMutex.lock();
-        if (pQueue->empty())
-        {
-            _asyncStructQueueMutex.unlock();
-            if (_needQuit) {
-                break;
-            }
-            else {
-                std::unique_lock<std::mutex> lk(_sleepMutex);
-                _sleepCondition.wait(lk);
-                continue;
-            }
-        }
-        else
-        {
-            asyncStruct = pQueue->front();
-            pQueue->pop();
-            _asyncStructQueueMutex.unlock();
-        }        
-
-        Image *image = nullptr;
-        bool generateImage = false;
-
-        auto it = _textures.find(asyncStruct->filename);
-        if( it == _textures.end() )
-        {
-           _imageInfoMutex.lock();
-           ImageInfo *imageInfo;
-           size_t pos = 0;
-           size_t infoSize = _imageInfoQueue->size();
-           for (; pos < infoSize; pos++)
-           {
-               imageInfo = (*_imageInfoQueue)[pos];
-               if(imageInfo->asyncStruct->filename.compare(asyncStruct->filename) == 0)
-                   break;
-           }
-           _imageInfoMutex.unlock();
-           if(infoSize == 0 || pos == infoSize)
-               generateImage = true;
-        }
-
-        if (generateImage)
-        {
-            const std::string& filename = asyncStruct->filename;
-            // generate image      
-            image = new Image();
-            if (image && !image->initWithImageFileThreadSafe(filename))
-            {
-                CC_SAFE_RELEASE(image);
-                CCLOG("can not load %s", filename.c_str());
-                continue;
-            }
-        }    
-
-        // generate image info
-        ImageInfo *imageInfo = new ImageInfo();
-        imageInfo->asyncStruct = asyncStruct;
-        imageInfo->image = image;
-
-        // put the image info into the queue
-        _imageInfoMutex.lock();
-        _imageInfoQueue->push_back(imageInfo);
-        _imageInfoMutex.unlock();
-    }
-    
-	if(_asyncStructQueue != nullptr)
-    {
-        delete _asyncStructQueue;
-	    _asyncStructQueue = nullptr;
-        delete _imageInfoQueue;
-	    _imageInfoQueue = nullptr;
+        CC_SAFE_RELEASE(image);
+        CCLOG("can not load %s", filename.c_str());
     }
+    asyncStruct->image = image;
+
+    asyncStruct->loaded.store(true, std::memory_order_release);
 }
 
 void TextureCache::addImageAsyncCallBack(float dt)
 {
-    // the image is generated in loading thread
-    std::deque<ImageInfo*> *imagesQueue = _imageInfoQueue;
-
-    _imageInfoMutex.lock();
-    if (imagesQueue->empty())
+    // the callbacks are called in order: wait for the image of the oldest request
+    if (_asyncStructQueue.empty() || !_asyncStructQueue.front()->loaded.load(std::memory_order_acquire))
     {
-        _imageInfoMutex.unlock();
+        return;
     }
-    else
-    {
-        ImageInfo *imageInfo = imagesQueue->front();
-        imagesQueue->pop_front();
-        _imageInfoMutex.unlock();
 
-        AsyncStruct *asyncStruct = imageInfo->asyncStruct;
-        Image *image = imageInfo->image;
+    AsyncStruct *asyncStruct = _asyncStructQueue.front();
+    _asyncStructQueue.pop_front();
 
-        const std::string& filename = asyncStruct->filename;
+    Image *image = asyncStruct->image;
 
-        Texture2D *texture = nullptr;
-        if (image)
-        {
-            // generate texture in render thread
-            texture = new Texture2D();
+    const std::string& filename = asyncStruct->filename;
 
-            texture->initWithImage(image);
+    Texture2D *texture = nullptr;
+    if (image)
+    {
+        // generate texture in render thread
+        texture = new Texture2D();
+
+        texture->initWithImage(image);
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
-            // cache the texture file name
-            VolatileTextureMgr::addImageTexture(texture, filename);
+        // cache the texture file name
+        VolatileTextureMgr::addImageTexture(texture, filename);
 #endif
-            // cache the texture. retain it, since it is added in the map
-            _textures.insert( std::make_pair(filename, texture) );
-            texture->retain();
+        // cache the texture. retain it, since it is added in the map
+        _textures.insert( std::make_pair(filename, texture) );
+        texture->retain();
 
-            texture->autorelease();
-        }
-        else
-        {
-            auto it = _textures.find(asyncStruct->filename);
-            if(it != _textures.end())
-                texture = it->second;
-        }
-        
-        if (asyncStruct->callback)
-        {
-            asyncStruct->callback(texture);
-        }
-        
-        if(image)
-        {
-            image->release();
-        }       
-        delete asyncStruct;
-        delete imageInfo;
+        texture->autorelease();
+    }
+    else
+    {
+        auto it = _textures.find(asyncStruct->filename);
+        if(it != _textures.end())
+            texture = it->second;
+    }
 
-        --_asyncRefCount;
-        if (0 == _asyncRefCount)
-        {
-            Director::getInstance()->getScheduler()->unschedule(schedule_selector(TextureCache::addImageAsyncCallBack), this);
-        }
+    // failed loads get no callback, nor do the requests sharing the image of a failed one
+    if (asyncStruct->callback && texture)
+    {
+        asyncStruct->callback(texture);
+    }
+
+    if(image)
+    {
+        image->release();
+    }
+    delete asyncStruct;
+
+    if (_asyncStructQueue.empty())
+    {
+        Director::getInstance()->getScheduler()->unschedule(schedule_selector(TextureCache::addImageAsyncCallBack), this);
     }
 }
 
@@ -523,10 +431,19 @@ void TextureCache::reloadAllTextures()
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
-    _needQuit = true;
-    _sleepCondition.notify_one();
-    if (_loadingThread) _loadingThread->join();
+    // the pending requests are dropped once their image is loaded
+    for (auto asyncStruct : _asyncStructQueue)
+    {
+        Director::getInstance()->getJobSystem()->wait(asyncStruct->job);
+        CC_SAFE_RELEASE(asyncStruct->image);
+        delete asyncStruct;
+    }
+
+    if (!_asyncStructQueue.empty())
+    {
+        _asyncStructQueue.clear();
+        Director::getInstance()->getScheduler()->unschedule(schedule_selector(TextureCache::addImageAsyncCallBack), this);
+    }
 }
 
 std::string TextureCache::getCachedTextureInfo() const
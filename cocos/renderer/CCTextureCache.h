@@ -28,16 +28,14 @@ THE SOFTWARE.
 #ifndef __CCTEXTURE_CACHE_H__
 #define __CCTEXTURE_CACHE_H__
 
-#include <string>
-#include <mutex>
-#include <thread>
-#include <condition_variable>
-#include <queue>
+#include <atomic>
+#include <deque>
 #include <string>
 #include <unordered_map>
 #include <functional>
 
 #include "base/CCRef.h"
+#include "base/CCJobSystem.h"
 #include "renderer/CCTexture2D.h"
 #include "platform/CCImage.h"
 
@@ -112,8 +110,10 @@ public:
 
     /* Returns a Texture2D object given a file image
     * If the file image was not previously loaded, it will create a new Texture2D object and it will return it.
-    * Otherwise it will load a texture in a new thread, and when the image is loaded, the callback will be called with the Texture2D as a parameter.
+    * Otherwise it will load the image on the JobSystem of the Director, and when the image is loaded, the callback will be called with the Texture2D as a parameter.
     * The callback will be called from the main thread, so it is safe to create any cocos2d object from the callback.
+    * The callbacks are called in the order of the calls to addImageAsync(), one per frame.
+    * The callback is not called when the image can't be loaded.
     * Supported image extensions: .png, .jpg
     * @since v0.8
     */
@@ -191,39 +191,29 @@ public:
 
 private:
     void addImageAsyncCallBack(float dt);
-    void loadImage();
 
 public:
     struct AsyncStruct
     {
     public:
-        AsyncStruct(const std::string& fn, std::function<void(Texture2D*)> f) : filename(fn), callback(f) {}
+        AsyncStruct(const std::string& fn, std::function<void(Texture2D*)> f) : filename(fn), callback(f), image(nullptr), loaded(false) {}
 
         std::string filename;
         std::function<void(Texture2D*)> callback;
+
+        /** loads the image, null when an earlier request loads the same file */
+        JobHandle job;
+        /** set by the job, null when the file can't be loaded */
+        Image* image;
+        std::atomic<bool> loaded;
     };
 
 protected:
-    typedef struct _ImageInfo
-    {
-        AsyncStruct *asyncStruct;
-        Image        *image;
-    } ImageInfo;
-    
-    std::thread* _loadingThread;
-
-    std::queue<AsyncStruct*>* _asyncStructQueue;
-    std::deque<ImageInfo*>* _imageInfoQueue;
-
-    std::mutex _asyncStructQueueMutex;
-    std::mutex _imageInfoMutex;
-
-    std::mutex _sleepMutex;
-    std::condition_variable _sleepCondition;
-
-    bool _needQuit;
+    /** Runs on a worker of the JobSystem */
+    static void loadImage(AsyncStruct* asyncStruct);
 
-    int _asyncRefCount;
+    /** the pending requests, in order. Only used by the main thread */
+    std::deque<AsyncStruct*> _asyncStructQueue;
 
     std::unordered_map<std::string, Texture2D*> _textures;
 };
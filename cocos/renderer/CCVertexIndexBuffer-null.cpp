@@ -0,0 +1,202 @@
+/****************************************************************************
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+Copyright (c) 2014 Fourth Sky Interactive
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/CCVertexIndexBuffer.h"
+#include "base/ccConfig.h"
+
+#if CC_USE_NULL_RENDERER
+
+#include "renderer/CCGLCommandLog.h"
+#include "renderer/CCRenderStats.h"
+
+NS_CC_BEGIN
+
+// The null backend keeps the buffer contents in the shadow copy,
+// which is always allocated regardless of isShadowCopyEnabled()
+
+void* VertexBuffer::map()
+{
+	return _shadowCopy.data();
+}
+
+void VertexBuffer::unmap()
+{
+	// same as the GL backend: the whole buffer is orphaned and sent again
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BUFFER_UPLOAD, _vbo, GL_ARRAY_BUFFER, _vertexNumber, getSize());
+}
+
+void* VertexBuffer::mapStream(int* firstVertex, int* count)
+{
+	CCASSERT(_streaming, "Not a streaming buffer");
+	CCASSERT(_streamMappedCount == 0, "Buffer already mapped");
+
+	if (_streamHead == _vertexNumber)
+	{
+		_streamHead = 0;
+		++_streamLap;
+	}
+
+	*firstVertex = _streamHead;
+	*count = _streamMappedCount = _vertexNumber - _streamHead;
+	return &_shadowCopy[_streamHead * _sizePerVertex];
+}
+
+void VertexBuffer::unmapStream(int count)
+{
+	CCASSERT(_streamMappedCount > 0, "Buffer not mapped");
+
+	// only the written range is sent
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BUFFER_UPLOAD, _vbo, GL_ARRAY_BUFFER, count, count * _sizePerVertex);
+	RenderStats::addBytesUploaded(count * _sizePerVertex);
+
+	_streamHead += count;
+	_streamMappedCount = 0;
+}
+
+void VertexBuffer::fenceStream()
+{
+	// nothing runs asynchronously
+}
+
+void VertexBuffer::waitStream(int64_t position)
+{
+	_streamFreed = position;
+}
+
+void VertexBuffer::releaseGLBuffer()
+{
+	_vbo = 0;
+}
+
+bool VertexBuffer::init(int sizePerVertex, int vertexNumber, bool dynamic)
+{
+	if (0 == sizePerVertex || 0 == vertexNumber)
+		return false;
+	_sizePerVertex = sizePerVertex;
+	_vertexNumber = vertexNumber;
+	_dynamic = dynamic;
+	_access = _dynamic ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+
+	_shadowCopy.resize(sizePerVertex * _vertexNumber);
+
+	_vbo = GLCommandLog::getInstance()->genName();
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BUFFER_CREATE, _vbo, GL_ARRAY_BUFFER, _vertexNumber, 0);
+
+	return true;
+}
+
+bool VertexBuffer::updateVertices(const void* verts, int count, int begin)
+{
+	if (count <= 0 || nullptr == verts) return false;
+
+	if (begin < 0)
+	{
+		CCLOGERROR("Update vertices with begin = %d, will set begin to 0", begin);
+		begin = 0;
+	}
+
+	if (count + begin > _vertexNumber)
+	{
+		CCLOGERROR("updated vertices exceed the max size of vertex buffer, will set count to _vertexNumber-begin");
+		count = _vertexNumber - begin;
+	}
+
+	memcpy(&_shadowCopy[begin * _sizePerVertex], verts, count * _sizePerVertex);
+
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BUFFER_UPLOAD, _vbo, GL_ARRAY_BUFFER, count, count * _sizePerVertex);
+	RenderStats::addBytesUploaded(count * _sizePerVertex);
+
+	return true;
+}
+
+void VertexBuffer::recreateVBO() const
+{
+	// there is no context to lose
+}
+
+void* IndexBuffer::map()
+{
+	return _shadowCopy.data();
+}
+
+void IndexBuffer::unmap()
+{
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BUFFER_UPLOAD, _vbo, GL_ELEMENT_ARRAY_BUFFER, _indexNumber, getSize());
+}
+
+void IndexBuffer::releaseGLBuffer()
+{
+	_vbo = 0;
+}
+
+bool IndexBuffer::init(IndexBuffer::IndexType type, int number, bool dynamic)
+{
+	if (number <= 0) return false;
+
+	_type = type;
+	_indexNumber = number;
+	_dynamic = dynamic;
+	_access = _dynamic ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+
+	_shadowCopy.resize(getSize());
+
+	_vbo = GLCommandLog::getInstance()->genName();
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BUFFER_CREATE, _vbo, GL_ELEMENT_ARRAY_BUFFER, _indexNumber, 0);
+
+	return true;
+}
+
+bool IndexBuffer::updateIndices(const void* indices, int count, int begin)
+{
+	if (count <= 0 || nullptr == indices) return false;
+
+	if (begin < 0)
+	{
+		CCLOGERROR("Update indices with begin = %d, will set begin to 0", begin);
+		begin = 0;
+	}
+
+	if (count + begin > _indexNumber)
+	{
+		CCLOGERROR("updated indices exceed the max size of vertex buffer, will set count to _indexNumber-begin");
+		count = _indexNumber - begin;
+	}
+
+	memcpy(&_shadowCopy[begin * getSizePerIndex()], indices, count * getSizePerIndex());
+
+	GLCommandLog::getInstance()->record(GLCommandLog::Type::BUFFER_UPLOAD, _vbo, GL_ELEMENT_ARRAY_BUFFER, count, count * getSizePerIndex());
+	RenderStats::addBytesUploaded(count * getSizePerIndex());
+
+	return true;
+}
+
+void IndexBuffer::recreateVBO() const
+{
+	// there is no context to lose
+}
+
+NS_CC_END
+
+#endif // CC_USE_NULL_RENDERER
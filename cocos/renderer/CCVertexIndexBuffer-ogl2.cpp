@@ -24,8 +24,13 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "renderer/CCVertexIndexBuffer.h"
+#include "base/ccConfig.h"
+
+#if !CC_USE_NULL_RENDERER
 #include "base/CCEventType.h"
 #include "base/CCEventListenerCustom.h"
+#include "base/CCConfiguration.h"
+#include "renderer/CCRenderStats.h"
 
 NS_CC_BEGIN
 
@@ -42,8 +47,153 @@ void VertexBuffer::unmap()
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+// Fences older than the last ones are merged into them: waiting for a newer fence also waits for the older ones
+static const size_t MAX_STREAM_FENCES = 4;
+
+void* VertexBuffer::mapStream(int* firstVertex, int* count)
+{
+	CCASSERT(_streaming, "Not a streaming buffer");
+	CCASSERT(_streamMappedCount == 0, "Buffer already mapped");
+
+	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+
+	auto configuration = Configuration::getInstance();
+	if (_streamHead == _vertexNumber)
+	{
+		_streamHead = 0;
+		++_streamLap;
+
+		// without fences the storage is orphaned, the driver hands out a fresh one while the GPU reads the old one
+		if (!configuration->supportsSync())
+		{
+			glBufferData(GL_ARRAY_BUFFER, getSize(), nullptr, _access);
+			_streamFreed = (int64_t)_streamLap * _vertexNumber;
+		}
+	}
+
+	*firstVertex = _streamHead;
+	*count = _streamMappedCount = _vertexNumber - _streamHead;
+
+#ifdef GL_MAP_UNSYNCHRONIZED_BIT
+	if (configuration->supportsMapBufferRange())
+	{
+		// up to the end of the buffer, these vertices were written in the previous lap
+		waitStream((int64_t)_streamLap * _vertexNumber);
+
+		void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, _streamHead * _sizePerVertex, _streamMappedCount * _sizePerVertex,
+			GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+		// out of memory or lost context: the vertices go through the CPU copy this time
+		_streamMappedGPU = (mapped != nullptr);
+		if (mapped)
+		{
+			return mapped;
+		}
+		CCLOG("cocos2d: VertexBuffer: glMapBufferRange failed, 0x%04X", glGetError());
+	}
+#endif
+	_streamMappedGPU = false;
+
+	// written to the CPU copy, uploaded by unmapStream()
+	if (_shadowCopy.empty())
+	{
+		_shadowCopy.resize(getSize());
+	}
+	return &_shadowCopy[_streamHead * _sizePerVertex];
+}
+
+void VertexBuffer::unmapStream(int count)
+{
+	CCASSERT(_streamMappedCount > 0, "Buffer not mapped");
+	CCASSERT(count <= _streamMappedCount, "More vertices written than mapped");
+
+	// the caller may have bound other buffers since mapStream()
+	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+
+#ifdef GL_MAP_UNSYNCHRONIZED_BIT
+	if (_streamMappedGPU)
+	{
+		glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, count * _sizePerVertex);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+	else
+#endif
+	if (count > 0)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, _streamHead * _sizePerVertex, count * _sizePerVertex, &_shadowCopy[_streamHead * _sizePerVertex]);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	RenderStats::addBytesUploaded(count * _sizePerVertex);
+
+	_streamHead += count;
+	_streamMappedCount = 0;
+
+	CHECK_GL_ERROR_DEBUG();
+}
+
+void VertexBuffer::fenceStream()
+{
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+	if (!Configuration::getInstance()->supportsSync())
+		return;
+
+	int64_t position = (int64_t)_streamLap * _vertexNumber + _streamHead;
+	if (!_streamFences.empty() && _streamFences.back().position == position)
+		return;
+
+	if (_streamFences.size() == MAX_STREAM_FENCES)
+	{
+		glDeleteSync((GLsync)_streamFences.front().sync);
+		_streamFences.erase(_streamFences.begin());
+	}
+
+	StreamFence fence = { glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), position };
+	_streamFences.push_back(fence);
+#endif
+}
+
+void VertexBuffer::waitStream(int64_t position)
+{
+	if (_streamFreed >= position)
+		return;
+
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+	// the first fence set after these vertices were written
+	size_t i = 0;
+	while (i < _streamFences.size() && _streamFences[i].position < position)
+		++i;
+
+	if (i < _streamFences.size())
+	{
+		GLsync sync = (GLsync)_streamFences[i].sync;
+		while (glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED)
+			;
+		_streamFreed = _streamFences[i].position;
+		++i;
+	}
+	else
+	{
+		// written during this frame, not fenced yet: cheaper to orphan the storage than to stall
+		glBufferData(GL_ARRAY_BUFFER, getSize(), nullptr, _access);
+		_streamFreed = (int64_t)_streamLap * _vertexNumber + _streamHead;
+	}
+
+	for (size_t j = 0; j < i; ++j)
+		glDeleteSync((GLsync)_streamFences[j].sync);
+	_streamFences.erase(_streamFences.begin(), _streamFences.begin() + i);
+#else
+	glBufferData(GL_ARRAY_BUFFER, getSize(), nullptr, _access);
+	_streamFreed = (int64_t)_streamLap * _vertexNumber + _streamHead;
+#endif
+}
+
 void VertexBuffer::releaseGLBuffer()
 {
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+	for (auto& fence : _streamFences)
+		glDeleteSync((GLsync)fence.sync);
+#endif
+	_streamFences.clear();
+
 	if (glIsBuffer(_vbo))
 	{
 		glDeleteBuffers(1, &_vbo);
@@ -58,7 +208,7 @@ bool VertexBuffer::init(int sizePerVertex, int vertexNumber, bool dynamic)
 	_sizePerVertex = sizePerVertex;
 	_vertexNumber = vertexNumber;
 	_dynamic = dynamic;
-	_access = _dynamic ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+	_access = _streaming ? GL_STREAM_DRAW : (_dynamic ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
 
 	if (isShadowCopyEnabled())
 	{
@@ -99,6 +249,7 @@ bool VertexBuffer::updateVertices(const void* verts, int count, int begin)
 	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
 	glBufferSubData(GL_ARRAY_BUFFER, begin * _sizePerVertex, count * _sizePerVertex, verts);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	RenderStats::addBytesUploaded(count * _sizePerVertex);
 
 	CHECK_GL_ERROR_DEBUG();
 
@@ -108,6 +259,13 @@ bool VertexBuffer::updateVertices(const void* verts, int count, int begin)
 void VertexBuffer::recreateVBO() const
 {
 	CCLOG("come to foreground of VertexBuffer");
+	// the fences died with the context, the new storage is free
+	auto self = const_cast<VertexBuffer*>(this);
+	self->_streamFences.clear();
+	self->_streamHead = self->_streamMappedCount = 0;
+	self->_streamLap = 0;
+	self->_streamFreed = 0;
+
 	glGenBuffers(1, &_vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
 	const void* buffer = nullptr;
@@ -192,6 +350,7 @@ bool IndexBuffer::updateIndices(const void* indices, int count, int begin)
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo);
 	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, begin * getSizePerIndex(), count * getSizePerIndex(), indices);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	RenderStats::addBytesUploaded(count * getSizePerIndex());
 
 	CHECK_GL_ERROR_DEBUG();
 
@@ -226,4 +385,6 @@ void IndexBuffer::recreateVBO() const
 }
 
 
-NS_CC_END
\ No newline at end of file
+NS_CC_END
+
+#endif // !CC_USE_NULL_RENDERER
@@ -54,12 +54,34 @@ VertexBuffer* VertexBuffer::create(int sizePerVertex, int vertexNumber, bool dyn
     
 }
 
+VertexBuffer* VertexBuffer::createStreaming(int sizePerVertex, int vertexNumber)
+{
+    auto result = new (std::nothrow) VertexBuffer();
+    if (result)
+    {
+        result->_streaming = true;
+        if (result->init(sizePerVertex, vertexNumber, true))
+        {
+            result->autorelease();
+            return result;
+        }
+    }
+    CC_SAFE_DELETE(result);
+    return nullptr;
+}
+
 VertexBuffer::VertexBuffer()
 : _vertexNumber(0)
 , _sizePerVertex(0)
 , _recreateVBOEventListener(nullptr)
 , _dynamic(false)
 , _vbo(0)
+, _streaming(false)
+, _streamHead(0)
+, _streamMappedCount(0)
+, _streamMappedGPU(false)
+, _streamLap(0)
+, _streamFreed(0)
 {
     
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
@@ -38,6 +38,11 @@ class CC_DLL VertexBuffer : public Ref
 {
 public:
     static VertexBuffer* create(int sizePerVertex, int vertexNumber, bool dynamic = false);
+
+    /** Creates a buffer for vertices that change every frame. It is used as a ring: every batch of vertices
+     is written once, straight into a part of the buffer the GPU is not reading anymore. See mapStream().
+     */
+    static VertexBuffer* createStreaming(int sizePerVertex, int vertexNumber);
     
     int getSizePerVertex() const;
     int getVertexNumber() const;
@@ -45,6 +50,20 @@ public:
 	void* map();
 	void unmap();
 
+	/** Maps the vertices of a streaming buffer from the one following the last written vertex up to the end of the buffer,
+	starting again from the beginning when the buffer is full.
+	Where the platform supports it the range is mapped without synchronization, after waiting for the fence of the frame
+	that last drew it. Otherwise the vertices are written to a CPU copy and uploaded by unmapStream().
+	@param firstVertex set to the index of the first mapped vertex
+	@param count set to the number of mapped vertices
+	*/
+	void* mapStream(int* firstVertex, int* count);
+	/** Unmaps a streaming buffer. `count` vertices were written from the first mapped one */
+	void unmapStream(int count);
+	/** Fences the GPU so that the vertices written so far are not overwritten before they are drawn. Called once per frame */
+	void fenceStream();
+	bool isStreaming() const { return _streaming; }
+
     int getSize() const;
     
     GLuint getVBO() const;
@@ -69,6 +88,21 @@ protected:
     std::vector<unsigned char> _shadowCopy;
     static bool _enableShadowCopy;
 
+	//streaming, positions are counted in vertices since the buffer was created: lap * _vertexNumber + index
+	void waitStream(int64_t position);
+	bool _streaming;
+	int _streamHead;
+	int _streamMappedCount;
+	bool _streamMappedGPU; // whether the mapped range is GPU memory, or _shadowCopy
+	unsigned int _streamLap;
+	int64_t _streamFreed;
+	struct StreamFence
+	{
+		void* sync;
+		int64_t position;
+	};
+	std::vector<StreamFence> _streamFences;
+
 public:
     static bool isShadowCopyEnabled() { return _enableShadowCopy; }
     static void enableShadowCopy(bool enabled) { _enableShadowCopy = enabled; }
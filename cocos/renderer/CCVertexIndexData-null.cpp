@@ -0,0 +1,54 @@
+/****************************************************************************
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+Copyright (c) 2014 Fourth Sky Interactive
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/CCVertexIndexData.h"
+#include "base/ccConfig.h"
+
+#if CC_USE_NULL_RENDERER
+
+#include "renderer/ccGLStateCache.h"
+
+NS_CC_BEGIN
+
+void VertexData::use(int firstInstance)
+{
+	// The null backend never reports VAO support, only the attribute
+	// flags are tracked, through the (recording) GL state cache
+	uint32_t flags(0);
+	for (auto& element : _vertexStreams)
+	{
+		flags = flags | (1 << element.second._stream._semantic);
+	}
+
+	GL::enableVertexAttribs(flags);
+}
+
+void VertexData::disable()
+{
+}
+
+NS_CC_END
+
+#endif // CC_USE_NULL_RENDERER
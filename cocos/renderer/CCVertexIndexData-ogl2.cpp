@@ -23,12 +23,44 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "renderer/CCVertexIndexData.h"
+#include "base/ccConfig.h"
+
+#if !CC_USE_NULL_RENDERER
 #include "base/CCConfiguration.h"
 
 
 NS_CC_BEGIN
 
-void VertexData::use()
+// Points an attribute to its buffer, the per instance attributes start at firstInstance
+static void setAttribPointer(VertexBuffer* buffer, const VertexStreamAttribute& stream, int firstInstance)
+{
+	intptr_t offset = stream._offset;
+	if (stream._divisor != 0)
+	{
+		offset += (intptr_t)(firstInstance / stream._divisor) * buffer->getSizePerVertex();
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, buffer->getVBO());
+	glVertexAttribPointer(GLint(stream._semantic),
+							stream._size,
+							stream._type,
+							stream._normalize,
+							buffer->getSizePerVertex(),
+							(GLvoid*)offset);
+}
+
+// Divisors are not part of the attribute flags of the state cache, only the non zero ones are set and they are reset by disable()
+static void setAttribDivisor(const VertexStreamAttribute& stream, GLuint divisor)
+{
+#ifdef GL_VERTEX_ATTRIB_ARRAY_DIVISOR
+	if (stream._divisor != 0 && Configuration::getInstance()->supportsInstancing())
+	{
+		glVertexAttribDivisor(GLuint(stream._semantic), divisor);
+	}
+#endif
+}
+
+void VertexData::use(int firstInstance)
 {
 	if (Configuration::getInstance()->supportsShareableVAO())
 	{
@@ -40,14 +72,11 @@ void VertexData::use()
 			for (auto& element : _vertexStreams)
 			{
 				glEnableVertexAttribArray((GLint)element.second._stream._semantic);
-				glBindBuffer(GL_ARRAY_BUFFER, element.second._buffer->getVBO());
-				glVertexAttribPointer(GLint(element.second._stream._semantic),
-										element.second._stream._size,
-										element.second._stream._type,
-										element.second._stream._normalize,
-										element.second._buffer->getSizePerVertex(),
-										(GLvoid*)element.second._stream._offset);
+				setAttribPointer(element.second._buffer, element.second._stream, firstInstance);
+				// the divisors belong to the VAO
+				setAttribDivisor(element.second._stream, element.second._stream._divisor);
 			}
+			_VAOFirstInstance = firstInstance;
 
 			glBindVertexArray(0);
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -56,6 +85,19 @@ void VertexData::use()
 
 		GL::bindVAO(_VAO);
 
+		if (_VAOFirstInstance != firstInstance)
+		{
+			for (auto& element : _vertexStreams)
+			{
+				if (element.second._stream._divisor != 0)
+				{
+					setAttribPointer(element.second._buffer, element.second._stream, firstInstance);
+				}
+			}
+			_VAOFirstInstance = firstInstance;
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
 		CHECK_GL_ERROR_DEBUG();
 	}
 	else
@@ -70,13 +112,8 @@ void VertexData::use()
 
 		for (auto& element : _vertexStreams)
 		{
-			glBindBuffer(GL_ARRAY_BUFFER, element.second._buffer->getVBO());
-			glVertexAttribPointer(GLint(element.second._stream._semantic),
-									element.second._stream._size,
-									element.second._stream._type,
-									element.second._stream._normalize,
-									element.second._buffer->getSizePerVertex(),
-									(GLvoid*)element.second._stream._offset);
+			setAttribPointer(element.second._buffer, element.second._stream, firstInstance);
+			setAttribDivisor(element.second._stream, element.second._stream._divisor);
 		}
 
 		CHECK_GL_ERROR_DEBUG();
@@ -90,6 +127,16 @@ void VertexData::disable()
 	{
 		GL::bindVAO(0);
 	}
+	else
+	{
+		// the other users of these attributes expect per vertex data
+		for (auto& element : _vertexStreams)
+		{
+			setAttribDivisor(element.second._stream, 0);
+		}
+	}
 }
 
-NS_CC_END
\ No newline at end of file
+NS_CC_END
+
+#endif // !CC_USE_NULL_RENDERER
@@ -97,6 +97,8 @@ VertexBuffer* VertexData::getStreamBuffer(int semantic) const
 }
 
 VertexData::VertexData()
+: _VAO(0)
+, _VAOFirstInstance(0)
 {
     
 }
@@ -37,17 +37,17 @@ class VertexBuffer;
 struct CC_DLL VertexStreamAttribute
 {
     VertexStreamAttribute()
-    : _offset(0),_semantic(0),_type(0),_size(0), _normalize(false)
+    : _offset(0),_semantic(0),_type(0),_size(0), _normalize(false), _divisor(0)
     {
     }
 
     VertexStreamAttribute(int offset, int semantic, int type, int size)
-    : _offset(offset),_semantic(semantic),_type(type),_size(size), _normalize(false)
+    : _offset(offset),_semantic(semantic),_type(type),_size(size), _normalize(false), _divisor(0)
     {
     }
     
     VertexStreamAttribute(int offset, int semantic, int type, int size, bool normalize)
-    : _offset(offset),_semantic(semantic),_type(type),_size(size), _normalize(normalize)
+    : _offset(offset),_semantic(semantic),_type(type),_size(size), _normalize(normalize), _divisor(0)
     {
     }
     
@@ -56,6 +56,8 @@ struct CC_DLL VertexStreamAttribute
     int _semantic;
     int _type;
     int _size;
+    /** 0 for per vertex attributes, 1 for per instance attributes, the buffer then holds one element per instance */
+    int _divisor;
 };
 
 class CC_DLL VertexData : public Ref
@@ -71,7 +73,8 @@ public:
     
     VertexBuffer* getStreamBuffer(int semantic) const;
     
-    void use();
+    /** Sets up the vertex attributes. The per instance streams start at the instance `firstInstance` of their buffer */
+    void use(int firstInstance = 0);
 	void disable();
 protected:
     VertexData();
@@ -85,6 +88,8 @@ protected:
     
     std::map<int, BufferAttribute> _vertexStreams;
 	GLuint _VAO;
+	// instance the per instance streams of the VAO start at
+	int _VAOFirstInstance;
 };
 
 NS_CC_END
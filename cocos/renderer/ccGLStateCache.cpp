@@ -31,6 +31,11 @@ THE SOFTWARE.
 #include "base/CCDirector.h"
 #include "base/ccConfig.h"
 #include "base/CCConfiguration.h"
+#include "renderer/CCRenderStats.h"
+
+#if CC_USE_NULL_RENDERER
+#include "renderer/CCGLCommandLog.h"
+#endif
 
 NS_CC_BEGIN
 
@@ -53,6 +58,57 @@ namespace
     static GLenum    s_activeTexture = -1;
 
 #endif // CC_ENABLE_GL_STATE_CACHE
+
+    // The GL calls issued by the cache. The null renderer has no context
+    // and records the state changes that pass the cache instead
+#if CC_USE_NULL_RENDERER
+    static GLenum    s_nullActiveTexture = GL_TEXTURE0;
+
+    inline void applyProgram(GLuint program) { GLCommandLog::getInstance()->record(GLCommandLog::Type::USE_PROGRAM, program); }
+    inline void applyDeleteProgram(GLuint program) {}
+    inline void applyBlending(GLenum sfactor, GLenum dfactor) { GLCommandLog::getInstance()->record(GLCommandLog::Type::BLEND_FUNC, sfactor, dfactor); }
+    inline void applyBlendEquation() {}
+    inline void applyActiveTexture(GLenum texture) { s_nullActiveTexture = texture; }
+    inline void applyBindTexture(GLuint textureId) { GLCommandLog::getInstance()->record(GLCommandLog::Type::BIND_TEXTURE, textureId, s_nullActiveTexture); }
+    inline void applyDeleteTexture(GLuint textureId) {}
+    inline void applyVAO(GLuint vaoId) { GLCommandLog::getInstance()->record(GLCommandLog::Type::BIND_VAO, vaoId); }
+    inline void applyVertexAttribs(uint32_t flags, uint32_t previousFlags) { GLCommandLog::getInstance()->record(GLCommandLog::Type::VERTEX_ATTRIBS, flags); }
+#else
+    inline void applyProgram(GLuint program) { glUseProgram(program); }
+    inline void applyDeleteProgram(GLuint program) { glDeleteProgram(program); }
+    inline void applyBlending(GLenum sfactor, GLenum dfactor)
+    {
+        if (sfactor == GL_ONE && dfactor == GL_ZERO)
+        {
+            glDisable(GL_BLEND);
+        }
+        else
+        {
+            glEnable(GL_BLEND);
+            glBlendFunc(sfactor, dfactor);
+        }
+    }
+    inline void applyBlendEquation() { glBlendEquation(GL_FUNC_ADD); }
+    inline void applyActiveTexture(GLenum texture) { glActiveTexture(texture); }
+    inline void applyBindTexture(GLuint textureId) { glBindTexture(GL_TEXTURE_2D, textureId); }
+    inline void applyDeleteTexture(GLuint textureId) { glDeleteTextures(1, &textureId); }
+    inline void applyVAO(GLuint vaoId) { glBindVertexArray(vaoId); }
+    inline void applyVertexAttribs(uint32_t flags, uint32_t previousFlags)
+    {
+        // hardcoded!
+        for(int i=0; i < MAX_ATTRIBUTES; i++) {
+            unsigned int bit = 1 << i;
+            bool enabled = flags & bit;
+            bool enabledBefore = previousFlags & bit;
+            if(enabled != enabledBefore) {
+                if( enabled )
+                    glEnableVertexAttribArray(i);
+                else
+                    glDisableVertexAttribArray(i);
+            }
+        }
+    }
+#endif // CC_USE_NULL_RENDERER
 }
 
 // GL State Cache functions
@@ -89,7 +145,7 @@ void deleteProgram( GLuint program )
     }
 #endif // CC_ENABLE_GL_STATE_CACHE
 
-    glDeleteProgram( program );
+    applyDeleteProgram( program );
 }
 
 void useProgram( GLuint program )
@@ -97,26 +153,15 @@ void useProgram( GLuint program )
 #if CC_ENABLE_GL_STATE_CACHE
     if( program != s_currentShaderProgram ) {
         s_currentShaderProgram = program;
-        glUseProgram(program);
+        applyProgram(program);
+        RenderStats::addProgramSwitch();
     }
 #else
-    glUseProgram(program);
+    applyProgram(program);
+    RenderStats::addProgramSwitch();
 #endif // CC_ENABLE_GL_STATE_CACHE
 }
 
-static void SetBlending(GLenum sfactor, GLenum dfactor)
-{
-	if (sfactor == GL_ONE && dfactor == GL_ZERO)
-    {
-		glDisable(GL_BLEND);
-	}
-    else
-    {
-		glEnable(GL_BLEND);
-		glBlendFunc(sfactor, dfactor);
-	}
-}
-
 void blendFunc(GLenum sfactor, GLenum dfactor)
 {
 #if CC_ENABLE_GL_STATE_CACHE
@@ -124,20 +169,20 @@ void blendFunc(GLenum sfactor, GLenum dfactor)
     {
         s_blendingSource = sfactor;
         s_blendingDest = dfactor;
-        SetBlending(sfactor, dfactor);
+        applyBlending(sfactor, dfactor);
     }
 #else
-    SetBlending( sfactor, dfactor );
+    applyBlending( sfactor, dfactor );
 #endif // CC_ENABLE_GL_STATE_CACHE
 }
 
 void blendResetToCache(void)
 {
-	glBlendEquation(GL_FUNC_ADD);
+	applyBlendEquation();
 #if CC_ENABLE_GL_STATE_CACHE
-	SetBlending(s_blendingSource, s_blendingDest);
+	applyBlending(s_blendingSource, s_blendingDest);
 #else
-	SetBlending(CC_BLEND_SRC, CC_BLEND_DST);
+	applyBlending(CC_BLEND_SRC, CC_BLEND_DST);
 #endif // CC_ENABLE_GL_STATE_CACHE
 }
 
@@ -154,11 +199,13 @@ void bindTexture2DN(GLuint textureUnit, GLuint textureId)
     {
         s_currentBoundTexture[textureUnit] = textureId;
         activeTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, textureId);
+        applyBindTexture(textureId);
+        RenderStats::addTextureBind();
     }
 #else
-    glActiveTexture(GL_TEXTURE0 + textureUnit);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+    applyActiveTexture(GL_TEXTURE0 + textureUnit);
+    applyBindTexture(textureId);
+    RenderStats::addTextureBind();
 #endif
 }
 
@@ -175,7 +222,7 @@ void deleteTexture(GLuint textureId)
     }
 #endif // CC_ENABLE_GL_STATE_CACHE
     
-	glDeleteTextures(1, &textureId);
+	applyDeleteTexture(textureId);
 }
 
 void deleteTextureN(GLuint textureUnit, GLuint textureId)
@@ -188,10 +235,10 @@ void activeTexture(GLenum texture)
 #if CC_ENABLE_GL_STATE_CACHE
     if(s_activeTexture != texture) {
         s_activeTexture = texture;
-        glActiveTexture(s_activeTexture);
+        applyActiveTexture(s_activeTexture);
     }
 #else
-    glActiveTexture(texture);
+    applyActiveTexture(texture);
 #endif
 }
 
@@ -204,10 +251,10 @@ void bindVAO(GLuint vaoId)
         if (s_VAO != vaoId)
         {
             s_VAO = vaoId;
-            glBindVertexArray(vaoId);
+            applyVAO(vaoId);
         }
 #else
-        glBindVertexArray(vaoId);
+        applyVAO(vaoId);
 #endif // CC_ENABLE_GL_STATE_CACHE
     
     }
@@ -219,17 +266,9 @@ void enableVertexAttribs(uint32_t flags)
 {
     bindVAO(0);
 
-    // hardcoded!
-    for(int i=0; i < MAX_ATTRIBUTES; i++) {
-        unsigned int bit = 1 << i;
-        bool enabled = flags & bit;
-        bool enabledBefore = s_attributeFlags & bit;
-        if(enabled != enabledBefore) {
-            if( enabled )
-                glEnableVertexAttribArray(i);
-            else
-                glDisableVertexAttribArray(i);
-        }
+    if (flags != s_attributeFlags)
+    {
+        applyVertexAttribs(flags, s_attributeFlags);
     }
     s_attributeFlags = flags;
 }
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2014 Fourth Sky Interactive
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Expands the unit quad into an instance of V3F_C4B_T2F_QuadInstance.
+// Same outputs as ccPositionTextureColor_noMVP_vert, the instance is already in world coordinates
+const char* ccPositionTextureColor_instanced_vert = STRINGIFY(
+attribute vec2 a_corner;
+attribute vec3 a_origin;
+attribute vec3 a_xAxis;
+attribute vec3 a_yAxis;
+attribute vec2 a_texOrigin;
+attribute vec2 a_texXAxis;
+attribute vec2 a_texYAxis;
+attribute vec4 a_color;
+
+\n#ifdef GL_ES\n
+varying lowp vec4 v_fragmentColor;
+varying mediump vec2 v_texCoord;
+\n#else\n
+varying vec4 v_fragmentColor;
+varying vec2 v_texCoord;
+\n#endif\n
+
+void main()
+{
+    vec3 position = a_origin + a_corner.x * a_xAxis + a_corner.y * a_yAxis;
+    gl_Position = CC_PMatrix * vec4(position, 1.0);
+    v_fragmentColor = a_color;
+    v_texCoord = a_texOrigin + a_corner.x * a_texXAxis + a_corner.y * a_texYAxis;
+}
+);
@@ -729,8 +729,12 @@ y+=ytranslate;                       \
         // but it is deprecated and your code should not rely on it
         Director* director = Director::getInstance();
         CCASSERT(nullptr != director, "Director is null when seting matrix stack");
-        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-        director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+        bool useMatrixStack = isUsingMatrixStack();
+        if (useMatrixStack)
+        {
+            director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+            director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+        }
         
         int i = 0;      // used by _children
         int j = 0;      // used by _protectedChildren
@@ -800,7 +804,10 @@ y+=ytranslate;                       \
         // reset for next frame
         _orderOfArrival = 0;
         
-        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        if (useMatrixStack)
+        {
+            director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        }
         
     }
     
@@ -885,7 +892,7 @@ y+=ytranslate;                       \
         }
         if( _reorderProtectedChildDirty )
         {
-            std::sort( std::begin(_protectedChildren), std::end(_protectedChildren), nodeComparisonLess );
+            sortNodes(_protectedChildren);
             _reorderProtectedChildDirty = false;
         }
     }
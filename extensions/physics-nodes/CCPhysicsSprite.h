@@ -116,6 +116,7 @@ public:
     virtual void setRotation(float fRotation) override;
     virtual void syncPhysicsTransform() const;
     virtual const Mat4& getNodeToParentTransform() const override;
+    virtual bool isTransformSystemSupported() const override { return false; }
     
     virtual void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags) override;
 
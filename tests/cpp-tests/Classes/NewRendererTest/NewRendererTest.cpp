@@ -538,7 +538,7 @@ VBOFullTest::VBOFullTest()
     parent->setPosition(s.width/2, s.height/2);
     addChild(parent);
     
-    for (int i=0; i<Renderer::VBO_SIZE * 2; ++i)
+    for (int i=0; i<Renderer::STREAM_QUADS * 2; ++i)
     {
         Sprite* sprite = Sprite::create("Images/grossini_dance_01.png");
         sprite->setPosition(Vec2(0,0));
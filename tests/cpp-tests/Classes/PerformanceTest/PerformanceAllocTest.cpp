@@ -39,6 +39,7 @@ static std::function<PerformceAllocScene*()> createFunctions[] =
     CL(SpriteCreateEmptyTest),
     CL(SpriteCreateTest),
     CL(SpriteDeallocTest),
+    CL(SpritePoolTest),
 };
 
 #define MAX_LAYER    (sizeof(createFunctions) / sizeof(createFunctions[0]))
@@ -470,6 +471,58 @@ const char*  SpriteDeallocTest::testName()
     return "Sprite::~Sprite()";
 }
 
+////////////////////////////////////////////////////////
+//
+// SpritePoolTest
+//
+////////////////////////////////////////////////////////
+void SpritePoolTest::updateQuantityOfNodes()
+{
+    currentQuantityOfNodes = quantityOfNodes;
+
+    log("NodePool<Sprite>: %d sprites created, at most %d used at once\n", (int)_pool.getCreatedCount(), (int)_pool.getHighWaterMark());
+}
+
+void SpritePoolTest::initWithQuantityOfNodes(unsigned int nNodes)
+{
+    PerformceAllocScene::initWithQuantityOfNodes(nNodes);
+
+    log("Size of Sprite: %lu\n", sizeof(Sprite));
+
+    scheduleUpdate();
+}
+
+void SpritePoolTest::update(float dt)
+{
+    // same work as SpriteCreateEmptyTest plus the destruction, without the allocations once the pool is warm
+
+    Sprite **sprites = new Sprite*[quantityOfNodes];
+
+    CC_PROFILER_START(this->profilerName());
+    for( int i=0; i<quantityOfNodes; ++i)
+        sprites[i] = _pool.acquire();
+    for( int i=0; i<quantityOfNodes; ++i)
+        _pool.release(sprites[i]);
+    CC_PROFILER_STOP(this->profilerName());
+
+    delete [] sprites;
+}
+
+std::string SpritePoolTest::title() const
+{
+    return "Sprite from NodePool";
+}
+
+std::string SpritePoolTest::subtitle() const
+{
+    return "Acquire and release pooled Sprites. See console";
+}
+
+const char*  SpritePoolTest::testName()
+{
+    return "NodePool<Sprite>::acquire/release";
+}
+
 ///----------------------------------------
 void runAllocPerformanceTest()
 {
@@ -115,6 +115,23 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class SpritePoolTest : public PerformceAllocScene
+{
+public:
+    CREATE_FUNC(SpritePoolTest);
+
+    virtual void updateQuantityOfNodes();
+    virtual void initWithQuantityOfNodes(unsigned int nNodes);
+    virtual void update(float dt);
+    virtual const char* testName();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    NodePool<Sprite> _pool;
+};
+
 
 void runAllocPerformanceTest();
 
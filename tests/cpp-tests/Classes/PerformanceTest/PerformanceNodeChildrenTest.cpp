@@ -44,6 +44,7 @@ static std::function<NodeChildrenMainScene*()> createFunctions[] =
     CL(RemoveSpriteSheet),
     CL(ReorderSpriteSheet),
     CL(SortAllChildrenSpriteSheet),
+    CL(YSortChildren),
 
     CL(VisitSceneGraph),
 };
@@ -903,6 +904,79 @@ const char*  SortAllChildrenSpriteSheet::testName()
 }
 
 
+////////////////////////////////////////////////////////
+//
+// YSortChildren
+//
+////////////////////////////////////////////////////////
+void YSortChildren::initWithQuantityOfNodes(unsigned int nodes)
+{
+    _container = Node::create();
+    addChild(_container);
+
+    // y-sorting is only a problem with a lot of children
+    NodeChildrenMainScene::initWithQuantityOfNodes(std::max(nodes, 5000u));
+    scheduleUpdate();
+}
+
+void YSortChildren::updateQuantityOfNodes()
+{
+    auto s = Director::getInstance()->getWinSize();
+
+    // increase nodes
+    if( currentQuantityOfNodes < quantityOfNodes )
+    {
+        for(int i = 0; i < (quantityOfNodes-currentQuantityOfNodes); i++)
+        {
+            auto node = Node::create();
+            float y = CCRANDOM_0_1() * s.height;
+            node->setPosition(Vec2(CCRANDOM_0_1() * s.width, y));
+            _container->addChild(node, -(int)y);
+        }
+    }
+
+    // decrease nodes
+    else if ( currentQuantityOfNodes > quantityOfNodes )
+    {
+        for(int i = 0; i < (currentQuantityOfNodes-quantityOfNodes); i++)
+        {
+            _container->removeChild(_container->getChildren().back(), true);
+        }
+    }
+
+    currentQuantityOfNodes = quantityOfNodes;
+}
+
+void YSortChildren::update(float dt)
+{
+    // every node walks a little, like the characters of a map sorted by y
+    for (const auto& child : _container->getChildren())
+    {
+        float y = child->getPositionY() + CCRANDOM_MINUS1_1() * 2;
+        child->setPositionY(y);
+        child->setLocalZOrder(-(int)y);
+    }
+
+    CC_PROFILER_START( this->profilerName() );
+    _container->sortAllChildren();
+    CC_PROFILER_STOP( this->profilerName() );
+}
+
+std::string YSortChildren::title() const
+{
+    return "Node::sortAllChildren() with y-sorting";
+}
+
+std::string YSortChildren::subtitle() const
+{
+    return "Children move and change their Z every frame. See console";
+}
+
+const char*  YSortChildren::testName()
+{
+    return "Node::sortAllChildren() y-sort";
+}
+
 ////////////////////////////////////////////////////////
 //
 // VisitSceneGraph
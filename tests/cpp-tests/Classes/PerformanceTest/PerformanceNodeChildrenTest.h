@@ -212,6 +212,23 @@ public:
     virtual const char* testName();
 };
 
+class YSortChildren : public NodeChildrenMainScene
+{
+public:
+    CREATE_FUNC(YSortChildren);
+
+    void initWithQuantityOfNodes(unsigned int nodes) override;
+
+    virtual void update(float dt) override;
+    void updateQuantityOfNodes() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual const char* testName() override;
+
+protected:
+    Node* _container;
+};
+
 class VisitSceneGraph : public NodeChildrenMainScene
 {
 public:
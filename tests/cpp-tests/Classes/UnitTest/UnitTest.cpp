@@ -8,7 +8,8 @@ static std::function<Layer*()> createFunctions[] = {
     CL(TemplateMapTest),
     CL(ValueTest),
     CL(RefPtrTest),
-    CL(UTFConversionTest)
+    CL(UTFConversionTest),
+    CL(TransformSystemTest)
 };
 
 static int sceneIdx = -1;
@@ -816,3 +817,88 @@ std::string UTFConversionTest::subtitle() const
 {
     return "UTF8 <-> UTF16 Conversion Test, no crash";
 }
+
+// TransformSystemTest
+
+static bool matricesEqual(const Mat4& a, const Mat4& b)
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        if (fabsf(a.m[i] - b.m[i]) > 0.001f)
+            return false;
+    }
+    return true;
+}
+
+static void setupTransformTestNode(Node* node, int variant)
+{
+    node->setContentSize(Size(40, 20));
+    node->setPosition(Vec2(3 + variant, -5 + variant * 2));
+    switch (variant % 6)
+    {
+        case 0: node->setSkewX(30); break;
+        case 1: node->setSkewY(-20); node->setAnchorPoint(Vec2(0.5f, 0.5f)); break;
+        case 2: node->setSkewX(15); node->setSkewY(40); node->setScale(2, 0.5f); node->setAnchorPoint(Vec2(1, 0)); break;
+        case 3: node->setRotation(33); node->setScale(1.5f, 3); node->setAnchorPoint(Vec2(0.25f, 0.75f)); break;
+        case 4: node->setRotationSkewX(10); node->setRotationSkewY(70); node->setSkewX(-25); node->setAnchorPoint(Vec2(0.5f, 0.5f)); break;
+        case 5: node->setScale(-1, 2); node->ignoreAnchorPointForPosition(true); node->setAnchorPoint(Vec2(0.5f, 0.5f)); break;
+    }
+}
+
+void TransformSystemTest::onEnter()
+{
+    UnitTestDemo::onEnter();
+
+    // the same hierarchy twice: the first one is computed by a TransformSystem, the second one by Node
+    auto root = Node::create();
+    auto reference = Node::create();
+    Node* parent = root;
+    Node* referenceParent = reference;
+    std::vector<std::pair<Node*, Node*>> pairs;
+
+    for (int i = 0; i < 12; ++i)
+    {
+        auto node = Node::create();
+        auto referenceNode = Node::create();
+        setupTransformTestNode(node, i);
+        setupTransformTestNode(referenceNode, i);
+
+        // every other node is nested, the others are siblings
+        parent->addChild(node);
+        referenceParent->addChild(referenceNode);
+        if (i % 2 == 0)
+        {
+            parent = node;
+            referenceParent = referenceNode;
+        }
+        pairs.push_back(std::make_pair(node, referenceNode));
+    }
+
+    TransformSystem system(root);
+    system.update();
+    CCASSERT(system.getNodeCount() == 13, "");
+
+    for (auto& pair : pairs)
+    {
+        CCASSERT(matricesEqual(pair.first->getNodeToParentTransform(), pair.second->getNodeToParentTransform()), "local transform differs from Node");
+        CCASSERT(matricesEqual(pair.first->getNodeToWorldTransform(), pair.second->getNodeToWorldTransform()), "world transform differs from Node");
+    }
+
+    // changes are picked up by the next update
+    pairs[3].first->setSkewY(12);
+    pairs[3].second->setSkewY(12);
+    pairs[0].first->setRotation(-60);
+    pairs[0].second->setRotation(-60);
+    system.update();
+
+    for (auto& pair : pairs)
+    {
+        CCASSERT(matricesEqual(pair.first->getNodeToParentTransform(), pair.second->getNodeToParentTransform()), "local transform differs from Node");
+        CCASSERT(matricesEqual(pair.first->getNodeToWorldTransform(), pair.second->getNodeToWorldTransform()), "world transform differs from Node");
+    }
+}
+
+std::string TransformSystemTest::subtitle() const
+{
+    return "TransformSystem matches Node transforms, should not assert";
+}
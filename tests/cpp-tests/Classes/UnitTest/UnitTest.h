@@ -61,4 +61,12 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class TransformSystemTest : public UnitTestDemo
+{
+public:
+    CREATE_FUNC(TransformSystemTest);
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+};
+
 #endif /* __UNIT_TEST__ */